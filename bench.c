@@ -0,0 +1,467 @@
+/** @file bench.c
+ *
+ * @brief Host-native benchmark for jsmn.c and the JSON processing core.
+ *
+ * Built with the host compiler (make bench) against host_port.c instead
+ * of the register-level UART and delay drivers, so it runs without a
+ * board. Two benchmarks are run over a corpus of payloads:
+ *
+ *   jsmn_parse  - raw tokenizer throughput (jsmn_init + jsmn_parse)
+ *   pipeline    - received bytes -> json_stream -> json_process ->
+ *                 emitted lines, i.e. the firmware's UART bridge path
+ *   pipeline_cbor - the same path with JSON_OUTPUT_CBOR (answer size
+ *                 in tx_bytes_per_iter, against the text lines)
+ *   json_find   - lazy lookup of one value per payload (jsonpath.c),
+ *                 to compare against tokenizing the whole document
+ *   schema_parse - generated parser (jsonschema.def), for payloads that
+ *                 match one of the schema message types
+ *
+ * Every result is printed as one JSON object per line so runs can be
+ * diffed or plotted across commits (see PERFORMANCE.md).
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "jsmn.h"
+#include "jsonstream.h"
+#include "jsonprocess.h"
+#include "jsonpath.h"
+#include "jsonschema_gen.h"
+#include "host_port.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Revision tag written into every result (set by the Makefile) */
+#ifndef BENCH_REV
+#define BENCH_REV               "unknown"
+#endif
+
+/* Build options under test (set by the Makefile from HOST_DEFS) */
+#ifndef BENCH_CONFIG
+#define BENCH_CONFIG            ""
+#endif
+
+/* Wall time each measurement is calibrated to run for */
+#ifndef BENCH_TARGET_NS
+#define BENCH_TARGET_NS         50000000u
+#endif
+
+/* Timed runs per measurement; the fastest is reported (filters noise) */
+#ifndef BENCH_REPEATS
+#define BENCH_REPEATS           5u
+#endif
+
+/* Token budget for the raw parser benchmark */
+#define BENCH_MAX_TOKENS        1024u
+
+/* Generated payloads */
+#define BENCH_GEN_BUFFER_SIZE   8192u
+
+/* json_process() calls after the input is drained, to finish the answer */
+#define BENCH_DRAIN_CALLS       (4u * JSON_STREAM_MAX_TOKENS)
+
+/* One corpus entry */
+typedef struct
+{
+    char const * p_name;
+    char const * p_json;
+    uint32_t len;
+    bool_t b_pipeline;   /* Fits the firmware buffers (256 B, 32 tokens) */
+    char const * p_find; /* Path looked up by the json_find benchmark */
+} bench_payload_t;
+
+/* Hand-written payloads */
+static char const g_flat_small[] =
+    "{\"user\": \"johndoe\", \"admin\": false, \"uid\": 1000,\n  "
+    "\"groups\": [\"users\", \"wheel\", \"audio\", \"video\"]}";
+
+static char const g_flat_sensor[] =
+    "{\"id\": 17, \"temp\": 23.5, \"rh\": 41, \"ok\": true, "
+    "\"vbat\": 3.31, \"rssi\": -67, \"seq\": 90210, \"err\": null}";
+
+static char const g_deep_objects[] =
+    "{\"a\": {\"b\": {\"c\": {\"d\": {\"e\": {\"f\": {\"g\": 1}}}}}}}";
+
+static char const g_deep_mixed[] =
+    "{\"cfg\": {\"uart\": {\"baud\": 9600, \"pins\": [2, 3]}, "
+    "\"dma\": {\"ch\": [1, 2]}, \"led\": {\"on\": true}}, "
+    "\"tags\": [[1, 2], [3, [4, 5]]]}";
+
+static char const g_escaped_strings[] =
+    "{\"path\": \"C:\\\\logs\\\\bridge\\\\run.txt\", "
+    "\"msg\": \"line one\\nline two\\t\\\"quoted\\\"\", "
+    "\"uni\": \"\\u00b0C \\u2713\", \"url\": \"http:\\/\\/host\\/x\"}";
+
+/* Generated payloads (filled in by bench_build_corpus()) */
+static char g_long_strings[BENCH_GEN_BUFFER_SIZE];
+static char g_number_array[BENCH_GEN_BUFFER_SIZE];
+static char g_string_array[BENCH_GEN_BUFFER_SIZE];
+
+static bench_payload_t g_corpus[] =
+{
+    { "flat_small",      g_flat_small,      0u, TRUE,  "groups[2]"     },
+    { "flat_sensor",     g_flat_sensor,     0u, TRUE,  "seq"           },
+    { "deep_objects",    g_deep_objects,    0u, TRUE,  "a.b.c.d.e.f.g" },
+    { "deep_mixed",      g_deep_mixed,      0u, TRUE,  "tags[1][1][0]" },
+    { "escaped_strings", g_escaped_strings, 0u, TRUE,  "url"           },
+    { "long_strings",    g_long_strings,    0u, FALSE, "text7"         },
+    { "number_array",    g_number_array,    0u, FALSE, "samples[400]"  },
+    { "string_array",    g_string_array,    0u, FALSE, "names[250]"    },
+};
+
+#define BENCH_CORPUS_COUNT  (sizeof(g_corpus) / sizeof(g_corpus[0]))
+
+static jsmntok_t g_tokens[BENCH_MAX_TOKENS];
+static json_msg_t g_msg;
+static volatile int32_t g_sink;
+static json_output_t g_bench_output = JSON_OUTPUT_TEXT;
+
+
+/*!
+ * @brief Append text to a generated payload, bounded by its buffer.
+ */
+static uint32_t
+bench_append (char * const p_buf, uint32_t pos, char const * const p_text)
+{
+    uint32_t const len = (uint32_t)strlen(p_text);
+
+    if ((pos + len) < BENCH_GEN_BUFFER_SIZE)
+    {
+        memcpy(&p_buf[pos], p_text, len);
+        pos += len;
+        p_buf[pos] = '\0';
+    }
+
+    return pos;
+}
+
+
+/*!
+ * @brief Fill the generated payloads.
+ */
+static void
+bench_build_corpus (void)
+{
+    char item[64];
+    uint32_t pos;
+    uint32_t i;
+    uint32_t j;
+
+    /* A few multi-hundred-byte strings with escapes sprinkled in */
+    pos = bench_append(g_long_strings, 0u, "{");
+    for (i = 0u; i < 8u; i++)
+    {
+        (void)snprintf(item, sizeof(item), "%s\"text%u\": \"",
+                       (0u == i) ? "" : ", ", (unsigned)i);
+        pos = bench_append(g_long_strings, pos, item);
+        for (j = 0u; j < 24u; j++)
+        {
+            pos = bench_append(g_long_strings, pos,
+                               (0u == (j % 6u)) ? "esc \\\"q\\\" \\n " :
+                                                   "lorem ipsum ");
+        }
+        pos = bench_append(g_long_strings, pos, "\"");
+    }
+    (void)bench_append(g_long_strings, pos, "}");
+
+    /* One large numeric array */
+    pos = bench_append(g_number_array, 0u, "{\"samples\": [");
+    for (i = 0u; i < 500u; i++)
+    {
+        (void)snprintf(item, sizeof(item), "%s%d", (0u == i) ? "" : ",",
+                       (int)((i * 7919u) % 4096u) - 2048);
+        pos = bench_append(g_number_array, pos, item);
+    }
+    (void)bench_append(g_number_array, pos, "]}");
+
+    /* One large array of short strings */
+    pos = bench_append(g_string_array, 0u, "{\"names\": [");
+    for (i = 0u; i < 300u; i++)
+    {
+        (void)snprintf(item, sizeof(item), "%s\"node-%03u\"",
+                       (0u == i) ? "" : ", ", (unsigned)i);
+        pos = bench_append(g_string_array, pos, item);
+    }
+    (void)bench_append(g_string_array, pos, "]}");
+
+    for (i = 0u; i < BENCH_CORPUS_COUNT; i++)
+    {
+        g_corpus[i].len = (uint32_t)strlen(g_corpus[i].p_json);
+    }
+}
+
+
+/*!
+ * @brief Tokenize a payload once.
+ *
+ * @return Token count, or a negative jsmn error code.
+ */
+static int32_t
+bench_parse_once (bench_payload_t const * const p_payload)
+{
+    jsmn_parser_t parser;
+
+    jsmn_init(&parser);
+    return jsmn_parse(&parser, p_payload->p_json, p_payload->len,
+                      g_tokens, BENCH_MAX_TOKENS);
+}
+
+
+/*!
+ * @brief Time a number of parses of one payload.
+ */
+static uint64_t
+bench_time_parse (bench_payload_t const * const p_payload, uint32_t const iters)
+{
+    uint64_t const start = host_time_ns();
+    uint32_t i;
+
+    for (i = 0u; i < iters; i++)
+    {
+        g_sink = bench_parse_once(p_payload);
+    }
+
+    return host_time_ns() - start;
+}
+
+
+/*!
+ * @brief Time a number of path lookups in one payload.
+ *
+ * The path is compiled once, as a caller with a fixed schema would.
+ */
+static uint64_t
+bench_time_find (bench_payload_t const * const p_payload, uint32_t const iters)
+{
+    json_path_t path;
+    json_value_t value;
+    uint64_t start;
+    uint32_t i;
+
+    (void)json_path_compile(p_payload->p_find, &path);
+
+    start = host_time_ns();
+
+    for (i = 0u; i < iters; i++)
+    {
+        g_sink = json_path_find(p_payload->p_json, p_payload->len,
+                                &path, &value);
+    }
+
+    return host_time_ns() - start;
+}
+
+
+/*!
+ * @brief Time a number of generated-parser runs over one payload.
+ */
+static uint64_t
+bench_time_schema (bench_payload_t const * const p_payload,
+                   uint32_t const iters)
+{
+    uint64_t const start = host_time_ns();
+    uint32_t i;
+
+    for (i = 0u; i < iters; i++)
+    {
+        g_sink = (int32_t)json_msg_parse(p_payload->p_json, p_payload->len,
+                                         &g_msg);
+    }
+
+    return host_time_ns() - start;
+}
+
+
+/*!
+ * @brief Feed a payload through the UART pipeline a number of times.
+ *
+ * Every copy is received, framed by json_stream and answered by
+ * json_process() exactly as on the target; the answer bytes are counted
+ * by host_port.c instead of being sent.
+ */
+static uint64_t
+bench_time_pipeline (bench_payload_t const * const p_payload,
+                     uint32_t const iters)
+{
+    uint64_t start;
+    uint32_t i;
+
+    json_process_init();
+    json_set_output(g_bench_output);
+    host_uart_set_rx(p_payload->p_json, p_payload->len, iters);
+
+    start = host_time_ns();
+
+    while (0u != host_uart_rx_pending())
+    {
+        (void)json_process();
+    }
+
+    for (i = 0u; i < BENCH_DRAIN_CALLS; i++)
+    {
+        (void)json_process();
+    }
+
+    return host_time_ns() - start;
+}
+
+
+/*!
+ * @brief Grow the iteration count until one run lasts BENCH_TARGET_NS,
+ *        then time BENCH_REPEATS runs at that count and keep the fastest.
+ */
+static uint32_t
+bench_calibrate (uint64_t (*p_run)(bench_payload_t const *, uint32_t),
+                 bench_payload_t const * const p_payload, uint64_t * p_ns)
+{
+    uint32_t iters = 16u;
+    uint64_t ns = p_run(p_payload, iters);
+    uint32_t run;
+
+    while ((ns < (BENCH_TARGET_NS / 4u)) && (iters < (1u << 28)))
+    {
+        iters *= 4u;
+        ns = p_run(p_payload, iters);
+    }
+
+    /* Scale to the target */
+    if ((0u != ns) && (ns < BENCH_TARGET_NS))
+    {
+        uint64_t const scaled = ((uint64_t)iters * BENCH_TARGET_NS) / ns;
+
+        iters = (scaled > (1u << 28)) ? (1u << 28) : (uint32_t)scaled;
+    }
+
+    *p_ns = UINT64_MAX;
+
+    for (run = 0u; run < BENCH_REPEATS; run++)
+    {
+        ns = p_run(p_payload, iters);
+
+        if (ns < *p_ns)
+        {
+            *p_ns = ns;
+        }
+    }
+
+    return iters;
+}
+
+
+/*!
+ * @brief Print one result line.
+ */
+static void
+bench_report (char const * const p_bench,
+              bench_payload_t const * const p_payload,
+              int32_t const tokens, uint32_t const iters, uint64_t const ns,
+              uint64_t const tx_bytes)
+{
+    double const secs = (double)ns / 1e9;
+    double const total_bytes = (double)p_payload->len * (double)iters;
+    double const total_tokens = (double)tokens * (double)iters;
+
+    printf("{\"bench\": \"%s\", \"payload\": \"%s\", \"rev\": \"%s\", "
+           "\"config\": \"%s\", "
+           "\"bytes\": %u, \"tokens\": %d, \"iterations\": %u, "
+           "\"ns_per_iter\": %.1f, \"tokens_per_sec\": %.0f, "
+           "\"bytes_per_sec\": %.0f, \"tokens_per_byte\": %.4f",
+           p_bench, p_payload->p_name, BENCH_REV, BENCH_CONFIG,
+           (unsigned)p_payload->len, (int)tokens, (unsigned)iters,
+           (double)ns / (double)iters, total_tokens / secs,
+           total_bytes / secs,
+           (double)tokens / (double)p_payload->len);
+
+    if (0u != tx_bytes)
+    {
+        printf(", \"tx_bytes_per_iter\": %.1f",
+               (double)tx_bytes / (double)iters);
+    }
+
+    printf("}\n");
+}
+
+
+int
+main (void)
+{
+    uint32_t i;
+
+    bench_build_corpus();
+
+    for (i = 0u; i < BENCH_CORPUS_COUNT; i++)
+    {
+        bench_payload_t const * const p_payload = &g_corpus[i];
+        int32_t const tokens = bench_parse_once(p_payload);
+        uint64_t ns;
+        uint32_t iters;
+
+        if (tokens < 0)
+        {
+            fprintf(stderr, "bench: %s does not parse (%d)\n",
+                    p_payload->p_name, (int)tokens);
+            return 1;
+        }
+
+        iters = bench_calibrate(bench_time_parse, p_payload, &ns);
+        bench_report("jsmn_parse", p_payload, tokens, iters, ns, 0u);
+
+        {
+            json_value_t value;
+
+            if (0 != json_find(p_payload->p_json, p_payload->len,
+                               p_payload->p_find, &value))
+            {
+                fprintf(stderr, "bench: %s has no %s\n",
+                        p_payload->p_name, p_payload->p_find);
+                return 1;
+            }
+        }
+
+        /* Same token count reported, so tokens_per_sec compares directly */
+        iters = bench_calibrate(bench_time_find, p_payload, &ns);
+        bench_report("json_find", p_payload, tokens, iters, ns, 0u);
+
+        if (JSON_MSG_NONE != json_msg_parse(p_payload->p_json, p_payload->len,
+                                            &g_msg))
+        {
+            iters = bench_calibrate(bench_time_schema, p_payload, &ns);
+            bench_report("schema_parse", p_payload, tokens, iters, ns, 0u);
+        }
+
+        if ((TRUE == p_payload->b_pipeline) &&
+            (p_payload->len <= JSON_STREAM_BUFFER_SIZE) &&
+            ((uint32_t)tokens <= JSON_STREAM_MAX_TOKENS))
+        {
+            static char const * const names[] = { "pipeline", "pipeline_cbor" };
+            uint64_t tx_start;
+            uint32_t out;
+
+            for (out = 0u; out < 2u; out++)
+            {
+                g_bench_output = (0u == out) ? JSON_OUTPUT_TEXT : JSON_OUTPUT_CBOR;
+                iters = bench_calibrate(bench_time_pipeline, p_payload, &ns);
+
+                /* Answer size from one more timed run at the same count */
+                tx_start = host_uart_tx_bytes();
+                ns = bench_time_pipeline(p_payload, iters);
+                bench_report(names[out], p_payload, tokens, iters, ns,
+                             host_uart_tx_bytes() - tx_start);
+            }
+        }
+    }
+
+    return 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/*** end of file ***/
@@ -0,0 +1,324 @@
+/** @file cbor.c
+ *
+ * @brief Zero-copy CBOR encoding implementation.
+ *
+ * Every head byte is a one-byte slice of g_cbor_bytes, so an item costs
+ * slice descriptors rather than buffer space and stays valid for as long
+ * as the transmission needs it.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "types.h"
+#include "emit.h"
+#include "cbor.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Additional-information values announcing a 1/2/4-byte argument */
+#define CBOR_ARG_1BYTE           24u
+#define CBOR_ARG_2BYTE           25u
+#define CBOR_ARG_4BYTE           26u
+
+/* Every byte value, in order: head bytes are slices of this table */
+#define CBOR_BYTES_4(n)   (uint8_t)(n), (uint8_t)((n) + 1), \
+                          (uint8_t)((n) + 2), (uint8_t)((n) + 3)
+#define CBOR_BYTES_16(n)  CBOR_BYTES_4(n), CBOR_BYTES_4((n) + 4), \
+                          CBOR_BYTES_4((n) + 8), CBOR_BYTES_4((n) + 12)
+#define CBOR_BYTES_64(n)  CBOR_BYTES_16(n), CBOR_BYTES_16((n) + 16), \
+                          CBOR_BYTES_16((n) + 32), CBOR_BYTES_16((n) + 48)
+
+static uint8_t const g_cbor_bytes[256] =
+{
+    CBOR_BYTES_64(0), CBOR_BYTES_64(64), CBOR_BYTES_64(128), CBOR_BYTES_64(192)
+};
+
+/* Tag 4 (decimal fraction) and the head of its [exponent, mantissa] */
+static uint8_t const g_cbor_decimal[2] = { 0xC4u, 0x82u };
+
+/* Largest exponent magnitude sent as a decimal fraction */
+#define CBOR_MAX_EXPONENT        0xFFFFu
+
+/* A JSON number as mantissa * 10^exponent */
+typedef struct
+{
+    uint32_t mantissa;
+    bool_t b_negative;
+    int32_t exponent;
+} cbor_number_t;
+
+
+/*!
+ * @brief Append one byte (a slice of g_cbor_bytes).
+ */
+static void
+cbor_byte (emit_t * const p_emit, uint32_t const value)
+{
+    emit_slice(p_emit, (char const *)&g_cbor_bytes[value & 0xFFu], 1u);
+}
+
+
+/*!
+ * @brief Append an item head: major type plus its argument.
+ *
+ * Uses the shortest form (RFC 8949 preferred serialization): the
+ * argument is folded into the initial byte below 24, otherwise it
+ * follows in 1, 2 or 4 big-endian bytes.
+ *
+ * @param[in,out] p_emit Emitter the head is appended to.
+ * @param[in] major CBOR_MAJOR_* type.
+ * @param[in] arg Value, length or element count.
+ */
+void
+cbor_head (emit_t * const p_emit, uint32_t const major, uint32_t const arg)
+{
+    uint32_t const initial = major << 5;
+
+    if (arg < CBOR_ARG_1BYTE)
+    {
+        cbor_byte(p_emit, initial | arg);
+    }
+    else if (arg <= 0xFFu)
+    {
+        cbor_byte(p_emit, initial | CBOR_ARG_1BYTE);
+        cbor_byte(p_emit, arg);
+    }
+    else if (arg <= 0xFFFFu)
+    {
+        cbor_byte(p_emit, initial | CBOR_ARG_2BYTE);
+        cbor_byte(p_emit, arg >> 8);
+        cbor_byte(p_emit, arg);
+    }
+    else
+    {
+        cbor_byte(p_emit, initial | CBOR_ARG_4BYTE);
+        cbor_byte(p_emit, arg >> 24);
+        cbor_byte(p_emit, arg >> 16);
+        cbor_byte(p_emit, arg >> 8);
+        cbor_byte(p_emit, arg);
+    }
+}
+
+
+/*!
+ * @brief Append a simple value (CBOR_FALSE, CBOR_TRUE, CBOR_NULL).
+ */
+void
+cbor_simple (emit_t * const p_emit, uint32_t const value)
+{
+    cbor_byte(p_emit, (CBOR_MAJOR_SIMPLE << 5) | value);
+}
+
+
+/*!
+ * @brief Append a text string: length head, then the bytes as a slice.
+ *
+ * @param[in,out] p_emit Emitter the string is appended to.
+ * @param[in] p_data String bytes (must outlive the transmission).
+ * @param[in] len Length in bytes.
+ */
+void
+cbor_text (emit_t * const p_emit, char const * const p_data,
+           uint32_t const len)
+{
+    cbor_head(p_emit, CBOR_MAJOR_TEXT, len);
+    emit_slice(p_emit, p_data, len);
+}
+
+
+/*!
+ * @brief Append a signed integer given as sign and magnitude.
+ */
+static void
+cbor_int (emit_t * const p_emit, bool_t const b_negative,
+          uint32_t const magnitude)
+{
+    /* -0 is plain 0; -n is stored as n - 1 */
+    if (b_negative && (0u != magnitude))
+    {
+        cbor_head(p_emit, CBOR_MAJOR_NINT, magnitude - 1u);
+    }
+    else
+    {
+        cbor_head(p_emit, CBOR_MAJOR_UINT, magnitude);
+    }
+}
+
+
+/*!
+ * @brief Accumulate decimal digits, stopping at the first non-digit.
+ *
+ * @return Position after the digits, or len + 1 if the value would
+ *         exceed limit.
+ */
+static uint32_t
+cbor_digits (char const * const p_text, uint32_t pos, uint32_t const len,
+             uint32_t const limit, uint32_t * const p_value)
+{
+    /* One division per call, none per digit (Cortex-M0+ has no divider) */
+    uint32_t const tens = limit / 10u;
+    uint32_t const units = limit - (tens * 10u);
+    uint32_t value = *p_value;
+
+    for (; pos < len; pos++)
+    {
+        uint32_t const digit = (uint32_t)(uint8_t)p_text[pos] - (uint32_t)'0';
+
+        if (digit > 9u)
+        {
+            break;
+        }
+
+        if ((value > tens) || ((value == tens) && (digit > units)))
+        {
+            return len + 1u;
+        }
+
+        value = (value * 10u) + digit;
+    }
+
+    *p_value = value;
+
+    return pos;
+}
+
+
+/*!
+ * @brief Read a JSON number as a 32-bit mantissa and decimal exponent.
+ *
+ * Only the syntax is checked (sign, digits, optional fraction and
+ * exponent); the value is never converted to binary floating point.
+ *
+ * @return TRUE if the text is a number that fits.
+ */
+static bool_t
+cbor_parse_number (char const * const p_text, uint32_t const len,
+                   cbor_number_t * const p_num)
+{
+    uint32_t pos = ((len > 0u) && ('-' == p_text[0])) ? 1u : 0u;
+    uint32_t const int_start = pos;
+    uint32_t exp_value = 0u;
+    int32_t frac_digits = 0;
+
+    p_num->mantissa = 0u;
+    p_num->b_negative = (0u != pos) ? TRUE : FALSE;
+    p_num->exponent = 0;
+
+    pos = cbor_digits(p_text, pos, len, 0xFFFFFFFFu, &p_num->mantissa);
+
+    if ((pos > len) || (pos == int_start))
+    {
+        return FALSE;
+    }
+
+    if ((pos < len) && ('.' == p_text[pos]))
+    {
+        uint32_t const frac_start = pos + 1u;
+
+        pos = cbor_digits(p_text, frac_start, len, 0xFFFFFFFFu,
+                          &p_num->mantissa);
+
+        if ((pos > len) || (pos == frac_start))
+        {
+            return FALSE;
+        }
+
+        frac_digits = (int32_t)(pos - frac_start);
+    }
+
+    if ((pos < len) && (('e' == p_text[pos]) || ('E' == p_text[pos])))
+    {
+        bool_t b_exp_negative = FALSE;
+        uint32_t exp_start;
+
+        pos++;
+
+        if ((pos < len) && (('+' == p_text[pos]) || ('-' == p_text[pos])))
+        {
+            b_exp_negative = ('-' == p_text[pos]) ? TRUE : FALSE;
+            pos++;
+        }
+
+        exp_start = pos;
+        pos = cbor_digits(p_text, exp_start, len, CBOR_MAX_EXPONENT,
+                          &exp_value);
+
+        if ((pos > len) || (pos == exp_start))
+        {
+            return FALSE;
+        }
+
+        p_num->exponent = b_exp_negative ? -(int32_t)exp_value :
+                                           (int32_t)exp_value;
+    }
+
+    p_num->exponent -= frac_digits;
+
+    return (pos == len) &&
+           (p_num->exponent >= -(int32_t)CBOR_MAX_EXPONENT) &&
+           (p_num->exponent <= (int32_t)CBOR_MAX_EXPONENT);
+}
+
+
+/*!
+ * @brief Append a JSON primitive (literal or number) given as its text.
+ *
+ * true, false and null become simple values, integers become CBOR
+ * integers and numbers with a fraction or exponent become decimal
+ * fractions (tag 4, [exponent, mantissa]) - exact, with no floating
+ * point on either side. Anything else (more than 32 bits of mantissa,
+ * non-strict bare words) goes out as a text string of the original
+ * text.
+ *
+ * @param[in,out] p_emit Emitter the item is appended to.
+ * @param[in] p_text Primitive text (must outlive the transmission).
+ * @param[in] len Length in bytes.
+ */
+void
+cbor_primitive (emit_t * const p_emit, char const * const p_text,
+                uint32_t const len)
+{
+    cbor_number_t num;
+
+    if ((4u == len) && (0 == memcmp(p_text, "true", 4u)))
+    {
+        cbor_simple(p_emit, CBOR_TRUE);
+    }
+    else if ((5u == len) && (0 == memcmp(p_text, "false", 5u)))
+    {
+        cbor_simple(p_emit, CBOR_FALSE);
+    }
+    else if ((4u == len) && (0 == memcmp(p_text, "null", 4u)))
+    {
+        cbor_simple(p_emit, CBOR_NULL);
+    }
+    else if (FALSE == cbor_parse_number(p_text, len, &num))
+    {
+        cbor_text(p_emit, p_text, len);
+    }
+    else if (0 == num.exponent)
+    {
+        cbor_int(p_emit, num.b_negative, num.mantissa);
+    }
+    else
+    {
+        emit_slice(p_emit, (char const *)g_cbor_decimal,
+                   (uint32_t)sizeof(g_cbor_decimal));
+        cbor_int(p_emit, (num.exponent < 0) ? TRUE : FALSE,
+                 (num.exponent < 0) ? (uint32_t)(-num.exponent) :
+                                      (uint32_t)num.exponent);
+        cbor_int(p_emit, num.b_negative, num.mantissa);
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/*** end of file ***/
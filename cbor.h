@@ -0,0 +1,62 @@
+/** @file cbor.h
+ *
+ * @brief Zero-copy CBOR (RFC 8949) encoding on top of the slice emitter.
+ *
+ * Items are appended to an emit_t like any other output: head bytes are
+ * slices of one constant table holding every byte value, string bodies
+ * are slices of the JSON source. Nothing is formatted or copied, so the
+ * binary output keeps the lifetime rules of emit.h.
+ *
+ * JSON text maps onto CBOR as follows:
+ *   string          text string, bytes as between the quotes (escapes
+ *                   are left for the decoder, see cbor_decode.py)
+ *   true/false/null simple values 21/20/22
+ *   integer         unsigned/negative integer (magnitude below 2^32)
+ *   other number    decimal fraction, tag 4 [exponent, mantissa], exact
+ *                   and without floating point; a numeral too long for a
+ *                   32-bit mantissa goes out as a text string instead
+ *   object / array  definite-length map / array
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#ifndef CBOR_H
+#define CBOR_H
+
+#include <stdint.h>
+#include "emit.h"
+
+/* Major types (high three bits of the initial byte) */
+#define CBOR_MAJOR_UINT          0u
+#define CBOR_MAJOR_NINT          1u
+#define CBOR_MAJOR_TEXT          3u
+#define CBOR_MAJOR_ARRAY         4u
+#define CBOR_MAJOR_MAP           5u
+#define CBOR_MAJOR_SIMPLE        7u
+
+/* Simple values */
+#define CBOR_FALSE               20u
+#define CBOR_TRUE                21u
+#define CBOR_NULL                22u
+
+/* Most slices one map member can take: root map head (3), key head (3)
+ * and key (1), then a decimal fraction (1 + 3 + 5) */
+#define CBOR_MAX_MEMBER_SLICES   16u
+
+#if (CBOR_MAX_MEMBER_SLICES > EMIT_MAX_SLICES)
+#error "EMIT_MAX_SLICES is too small for CBOR output"
+#endif
+
+/* Public API functions */
+void cbor_head(emit_t * const p_emit, uint32_t const major,
+               uint32_t const arg);
+void cbor_simple(emit_t * const p_emit, uint32_t const value);
+void cbor_text(emit_t * const p_emit, char const * const p_data,
+               uint32_t const len);
+void cbor_primitive(emit_t * const p_emit, char const * const p_text,
+                    uint32_t const len);
+
+#endif /* CBOR_H */
+
+/*** end of file ***/
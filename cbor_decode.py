@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+"""Decode the bridge's CBOR output (JSON_OUTPUT_CBOR) back into JSON.
+
+Reads the byte stream sent by the firmware and prints one JSON line per
+message. Each message is one CBOR map (RFC 8949, definite lengths only),
+as built by jsonprocess.c with cbor.h:
+
+    JSON string     text string holding the bytes between the quotes,
+                    escapes included - unescaped here
+    true/false/null simple values 21/20/22
+    integer         CBOR integer
+    other number    decimal fraction (tag 4, [exponent, mantissa]),
+                    printed back exactly, e.g. 1.5 or 2.5E+7
+
+The profile, trace and stats dumps ({"cmd": "profile"}, {"cmd": "trace"},
+{"cmd": "stats"}) stay JSON text even in CBOR mode. Their lines start with '{' (0x7b), an initial
+byte the firmware never sends, so they are recognised and passed through
+unchanged.
+
+Usage: cbor_decode.py [capture file or serial device]   (default: stdin)
+
+For a live board, configure the port first, e.g.
+    stty -F /dev/ttyACM0 9600 raw && cbor_decode.py /dev/ttyACM0
+Use --bytes to append the encoded size of every message.
+"""
+
+import decimal
+import json
+import sys
+
+TEXT_LINE = 0x7b
+TAG_DECIMAL = 4
+
+
+class Reader:
+    def __init__(self, stream):
+        self.stream = stream
+        self.count = 0
+
+    def take(self, n):
+        data = self.stream.read(n)
+        if len(data) != n:
+            raise EOFError
+        self.count += n
+        return data
+
+    def byte(self):
+        return self.take(1)[0]
+
+
+def unescape(raw):
+    try:
+        return json.loads('"' + raw + '"')
+    except ValueError:
+        return raw
+
+
+def argument(reader, info):
+    if info < 24:
+        return info
+    if info > 27:
+        raise ValueError("unsupported additional information %d" % info)
+    return int.from_bytes(reader.take(1 << (info - 24)), "big")
+
+
+def item(reader, initial=None):
+    if initial is None:
+        initial = reader.byte()
+    major, info = initial >> 5, initial & 0x1f
+
+    if major == 7:
+        simple = {20: False, 21: True, 22: None}
+        if info in simple:
+            return simple[info]
+        raise ValueError("unsupported simple value 0x%02x" % initial)
+
+    arg = argument(reader, info)
+    if major == 0:
+        return arg
+    if major == 1:
+        return -1 - arg
+    if major == 2:
+        return reader.take(arg).hex()
+    if major == 3:
+        return unescape(reader.take(arg).decode("utf-8", "replace"))
+    if major == 4:
+        return [item(reader) for _ in range(arg)]
+    if major == 5:
+        members = {}
+        for _ in range(arg):
+            key = item(reader)
+            members[str(key)] = item(reader)
+        return members
+    if major == 6 and arg == TAG_DECIMAL:
+        exponent, mantissa = item(reader)
+        return decimal.Decimal(mantissa).scaleb(exponent)
+    raise ValueError("unsupported major type %d" % major)
+
+
+def to_json(value):
+    if isinstance(value, decimal.Decimal):
+        return str(value)
+    if isinstance(value, list):
+        return "[" + ", ".join(to_json(v) for v in value) + "]"
+    if isinstance(value, dict):
+        return "{" + ", ".join(json.dumps(k) + ": " + to_json(v)
+                               for k, v in value.items()) + "}"
+    return json.dumps(value)
+
+
+def text_line(reader, first):
+    line = bytearray([first])
+    while not line.endswith(b"\n"):
+        line += reader.take(1)
+    return line.decode("utf-8", "replace").rstrip("\r\n")
+
+
+def main():
+    args = [a for a in sys.argv[1:] if a != "--bytes"]
+    show_bytes = len(args) != len(sys.argv) - 1
+    if len(args) > 1:
+        sys.exit(__doc__)
+    stream = open(args[0], "rb", buffering=0) if args else sys.stdin.buffer
+    reader = Reader(stream)
+
+    try:
+        while True:
+            start = reader.count
+            first = reader.byte()
+            if first == TEXT_LINE:
+                print(text_line(reader, first))
+                continue
+            message = to_json(item(reader, first))
+            if show_bytes:
+                message += "  # %d bytes" % (reader.count - start)
+            print(message, flush=True)
+    except EOFError:
+        pass
+    except ValueError as err:
+        sys.exit("cbor_decode: %s at byte %d" % (err, reader.count))
+
+
+if __name__ == "__main__":
+    main()
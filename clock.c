@@ -0,0 +1,228 @@
+/** @file clock.c
+ *
+ * @brief System clock setup implementation (RM0444 RCC / FLASH).
+ *
+ * PLL: HSI16 / M (= 1) * N / R, with N in 8..86, R in 2..8 and the VCO
+ * (16 MHz * N) at most 344 MHz. 64 MHz is N = 8, R = 2.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#include <stdint.h>
+#include "clock.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* RCC and FLASH register addresses */
+#define RCC_CR       ((volatile uint32_t *)0x40021000)
+#define RCC_CFGR     ((volatile uint32_t *)0x40021008)
+#define RCC_PLLCFGR  ((volatile uint32_t *)0x4002100C)
+#define FLASH_ACR    ((volatile uint32_t *)0x40022000)
+
+/* RCC_CR bits */
+#define RCC_CR_HSION_BIT          8u
+#define RCC_CR_HSIRDY_BIT         10u
+#define RCC_CR_PLLON_BIT          24u
+#define RCC_CR_PLLRDY_BIT         25u
+
+/* RCC_CFGR fields: system clock switch and its status */
+#define RCC_CFGR_SW_MASK          0x7u
+#define RCC_CFGR_SWS_SHIFT        3u
+#define RCC_CFGR_SW_HSI           0x0u
+#define RCC_CFGR_SW_PLLR          0x2u
+
+/* RCC_PLLCFGR fields */
+#define RCC_PLLCFGR_SRC_HSI16     0x2u
+#define RCC_PLLCFGR_N_SHIFT       8u
+#define RCC_PLLCFGR_REN_BIT       28u
+#define RCC_PLLCFGR_R_SHIFT       29u
+
+/* FLASH_ACR fields */
+#define FLASH_ACR_LATENCY_MASK    0x7u
+#define FLASH_ACR_PRFTEN_BIT      8u
+
+/* PLL limits (M = 1, so the PLL input is HSI16 itself) */
+#define CLOCK_PLL_N_MIN           8u
+#define CLOCK_PLL_N_MAX           86u
+#define CLOCK_PLL_R_MIN           2u
+#define CLOCK_PLL_R_MAX           8u
+#define CLOCK_VCO_MAX_HZ          344000000u
+
+/* Flash wait states needed above these core clocks (range 1) */
+#define CLOCK_FLASH_0WS_MAX_HZ    24000000u
+#define CLOCK_FLASH_1WS_MAX_HZ    48000000u
+
+/* Polls to wait for an oscillator or the clock switch */
+#define CLOCK_READY_TIMEOUT       100000u
+
+static uint32_t g_clock_hz = CLOCK_HSI_HZ;
+
+
+/*!
+ * @brief Wait until (*p_reg & mask) == value, bounded.
+ *
+ * @return 1 if reached, 0 on timeout.
+ */
+static uint32_t
+clock_wait (volatile uint32_t * const p_reg, uint32_t const mask,
+            uint32_t const value)
+{
+    uint32_t count;
+
+    for (count = 0u; count < CLOCK_READY_TIMEOUT; count++)
+    {
+        if ((*p_reg & mask) == value)
+        {
+            return 1u;
+        }
+    }
+
+    return 0u;
+}
+
+
+/*!
+ * @brief Set the flash wait states for a core clock (prefetch on).
+ */
+static void
+clock_set_latency (uint32_t const hz)
+{
+    uint32_t const latency = (hz <= CLOCK_FLASH_0WS_MAX_HZ) ? 0u :
+                             (hz <= CLOCK_FLASH_1WS_MAX_HZ) ? 1u : 2u;
+
+    *FLASH_ACR = (*FLASH_ACR & ~FLASH_ACR_LATENCY_MASK) | latency |
+                 (1u << FLASH_ACR_PRFTEN_BIT);
+    (void)clock_wait(FLASH_ACR, FLASH_ACR_LATENCY_MASK, latency);
+}
+
+
+/*!
+ * @brief Switch the system clock and wait until the switch took effect.
+ *
+ * @return 1 on success, 0 on timeout.
+ */
+static uint32_t
+clock_switch (uint32_t const sw)
+{
+    *RCC_CFGR = (*RCC_CFGR & ~RCC_CFGR_SW_MASK) | sw;
+
+    return clock_wait(RCC_CFGR, RCC_CFGR_SW_MASK << RCC_CFGR_SWS_SHIFT,
+                      sw << RCC_CFGR_SWS_SHIFT);
+}
+
+
+/*!
+ * @brief Find PLL factors for a core clock.
+ *
+ * Prefers the smallest R (the lowest VCO that works).
+ *
+ * @return 1 if hz = 16 MHz * N / R for valid N and R, 0 otherwise.
+ */
+static uint32_t
+clock_pll_factors (uint32_t const hz, uint32_t * const p_n,
+                   uint32_t * const p_r)
+{
+    uint32_t r;
+
+    for (r = CLOCK_PLL_R_MIN; r <= CLOCK_PLL_R_MAX; r++)
+    {
+        uint32_t const vco = hz * r;   /* <= 512 MHz, no overflow */
+        uint32_t const n = (uint32_t)(vco / CLOCK_HSI_HZ);
+
+        if ((0u == (vco % CLOCK_HSI_HZ)) && (n >= CLOCK_PLL_N_MIN) &&
+            (n <= CLOCK_PLL_N_MAX) && (vco <= CLOCK_VCO_MAX_HZ))
+        {
+            *p_n = n;
+            *p_r = r;
+            return 1u;
+        }
+    }
+
+    return 0u;
+}
+
+
+/*!
+ * @brief Set the core clock: HSI16 for 16 MHz, the PLL otherwise.
+ *
+ * Runs from HSI16 while the PLL is reprogrammed. Flash wait states are
+ * raised before speeding up and lowered only after slowing down.
+ *
+ * @param[in] hz Core clock in Hz, up to CLOCK_MAX_HZ.
+ *
+ * @return 0 on success, -1 if the PLL cannot make hz, -2 if the PLL did
+ *         not lock (the core stays on HSI16).
+ */
+int32_t
+clock_set_sysclk (uint32_t const hz)
+{
+    uint32_t n = 0u;
+    uint32_t r = 0u;
+
+    if ((hz > CLOCK_MAX_HZ) ||
+        ((CLOCK_HSI_HZ != hz) && (0u == clock_pll_factors(hz, &n, &r))))
+    {
+        return -1;
+    }
+
+    /* Back to HSI16 first: the PLL can only be changed while unused */
+    *RCC_CR |= (1u << RCC_CR_HSION_BIT);
+    (void)clock_wait(RCC_CR, 1u << RCC_CR_HSIRDY_BIT, 1u << RCC_CR_HSIRDY_BIT);
+    (void)clock_switch(RCC_CFGR_SW_HSI);
+    *RCC_CR &= ~(1u << RCC_CR_PLLON_BIT);
+    (void)clock_wait(RCC_CR, 1u << RCC_CR_PLLRDY_BIT, 0u);
+    clock_set_latency(CLOCK_HSI_HZ);
+    g_clock_hz = CLOCK_HSI_HZ;
+
+    if (CLOCK_HSI_HZ == hz)
+    {
+        return 0;
+    }
+
+    *RCC_PLLCFGR = RCC_PLLCFGR_SRC_HSI16 |
+                   (n << RCC_PLLCFGR_N_SHIFT) |
+                   (1u << RCC_PLLCFGR_REN_BIT) |
+                   ((r - 1u) << RCC_PLLCFGR_R_SHIFT);
+    *RCC_CR |= (1u << RCC_CR_PLLON_BIT);
+
+    if (0u == clock_wait(RCC_CR, 1u << RCC_CR_PLLRDY_BIT,
+                         1u << RCC_CR_PLLRDY_BIT))
+    {
+        *RCC_CR &= ~(1u << RCC_CR_PLLON_BIT);
+        return -2;
+    }
+
+    clock_set_latency(hz);
+
+    if (0u == clock_switch(RCC_CFGR_SW_PLLR))
+    {
+        (void)clock_switch(RCC_CFGR_SW_HSI);
+        clock_set_latency(CLOCK_HSI_HZ);
+        return -2;
+    }
+
+    g_clock_hz = hz;
+
+    return 0;
+}
+
+
+/*!
+ * @brief Current core (and PCLK) frequency.
+ *
+ * @return Frequency in Hz (CLOCK_HSI_HZ until clock_set_sysclk()).
+ */
+uint32_t
+clock_get_hz (void)
+{
+    return g_clock_hz;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/*** end of file ***/
@@ -0,0 +1,39 @@
+/** @file clock.h
+ *
+ * @brief System clock setup for STM32G0 (HSI16 or PLL up to 64 MHz).
+ *
+ * The core comes out of reset on HSI16 at 16 MHz. clock_set_sysclk()
+ * switches to the PLL (HSI16 input) for any frequency the PLL can make,
+ * sets the flash wait states to match, and records the result for
+ * clock_get_hz(). AHB and APB stay undivided, so PCLK (the USART2 kernel
+ * clock) always equals the core clock.
+ *
+ * Everything timed from the core clock has to be set up again after a
+ * change: call delay_init() and uart_set_baud() afterwards.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <stdint.h>
+
+/* Reset clock (HSI16) and the highest core clock (range 1) */
+#define CLOCK_HSI_HZ           16000000u
+#define CLOCK_MAX_HZ           64000000u
+
+/* Core clock the bridge selects at start-up (override with
+ * -DCLOCK_SYSCLK_HZ=...) */
+#ifndef CLOCK_SYSCLK_HZ
+#define CLOCK_SYSCLK_HZ        CLOCK_MAX_HZ
+#endif
+
+/* Public API functions */
+int32_t clock_set_sysclk(uint32_t const hz);
+uint32_t clock_get_hz(void);
+
+#endif /* CLOCK_H */
+
+/*** end of file ***/
@@ -11,12 +11,20 @@
 
 #include <stdint.h>
 #include "delay.h"
+#include "clock.h"
+#include "sched.h"
+#include "timer.h"
+#include "trace.h"
 
 /* SysTick register addresses */
 #define SYST_CSR  ((volatile uint32_t *)0xE000E010)
 #define SYST_RVR  ((volatile uint32_t *)0xE000E014)
 #define SYST_CVR  ((volatile uint32_t *)0xE000E018)
 
+/* Interrupt control and state register (SysTick pending flag) */
+#define SCB_ICSR  ((volatile uint32_t *)0xE000ED04)
+#define SCB_ICSR_PENDSTSET    26u
+
 /* SysTick control bits */
 #define SYST_CSR_ENABLE       0u
 #define SYST_CSR_TICKINT      1u
@@ -24,23 +32,32 @@
 #define SYST_CSR_COUNTFLAG    16u
 
 /* System configuration */
-#define SYSTEM_CORE_CLOCK     16000000UL
 #define SYSTICK_MS_DIVISOR    1000u
+#define SYSTICK_US_PER_MS     1000u
 
 /* Global tick counter (incremented every 1ms by SysTick ISR) */
 static volatile uint32_t g_systick_ms = 0;
 
+/* Core clock cycles per SysTick period and per microsecond, from
+ * clock_get_hz() */
+static uint32_t g_cycles_per_ms = CLOCK_HSI_HZ / SYSTICK_MS_DIVISOR;
+static uint32_t g_cycles_per_us = CLOCK_HSI_HZ / (SYSTICK_MS_DIVISOR *
+                                                  SYSTICK_US_PER_MS);
+
 
 /*!
  * @brief Initialize SysTick for 1ms interrupts.
  *
  * Configures SysTick to generate interrupts every 1ms, providing
- * a time base for non-blocking delays.
+ * a time base for non-blocking delays. The reload value follows
+ * clock_get_hz(), so call this again after a core clock change.
  */
 void delay_init(void)
 {
     /* Configure SysTick for 1ms tick */
-    *SYST_RVR = (SYSTEM_CORE_CLOCK / SYSTICK_MS_DIVISOR) - 1u;
+    g_cycles_per_ms = clock_get_hz() / SYSTICK_MS_DIVISOR;
+    g_cycles_per_us = g_cycles_per_ms / SYSTICK_US_PER_MS;
+    *SYST_RVR = g_cycles_per_ms - 1u;
     
     /* Clear current value */
     *SYST_CVR = 0;
@@ -63,6 +80,75 @@ uint32_t delay_get_tick(void)
 }
 
 
+/*!
+ * @brief Read the millisecond tick and the cycles elapsed within it.
+ *
+ * SysTick counts down from g_cycles_per_ms - 1, so the cycle position
+ * within the current millisecond is (g_cycles_per_ms - 1) - CVR. If the
+ * counter has wrapped but SysTick_Handler has not run yet (we are inside
+ * an equal or higher priority ISR), the pending flag is set: re-read the
+ * counter and account for the millisecond the handler has not counted.
+ */
+static void delay_snapshot(uint32_t * const p_ms, uint32_t * const p_cycles)
+{
+    uint32_t snapshot;
+    uint32_t ms;
+    uint32_t cvr;
+
+    /* Retry if SysTick_Handler ran in between (thread mode only) */
+    do {
+        snapshot = g_systick_ms;
+        ms = snapshot;
+        cvr = *SYST_CVR;
+
+        if ((*SCB_ICSR & (1u << SCB_ICSR_PENDSTSET)) != 0u)
+        {
+            cvr = *SYST_CVR;
+            ms++;
+        }
+    } while (snapshot != g_systick_ms);
+
+    *p_ms = ms;
+    *p_cycles = (g_cycles_per_ms - 1u) - cvr;
+}
+
+
+/*!
+ * @brief Get CPU cycles from the millisecond tick and SysTick counter.
+ *
+ * @return Cycle count (wraps at 2^32, ~67 s at 64 MHz).
+ */
+uint32_t delay_get_cycles(void)
+{
+    uint32_t ms;
+    uint32_t cycles;
+
+    delay_snapshot(&ms, &cycles);
+
+    return (ms * g_cycles_per_ms) + cycles;
+}
+
+
+/*!
+ * @brief Get a microsecond timestamp from the tick and SysTick counter.
+ *
+ * Same sources as delay_get_cycles(), but it wraps after ~71 minutes
+ * instead of ~67 s, so it suits latencies and intervals too long for a
+ * cycle count. Costs one software division on Cortex-M0+.
+ *
+ * @return Microseconds since delay_init() (wraps at 2^32).
+ */
+uint32_t delay_get_us(void)
+{
+    uint32_t ms;
+    uint32_t cycles;
+
+    delay_snapshot(&ms, &cycles);
+
+    return (ms * SYSTICK_US_PER_MS) + (cycles / g_cycles_per_us);
+}
+
+
 /*!
  * @brief Check if specified time has elapsed since start tick.
  *
@@ -112,7 +198,8 @@ void delay_ms(uint32_t milliseconds)
     uint32_t start = g_systick_ms;
     
     while ((g_systick_ms - start) < milliseconds) {
-        /* Busy wait - could use __WFI() here for lower power */
+        /* Sleep until the next interrupt (at the latest the next tick) */
+        __asm volatile ("wfi" : : : "memory");
     }
 }
 
@@ -120,12 +207,26 @@ void delay_ms(uint32_t milliseconds)
 /*!
  * @brief SysTick interrupt handler.
  *
- * Increments global tick counter every 1ms. Must be defined in
- * startup.c vector table as SysTick_Handler.
+ * Increments global tick counter every 1ms, advances the timer wheel
+ * and readies the housekeeping task. In a TRACE_ENABLE build a tick
+ * that starts late (another handler held it off) is traced. Must be
+ * defined in startup.c vector table as SysTick_Handler.
  */
 void SysTick_Handler(void)
 {
+#ifdef TRACE_ENABLE
+    /* Cycles since the counter reloaded: how long the tick was held off */
+    uint32_t const latency = *SYST_RVR - *SYST_CVR;
+
+    if (latency > TRACE_TICK_LATE_CYCLES)
+    {
+        TRACE(TRACE_EV_TICK_LATE, latency);
+    }
+#endif
+
     g_systick_ms++;
+    timer_tick();
+    sched_signal(SCHED_TASK_HOUSEKEEPING);
 }
 
 /*** end of file ***/
\ No newline at end of file
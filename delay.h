@@ -29,6 +29,28 @@ void delay_init(void);
  */
 uint32_t delay_get_tick(void);
 
+/*!
+ * @brief Get a free-running CPU cycle count.
+ *
+ * Cortex-M0+ has no DWT cycle counter, so this combines the millisecond
+ * tick with the SysTick current value. Safe to call from interrupts;
+ * differences between two readings are valid for up to 2^32 cycles.
+ *
+ * @return Core clock cycles since delay_init() (wraps at 2^32).
+ */
+uint32_t delay_get_cycles(void);
+
+/*!
+ * @brief Get a free-running microsecond timestamp.
+ *
+ * Built from the millisecond tick and the SysTick current value, with
+ * one-cycle granularity rounded down to whole microseconds. Safe to call
+ * from interrupts.
+ *
+ * @return Microseconds since delay_init() (wraps at 2^32, ~71 minutes).
+ */
+uint32_t delay_get_us(void);
+
 /*!
  * @brief Check if delay has elapsed (non-blocking).
  *
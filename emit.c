@@ -0,0 +1,182 @@
+/** @file emit.c
+ *
+ * @brief Zero-copy line emitter implementation.
+ *
+ * Every slice must point at memory that outlives the transmission
+ * (flash constants, the JSON source); see uart_enqueue_slices().
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "uart.h"
+#include "emit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Indents are slices of this flash constant */
+static char const g_emit_spaces[EMIT_MAX_INDENT] =
+{
+    ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ',
+    ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' '
+};
+
+#ifdef EMIT_TEST_TAP
+static emit_tap_t g_emit_tap = NULL;
+static void * g_emit_tap_ctx = NULL;
+#endif
+
+
+/*!
+ * @brief Start a new line.
+ *
+ * @param[out] p_emit Pointer to emitter state.
+ */
+void
+emit_begin (emit_t * const p_emit)
+{
+    p_emit->count = 0u;
+    p_emit->bytes = 0u;
+}
+
+
+/*!
+ * @brief Append a slice of memory to the line.
+ *
+ * Empty slices are dropped. Appending past EMIT_MAX_SLICES marks the
+ * line as overflowed and emit_commit() will refuse it.
+ *
+ * @param[in,out] p_emit Pointer to emitter state.
+ * @param[in] p_data Start of the slice (must outlive the transmission).
+ * @param[in] len Slice length in bytes.
+ */
+void
+emit_slice (emit_t * const p_emit, char const * const p_data,
+            uint32_t const len)
+{
+    if ((NULL == p_data) || (0u == len))
+    {
+        return;
+    }
+
+    if (p_emit->count >= EMIT_MAX_SLICES)
+    {
+        p_emit->count = EMIT_MAX_SLICES + 1u;
+        return;
+    }
+
+    p_emit->slices[p_emit->count].p_data = p_data;
+    p_emit->slices[p_emit->count].len = len;
+    p_emit->count++;
+    p_emit->bytes += len;
+}
+
+
+/*!
+ * @brief Append a null-terminated string to the line.
+ */
+void
+emit_str (emit_t * const p_emit, char const * const p_str)
+{
+    if (NULL != p_str)
+    {
+        emit_slice(p_emit, p_str, (uint32_t)strlen(p_str));
+    }
+}
+
+
+/*!
+ * @brief Append an indent of spaces (clamped to EMIT_MAX_INDENT).
+ */
+void
+emit_indent (emit_t * const p_emit, uint32_t const spaces)
+{
+    emit_slice(p_emit, g_emit_spaces,
+               (spaces > EMIT_MAX_INDENT) ? EMIT_MAX_INDENT : spaces);
+}
+
+
+/*!
+ * @brief Queue the line on the UART without copying it.
+ *
+ * @param[in] p_emit Pointer to emitter state.
+ *
+ * @return 0 on success, -1 if the line overflowed its slice list,
+ *         -2 if the TX queue has no room yet (retry later).
+ */
+int32_t
+emit_commit (emit_t * const p_emit)
+{
+    if (p_emit->count > EMIT_MAX_SLICES)
+    {
+        return -1;
+    }
+
+#ifdef EMIT_TEST_TAP
+    if (NULL != g_emit_tap)
+    {
+        return g_emit_tap(g_emit_tap_ctx, p_emit->slices, p_emit->count);
+    }
+#endif
+
+    return uart_enqueue_slices(p_emit->slices, p_emit->count);
+}
+
+
+/*!
+ * @brief Queue the line on the UART as a copy in the TX FIFO.
+ *
+ * Costs a copy but only one or two descriptors however many slices the
+ * line has, and the slices' memory is free again once this returns.
+ * Within a UART batch successive lines merge into one transfer.
+ *
+ * @param[in] p_emit Pointer to emitter state.
+ *
+ * @return As emit_commit().
+ */
+int32_t
+emit_commit_copy (emit_t * const p_emit)
+{
+    if (p_emit->count > EMIT_MAX_SLICES)
+    {
+        return -1;
+    }
+
+#ifdef EMIT_TEST_TAP
+    if (NULL != g_emit_tap)
+    {
+        return g_emit_tap(g_emit_tap_ctx, p_emit->slices, p_emit->count);
+    }
+#endif
+
+    return uart_enqueue_copy(p_emit->slices, p_emit->count);
+}
+
+#ifdef EMIT_TEST_TAP
+/*!
+ * @brief Hand committed lines to p_tap instead of the UART.
+ *
+ * For tests that check emitted output byte for byte. The tap's return
+ * value is returned by emit_commit() and emit_commit_copy().
+ *
+ * @param[in] p_tap Line hook (NULL: back to the UART).
+ * @param[in] p_ctx Passed to every call of p_tap.
+ */
+void
+emit_set_tap (emit_tap_t const p_tap, void * const p_ctx)
+{
+    g_emit_tap = p_tap;
+    g_emit_tap_ctx = p_ctx;
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+/*** end of file ***/
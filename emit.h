@@ -0,0 +1,58 @@
+/** @file emit.h
+ *
+ * @brief Zero-copy line emitter: builds (pointer, length) slice lists.
+ *
+ * A line is assembled from constant prefixes, slices of the JSON source
+ * and line endings, then queued in one call to uart_enqueue_slices().
+ * Nothing is formatted or copied; the UART/DMA layer sends each slice
+ * straight from where it lives. emit_commit_copy() queues a line as one
+ * copy in the TX FIFO instead, for batched output.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#ifndef EMIT_H
+#define EMIT_H
+
+#include <stdint.h>
+#include "uart.h"
+
+/* Maximum slices in one emitted line (CBOR output takes up to 16 for one
+ * map member: see CBOR_MAX_MEMBER_SLICES in cbor.h) */
+#define EMIT_MAX_SLICES          16u
+
+/* Longest indent emit_indent() can produce */
+#define EMIT_MAX_INDENT          16u
+
+/* One line under construction */
+typedef struct
+{
+    uart_slice_t slices[EMIT_MAX_SLICES];
+    uint32_t count;            /* Slices used (EMIT_MAX_SLICES + 1 = overflow) */
+    uint32_t bytes;            /* Total line length */
+} emit_t;
+
+/* Append a string literal without a strlen() at run time */
+#define EMIT_LITERAL(p_emit, lit) \
+    emit_slice((p_emit), (lit), (uint32_t)(sizeof(lit) - 1u))
+
+/* Public API functions */
+void emit_begin(emit_t * const p_emit);
+void emit_slice(emit_t * const p_emit, char const * const p_data,
+                uint32_t const len);
+void emit_str(emit_t * const p_emit, char const * const p_str);
+void emit_indent(emit_t * const p_emit, uint32_t const spaces);
+int32_t emit_commit(emit_t * const p_emit);
+int32_t emit_commit_copy(emit_t * const p_emit);
+
+#ifdef EMIT_TEST_TAP
+/* Test builds only: committed lines go to the tap instead of the UART */
+typedef int32_t (*emit_tap_t)(void * p_ctx, uart_slice_t const * p_slices,
+                              uint32_t count);
+void emit_set_tap(emit_tap_t const p_tap, void * const p_ctx);
+#endif
+
+#endif /* EMIT_H */
+
+/*** end of file ***/
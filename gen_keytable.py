@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+"""Generate the root-key dispatch table for jsonprocess.c.
+
+Reads jsonkeys.def and writes jsonkeys_table.h: a const (flash-resident)
+table indexed by a minimal perfect hash of (length, first byte, last byte).
+The hash is
+
+    slot = (len * A + first * B + last * C) & MASK
+
+with A/B/C searched here so that every key maps to a distinct slot in
+the smallest power-of-two table possible. Lookup on target is one
+multiply-add, one table read and one memcmp() to reject unknown keys.
+
+Usage: gen_keytable.py <input.def> <output.h>
+"""
+
+import sys
+
+
+def load(path):
+    keys = []
+    with open(path) as f:
+        for lineno, line in enumerate(f, 1):
+            line = line.split('#', 1)[0].strip()
+            if not line:
+                continue
+            fields = line.split()
+            if len(fields) != 3:
+                sys.exit("%s:%d: expected '<key> <label> <handler>'" % (path, lineno))
+            if any(k[0] == fields[0] for k in keys):
+                sys.exit("%s:%d: duplicate key '%s'" % (path, lineno, fields[0]))
+            keys.append(tuple(fields))
+    if not keys:
+        sys.exit("%s: no keys defined" % path)
+    return keys
+
+
+def slot(key, a, b, c, mask):
+    k = key.encode()
+    return (len(k) * a + k[0] * b + k[-1] * c) & mask
+
+
+def search(keys):
+    size = 1
+    while size < len(keys):
+        size <<= 1
+    while size <= 256:
+        mask = size - 1
+        for a in range(0, 32):
+            for b in range(1, 32):
+                for c in range(0, 32):
+                    slots = {slot(k[0], a, b, c, mask) for k in keys}
+                    if len(slots) == len(keys):
+                        return size, a, b, c
+        size <<= 1
+    sys.exit("no collision-free hash found; keys differ only in the middle?")
+
+
+def emit(keys, size, a, b, c, src, out):
+    table = [None] * size
+    for k in keys:
+        table[slot(k[0], a, b, c, size - 1)] = k
+
+    lines = [
+        "/** @file jsonkeys_table.h",
+        " *",
+        " * @brief Root-key dispatch table (GENERATED - do not edit).",
+        " *",
+        " * Generated by gen_keytable.py from %s. Included once, by" % src,
+        " * jsonprocess.c, after the key handlers are declared.",
+        " *",
+        " * @par",
+        " * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.",
+        " */",
+        "",
+        "#ifndef JSONKEYS_TABLE_H",
+        "#define JSONKEYS_TABLE_H",
+        "",
+        "/* slot = (len * A + first * B + last * C) & MASK */",
+        "#define JSON_KEY_HASH_MUL_LEN    %du" % a,
+        "#define JSON_KEY_HASH_MUL_FIRST  %du" % b,
+        "#define JSON_KEY_HASH_MUL_LAST   %du" % c,
+        "#define JSON_KEY_TABLE_SIZE      %du" % size,
+        "#define JSON_KEY_HASH_MASK       (JSON_KEY_TABLE_SIZE - 1u)",
+        "",
+        "static json_key_t const g_key_table[JSON_KEY_TABLE_SIZE] =",
+        "{",
+    ]
+    for i, k in enumerate(table):
+        sep = "," if i + 1 < size else ""
+        if k is None:
+            lines.append("    /* %2d */ { NULL, 0u, NULL, 0u, NULL }%s" % (i, sep))
+        else:
+            prefix = "- %s: " % k[1]
+            lines.append('    /* %2d */ { "%s", %du, "%s", %du, %s }%s'
+                         % (i, k[0], len(k[0].encode()), prefix,
+                            len(prefix.encode()), k[2], sep))
+    lines += [
+        "};",
+        "",
+        "#endif /* JSONKEYS_TABLE_H */",
+        "",
+        "/*** end of file ***/",
+        "",
+    ]
+    with open(out, "w") as f:
+        f.write("\n".join(lines))
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+    keys = load(sys.argv[1])
+    size, a, b, c = search(keys)
+    emit(keys, size, a, b, c, sys.argv[1], sys.argv[2])
+
+
+if __name__ == "__main__":
+    main()
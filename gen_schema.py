@@ -0,0 +1,613 @@
+#!/usr/bin/env python3
+"""Generate specialized message parsers from jsonschema.def.
+
+For every message type the generated code has:
+
+    json_<name>_t          flat struct, one member per field, plus a
+                           presence mask and the value text of each field
+    json_<name>_parse()    fills the struct straight from the text with
+                           the jsonschema.c scanner - no token array; the
+                           key is matched by a switch on its length and
+                           one memcmp()
+    json_<name>_write()    serializes the struct back to JSON
+
+and for all types together json_msg_parse() (try each type in order),
+json_msg_write() and json_msg_field() (generic field view, used by
+jsonprocess.c to answer a parsed message).
+
+Usage: gen_schema.py <input.def> <output.h> <output.c>
+"""
+
+import os
+import re
+import sys
+
+TYPES = {
+    "string": "JSON_FIELD_STRING",
+    "int32": "JSON_FIELD_INT32",
+    "bool": "JSON_FIELD_BOOL",
+}
+
+HEADER = [
+    "/** @file %s",
+    " *",
+    " * @brief %s (GENERATED - do not edit).",
+    " *",
+    " * Generated by gen_schema.py from %s.",
+    " *",
+    " * @par",
+    " * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.",
+    " */",
+    "",
+]
+
+
+def load(path):
+    messages = []
+    with open(path) as f:
+        for lineno, line in enumerate(f, 1):
+            line = line.split('#', 1)[0].strip()
+            if not line:
+                continue
+            fields = line.split()
+            where = "%s:%d" % (path, lineno)
+            if fields[0] == "message":
+                if len(fields) != 2 or not re.match(r"^[a-z][a-z0-9_]*$", fields[1]):
+                    sys.exit("%s: expected 'message <c_name>'" % where)
+                if any(m["name"] == fields[1] for m in messages):
+                    sys.exit("%s: duplicate message '%s'" % (where, fields[1]))
+                messages.append({"name": fields[1], "fields": []})
+                continue
+            if not messages:
+                sys.exit("%s: field outside a message" % where)
+            if len(fields) != 2:
+                sys.exit("%s: expected '<key> <type>'" % where)
+            key, ftype = fields
+            if not re.match(r"^[A-Za-z_][A-Za-z0-9_]*$", key):
+                sys.exit("%s: key '%s' is not a C identifier" % (where, key))
+            msg = messages[-1]
+            if any(f["key"] == key for f in msg["fields"]):
+                sys.exit("%s: duplicate key '%s'" % (where, key))
+            m = re.match(r"^string\[([1-9][0-9]*)\]$", ftype)
+            if m:
+                field = {"key": key, "type": "JSON_FIELD_STRING_ARRAY",
+                         "max": int(m.group(1))}
+            elif ftype in TYPES:
+                field = {"key": key, "type": TYPES[ftype], "max": 0}
+            else:
+                sys.exit("%s: unknown type '%s'" % (where, ftype))
+            msg["fields"].append(field)
+            if len(msg["fields"]) > 32:
+                sys.exit("%s: more than 32 fields in '%s'" % (where, msg["name"]))
+    if not messages:
+        sys.exit("%s: no messages defined" % path)
+    for msg in messages:
+        if not msg["fields"]:
+            sys.exit("%s: message '%s' has no fields" % (path, msg["name"]))
+    return messages
+
+
+def upper(msg, suffix):
+    return "JSON_%s_%s" % (msg["name"].upper(), suffix)
+
+
+def emit_header(messages, src, out):
+    name = os.path.basename(out)
+    lines = [HEADER[0] % name, HEADER[1],
+             HEADER[2] % "Schema message structs and parsers",
+             HEADER[3], HEADER[4] % src] + HEADER[5:]
+    lines += [
+        "#ifndef JSONSCHEMA_GEN_H",
+        "#define JSONSCHEMA_GEN_H",
+        "",
+        "#include <stdint.h>",
+        '#include "types.h"',
+        '#include "jsonschema.h"',
+        "",
+        "/* Message types, in the order json_msg_parse() tries them */",
+        "typedef enum",
+        "{",
+        "    JSON_MSG_NONE = 0,",
+    ]
+    for i, msg in enumerate(messages):
+        sep = "," if i + 1 < len(messages) else ""
+        lines.append("    JSON_MSG_%s%s" % (msg["name"].upper(), sep))
+    lines += ["} json_msg_id_t;", ""]
+
+    for msg in messages:
+        fields = msg["fields"]
+        lines.append("/* %s */" % msg["name"])
+        lines.append("#define %-36s %du" % (upper(msg, "FIELD_COUNT"), len(fields)))
+        for f in fields:
+            if f["max"]:
+                lines.append("#define %-36s %du"
+                             % (upper(msg, f["key"].upper() + "_MAX"), f["max"]))
+        for i, f in enumerate(fields):
+            lines.append("#define %-36s (1u << %d)"
+                         % (upper(msg, "HAS_" + f["key"].upper()), i))
+        lines += ["", "typedef struct", "{",
+                  "    uint32_t present;           /* %s bits */"
+                  % upper(msg, "HAS_*")]
+        for f in fields:
+            if f["type"] == "JSON_FIELD_STRING":
+                lines.append("    json_str_t %s;" % f["key"])
+            elif f["type"] == "JSON_FIELD_INT32":
+                lines.append("    int32_t %s;" % f["key"])
+            elif f["type"] == "JSON_FIELD_BOOL":
+                lines.append("    bool_t %s;" % f["key"])
+            else:
+                lines.append("    json_str_t %s[%s];"
+                             % (f["key"], upper(msg, f["key"].upper() + "_MAX")))
+                lines.append("    uint32_t %s_count;" % f["key"])
+        lines += [
+            "    json_str_t text[%s];  /* Value text per field */"
+            % upper(msg, "FIELD_COUNT"),
+            "    uint8_t order[%s];  /* Field of each member, document order */"
+            % upper(msg, "FIELD_COUNT"),
+            "    uint32_t count;             /* Members in the document */",
+            "} json_%s_t;" % msg["name"],
+            "",
+        ]
+
+    lines += ["/* Any message */", "typedef struct", "{",
+              "    json_msg_id_t id;", "    union", "    {"]
+    for msg in messages:
+        lines.append("        json_%s_t %s;" % (msg["name"], msg["name"]))
+    lines += ["    } u;", "} json_msg_t;", "", "/* Public API functions */"]
+
+    for msg in messages:
+        n = msg["name"]
+        pad = " " * len("int32_t json_%s_parse(" % n)
+        lines.append("int32_t json_%s_parse(char const * const p_js, uint32_t const len," % n)
+        lines.append("%sjson_%s_t * const p_out);" % (pad, n))
+        pad = " " * len("int32_t json_%s_write(" % n)
+        lines.append("int32_t json_%s_write(json_%s_t const * const p_msg," % (n, n))
+        lines.append("%schar * const p_buf, uint32_t const size);" % pad)
+    lines += [
+        "json_msg_id_t json_msg_parse(char const * const p_js, uint32_t const len,",
+        "                             json_msg_t * const p_out);",
+        "int32_t json_msg_write(json_msg_t const * const p_msg, char * const p_buf,",
+        "                       uint32_t const size);",
+        "uint32_t json_msg_field_count(json_msg_t const * const p_msg);",
+        "uint32_t json_msg_order(json_msg_t const * const p_msg,",
+        "                        uint32_t const position);",
+        "int32_t json_msg_field(json_msg_t const * const p_msg, uint32_t const index,",
+        "                       json_field_view_t * const p_view);",
+        "",
+        "#endif /* JSONSCHEMA_GEN_H */",
+        "",
+        "/*** end of file ***/",
+        "",
+    ]
+    with open(out, "w") as f:
+        f.write("\n".join(lines))
+
+
+def scan_call(msg, i, f):
+    """Statements that read field i into the struct."""
+    k = f["key"]
+    t = f["type"]
+    if t == "JSON_FIELD_STRING":
+        return ["result = json_scan_string(&scan, &p_out->%s);" % k,
+                "p_out->text[%du] = p_out->%s;" % (i, k)]
+    if t == "JSON_FIELD_INT32":
+        return ["result = json_scan_int32(&scan, &p_out->%s, &p_out->text[%du]);" % (k, i)]
+    if t == "JSON_FIELD_BOOL":
+        return ["result = json_scan_bool(&scan, &p_out->%s, &p_out->text[%du]);" % (k, i)]
+    return ["result = json_scan_string_array(&scan, p_out->%s," % k,
+            "                                %s," % upper(msg, k.upper() + "_MAX"),
+            "                                &p_out->%s_count," % k,
+            "                                &p_out->text[%du]);" % i]
+
+
+def emit_parser(msg):
+    n = msg["name"]
+    count = upper(msg, "FIELD_COUNT")
+    lines = [
+        "",
+        "/*!",
+        " * @brief Parse a %s message without tokenizing it." % n,
+        " *",
+        " * @return JSON_SCHEMA_OK, JSON_SCHEMA_NO_MATCH if the document is not a",
+        " *         %s, or JSON_SCHEMA_ERR_ARG / _ERR_MALFORMED." % n,
+        " */",
+        "int32_t",
+        "json_%s_parse (char const * const p_js, uint32_t const len," % n,
+        "%sjson_%s_t * const p_out)" % (" " * len("json_%s_parse (" % n), n),
+        "{",
+        "    json_scan_t scan;",
+        "    json_str_t key;",
+        "    int32_t result;",
+        "",
+        "    if ((NULL == p_js) || (NULL == p_out))",
+        "    {",
+        "        return JSON_SCHEMA_ERR_ARG;",
+        "    }",
+        "",
+        "    p_out->present = 0u;",
+        "    p_out->count = 0u;",
+        "    result = json_scan_object(&scan, p_js, len);",
+        "",
+        "    while (1 == result)",
+        "    {",
+        "        uint32_t field = %s;" % count,
+        "",
+        "        result = json_scan_key(&scan, &key);",
+        "",
+        "        if (JSON_SCHEMA_OK != result)",
+        "        {",
+        "            return result;",
+        "        }",
+        "",
+        "        switch (key.len)",
+        "        {",
+    ]
+    by_len = {}
+    for i, f in enumerate(msg["fields"]):
+        by_len.setdefault(len(f["key"]), []).append((i, f))
+    for klen in sorted(by_len):
+        lines += ["            case %du:" % klen, "            {"]
+        for j, (i, f) in enumerate(by_len[klen]):
+            kw = "if" if j == 0 else "else if"
+            lines += [
+                '                %s (0 == memcmp(key.p_start, "%s", %du))'
+                % (kw, f["key"], klen),
+                "                {",
+                "                    field = %du;" % i,
+            ]
+            lines += ["                    " + s for s in scan_call(msg, i, f)]
+            lines.append("                }")
+        lines += ["                break;", "            }", ""]
+    lines += [
+        "            default:",
+        "            {",
+        "                break;",
+        "            }",
+        "        }",
+        "",
+        "        if (%s == field)" % count,
+        "        {",
+        "            return JSON_SCHEMA_NO_MATCH;   /* Not a member of this message */",
+        "        }",
+        "",
+        "        if (JSON_SCHEMA_OK != result)",
+        "        {",
+        "            return result;",
+        "        }",
+        "",
+        "        if (0u != (p_out->present & (1u << field)))",
+        "        {",
+        "            return JSON_SCHEMA_NO_MATCH;   /* Duplicate key */",
+        "        }",
+        "",
+        "        p_out->present |= (1u << field);",
+        "        p_out->order[p_out->count] = (uint8_t)field;",
+        "        p_out->count++;",
+        "        result = json_scan_next(&scan);",
+        "    }",
+        "",
+        "    if (JSON_SCHEMA_OK != result)",
+        "    {",
+        "        return result;",
+        "    }",
+        "",
+        "    return json_scan_end(&scan);",
+        "}",
+        "",
+    ]
+    return lines
+
+
+def emit_writer(msg):
+    n = msg["name"]
+    lines = [
+        "",
+        "/*!",
+        " * @brief Serialize a %s message (present fields only)." % n,
+        " *",
+        " * @return Bytes written, -1 on a NULL pointer, -2 if p_buf is too small.",
+        " */",
+        "int32_t",
+        "json_%s_write (json_%s_t const * const p_msg," % (n, n),
+        "%schar * const p_buf, uint32_t const size)" % (" " * len("json_%s_write (" % n)),
+        "{",
+        "    json_out_t out;",
+        "    bool_t b_first = TRUE;",
+        "",
+        "    if ((NULL == p_msg) || (NULL == p_buf))",
+        "    {",
+        "        return JSON_SCHEMA_ERR_ARG;",
+        "    }",
+        "",
+        "    json_out_init(&out, p_buf, size);",
+        '    json_out_raw(&out, "{", 1u);',
+    ]
+    for f in msg["fields"]:
+        k = f["key"]
+        t = f["type"]
+        if t == "JSON_FIELD_STRING":
+            value = "json_out_string(&out, &p_msg->%s);" % k
+        elif t == "JSON_FIELD_INT32":
+            value = "json_out_int32(&out, p_msg->%s);" % k
+        elif t == "JSON_FIELD_BOOL":
+            value = "json_out_bool(&out, p_msg->%s);" % k
+        else:
+            value = "json_out_string_array(&out, p_msg->%s, p_msg->%s_count);" % (k, k)
+        lines += [
+            "",
+            "    if (0u != (p_msg->present & %s))" % upper(msg, "HAS_" + k.upper()),
+            "    {",
+            '        json_out_key(&out, "%s", %du, b_first);' % (k, len(k)),
+            "        " + value,
+            "        b_first = FALSE;",
+            "    }",
+        ]
+    lines += [
+        "",
+        '    json_out_raw(&out, "}", 1u);',
+        "",
+        "    return json_out_finish(&out);",
+        "}",
+        "",
+    ]
+    return lines
+
+
+def emit_source(messages, src, header, out):
+    name = os.path.basename(out)
+    lines = [HEADER[0] % name, HEADER[1],
+             HEADER[2] % "Schema message parsers and writers",
+             HEADER[3], HEADER[4] % src] + HEADER[5:]
+    lines += [
+        "#include <stdint.h>",
+        "#include <stddef.h>",
+        "#include <string.h>",
+        '#include "types.h"',
+        '#include "jsonschema.h"',
+        '#include "%s"' % os.path.basename(header),
+        "",
+        "#ifdef __cplusplus",
+        'extern "C" {',
+        "#endif",
+        "",
+    ]
+    for msg in messages:
+        n = msg["name"]
+        lines += ["/* Members of %s, in field order */" % n,
+                  "static json_field_desc_t const g_%s_fields[%s] ="
+                  % (n, upper(msg, "FIELD_COUNT")), "{"]
+        for i, f in enumerate(msg["fields"]):
+            sep = "," if i + 1 < len(msg["fields"]) else ""
+            lines.append('    { "%s", %du, %s }%s'
+                         % (f["key"], len(f["key"]), f["type"], sep))
+        lines += ["};", ""]
+
+    for msg in messages:
+        lines += emit_parser(msg)
+        lines += emit_writer(msg)
+
+    # Dispatch over all message types
+    lines += [
+        "",
+        "/*!",
+        " * @brief Parse a document as the first message type it matches.",
+        " *",
+        " * @return The message type, or JSON_MSG_NONE if none matches (use the",
+        " *         generic jsmn path then).",
+        " */",
+        "json_msg_id_t",
+        "json_msg_parse (char const * const p_js, uint32_t const len,",
+        "                json_msg_t * const p_out)",
+        "{",
+        "    int32_t result = JSON_SCHEMA_NO_MATCH;",
+        "",
+        "    if (NULL == p_out)",
+        "    {",
+        "        return JSON_MSG_NONE;",
+        "    }",
+        "",
+    ]
+    lines.append("    /* Stop at the first match; a malformed document matches nothing */")
+    for msg in messages:
+        n = msg["name"]
+        lines += [
+            "    if (JSON_SCHEMA_NO_MATCH == result)",
+            "    {",
+            "        result = json_%s_parse(p_js, len, &p_out->u.%s);" % (n, n),
+            "        p_out->id = JSON_MSG_%s;" % n.upper(),
+            "    }",
+            "",
+        ]
+    lines += [
+        "    if (JSON_SCHEMA_OK != result)",
+        "    {",
+        "        p_out->id = JSON_MSG_NONE;",
+        "    }",
+        "",
+        "    return p_out->id;",
+        "}",
+        "",
+        "",
+        "/*!",
+        " * @brief Serialize any parsed message.",
+        " *",
+        " * @return Bytes written, -1 for JSON_MSG_NONE or a NULL pointer, -2 if",
+        " *         p_buf is too small.",
+        " */",
+        "int32_t",
+        "json_msg_write (json_msg_t const * const p_msg, char * const p_buf,",
+        "                uint32_t const size)",
+        "{",
+        "    if (NULL == p_msg)",
+        "    {",
+        "        return JSON_SCHEMA_ERR_ARG;",
+        "    }",
+        "",
+        "    switch (p_msg->id)",
+        "    {",
+    ]
+    for msg in messages:
+        n = msg["name"]
+        lines += [
+            "        case JSON_MSG_%s:" % n.upper(),
+            "        {",
+            "            return json_%s_write(&p_msg->u.%s, p_buf, size);" % (n, n),
+            "        }",
+            "",
+        ]
+    lines += [
+        "        default:",
+        "        {",
+        "            return JSON_SCHEMA_ERR_ARG;",
+        "        }",
+        "    }",
+        "}",
+        "",
+        "",
+        "/*!",
+        " * @brief Number of fields of the message's type (0 for JSON_MSG_NONE).",
+        " */",
+        "uint32_t",
+        "json_msg_field_count (json_msg_t const * const p_msg)",
+        "{",
+        "    switch (p_msg->id)",
+        "    {",
+    ]
+    for msg in messages:
+        lines += [
+            "        case JSON_MSG_%s:" % msg["name"].upper(),
+            "        {",
+            "            return %s;" % upper(msg, "FIELD_COUNT"),
+            "        }",
+            "",
+        ]
+    lines += [
+        "        default:",
+        "        {",
+        "            return 0u;",
+        "        }",
+        "    }",
+        "}",
+        "",
+        "",
+        "/*!",
+        " * @brief Field index of the member at a position in the document.",
+        " *",
+        " * @return Field index for json_msg_field(), or json_msg_field_count()",
+        " *         once position is past the last member.",
+        " */",
+        "uint32_t",
+        "json_msg_order (json_msg_t const * const p_msg, uint32_t const position)",
+        "{",
+        "    switch (p_msg->id)",
+        "    {",
+    ]
+    for msg in messages:
+        n = msg["name"]
+        lines += [
+            "        case JSON_MSG_%s:" % n.upper(),
+            "        {",
+            "            json_%s_t const * const p_rec = &p_msg->u.%s;" % (n, n),
+            "",
+            "            return (position < p_rec->count) ? p_rec->order[position] :",
+            "                                               %s;" % upper(msg, "FIELD_COUNT"),
+            "        }",
+            "",
+        ]
+    lines += [
+        "        default:",
+        "        {",
+        "            return 0u;",
+        "        }",
+        "    }",
+        "}",
+        "",
+        "",
+        "/*!",
+        " * @brief Generic view of field index (in jsonschema.def order).",
+        " *",
+        " * @return 0 if the field is present, -2 if it is absent, -1 if index",
+        " *         is out of range.",
+        " */",
+        "int32_t",
+        "json_msg_field (json_msg_t const * const p_msg, uint32_t const index,",
+        "                json_field_view_t * const p_view)",
+        "{",
+        "    json_field_desc_t const * p_desc = NULL;",
+        "    json_str_t const * p_text = NULL;",
+        "    uint32_t present = 0u;",
+        "",
+        "    p_view->p_items = NULL;",
+        "    p_view->item_count = 0u;",
+        "",
+        "    if (index >= json_msg_field_count(p_msg))",
+        "    {",
+        "        return -1;",
+        "    }",
+        "",
+        "    switch (p_msg->id)",
+        "    {",
+    ]
+    for msg in messages:
+        n = msg["name"]
+        lines += [
+            "        case JSON_MSG_%s:" % n.upper(),
+            "        {",
+            "            json_%s_t const * const p_rec = &p_msg->u.%s;" % (n, n),
+            "",
+            "            p_desc = &g_%s_fields[index];" % n,
+            "            p_text = &p_rec->text[index];",
+            "            present = p_rec->present;",
+        ]
+        for i, f in enumerate(msg["fields"]):
+            if f["max"]:
+                lines += [
+                    "",
+                    "            if (%du == index)" % i,
+                    "            {",
+                    "                p_view->p_items = p_rec->%s;" % f["key"],
+                    "                p_view->item_count = p_rec->%s_count;" % f["key"],
+                    "            }",
+                ]
+        lines += ["            break;", "        }", ""]
+    lines += [
+        "        default:",
+        "        {",
+        "            return -1;",
+        "        }",
+        "    }",
+        "",
+        "    if (0u == (present & (1u << index)))",
+        "    {",
+        "        return -2;",
+        "    }",
+        "",
+        "    p_view->p_key = p_desc->p_key;",
+        "    p_view->key_len = p_desc->key_len;",
+        "    p_view->type = p_desc->type;",
+        "    p_view->value = *p_text;",
+        "",
+        "    return 0;",
+        "}",
+        "",
+        "#ifdef __cplusplus",
+        "}",
+        "#endif",
+        "",
+        "/*** end of file ***/",
+        "",
+    ]
+    with open(out, "w") as f:
+        f.write("\n".join(lines))
+
+
+def main():
+    if len(sys.argv) != 4:
+        sys.exit(__doc__)
+    messages = load(sys.argv[1])
+    emit_header(messages, sys.argv[1], sys.argv[2])
+    emit_source(messages, sys.argv[1], sys.argv[2], sys.argv[3])
+
+
+if __name__ == "__main__":
+    main()
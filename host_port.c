@@ -0,0 +1,528 @@
+/** @file host_port.c
+ *
+ * @brief Host (PC) stand-ins for uart.c and delay.c.
+ *
+ * TX is instant: queued data is counted (and optionally echoed to
+ * stdout) and every completion mark is done at once. RX serves a
+ * caller-supplied buffer, optionally repeated, through the ring API.
+ * With UART_FRAMING_SLIP both directions are framed exactly as on the
+ * board, using the same slip.h decoder.
+ * Time comes from the host monotonic clock.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "uart.h"
+#include "delay.h"
+#include "clock.h"
+#include "timer.h"
+#include "host_port.h"
+#include "slip.h"
+
+/* Host "core clock" used to scale delay_get_cycles() */
+#define HOST_CYCLES_PER_NS_NUM    16u
+#define HOST_CYCLES_PER_NS_DEN    1000u
+
+volatile uart_state_t g_tx_state = UART_STATE_IDLE;
+volatile uart_state_t g_rx_state = UART_STATE_IDLE;
+
+static char const * g_p_host_rx = NULL;
+static uint32_t g_host_rx_len = 0u;
+static uint32_t g_host_rx_pos = 0u;
+static uint32_t g_host_rx_repeat = 0u;
+static uint64_t g_host_tx_bytes = 0u;
+static uint32_t g_host_tx_mark = 0u;
+static uint8_t g_b_host_echo = 0u;
+static uint64_t g_host_epoch_ns = 0u;
+static uint32_t g_host_ticks = 0u;       /* Timer wheel ticks delivered */
+static uint8_t g_b_host_in_tick = 0u;
+#if (UART_FRAMING == UART_FRAMING_SLIP)
+static uint16_t g_host_tx_crc = SLIP_CRC_INIT;
+static uint8_t g_b_host_tx_open = 0u;
+static slip_rx_t g_host_rx_slip;
+static char g_host_rx_frame[UART_RX_RING_SIZE_BYTES];
+#endif
+
+
+/*!
+ * @brief Account for (and optionally print) transmitted bytes.
+ */
+static void
+host_uart_sink (char const * const p_data, uint32_t const len)
+{
+    g_host_tx_bytes += len;
+
+    if (0u != g_b_host_echo)
+    {
+        (void)fwrite(p_data, 1u, len, stdout);
+    }
+}
+
+
+#if (UART_FRAMING == UART_FRAMING_SLIP)
+/*!
+ * @brief Transmit one byte as part of the current SLIP frame.
+ */
+static void
+host_uart_frame_byte (uint8_t const byte)
+{
+    char out[2];
+
+    if (0u == g_b_host_tx_open)
+    {
+        out[0] = (char)SLIP_END;
+        host_uart_sink(out, 1u);
+        g_host_tx_crc = SLIP_CRC_INIT;
+        g_b_host_tx_open = 1u;
+    }
+
+    g_host_tx_crc = slip_crc_update(g_host_tx_crc, byte);
+
+    if (slip_is_special(byte))
+    {
+        out[0] = (char)SLIP_ESC;
+        out[1] = (char)slip_escape_code(byte);
+        host_uart_sink(out, 2u);
+    }
+    else
+    {
+        out[0] = (char)byte;
+        host_uart_sink(out, 1u);
+    }
+}
+#endif
+
+
+/*!
+ * @brief Transmit queued data, framed if UART_FRAMING_SLIP.
+ */
+static void
+host_uart_send (char const * const p_data, uint32_t const len)
+{
+#if (UART_FRAMING == UART_FRAMING_SLIP)
+    uint32_t i;
+
+    for (i = 0u; i < len; i++)
+    {
+        host_uart_frame_byte((uint8_t)p_data[i]);
+    }
+#else
+    host_uart_sink(p_data, len);
+#endif
+}
+
+
+/*!
+ * @brief Take the next RX input byte (caller checks one is pending).
+ */
+static char
+host_uart_rx_take (void)
+{
+    char byte = g_p_host_rx[g_host_rx_pos];
+
+    g_host_rx_pos++;
+
+    if (g_host_rx_pos == g_host_rx_len)
+    {
+        g_host_rx_pos = 0u;
+        g_host_rx_repeat--;
+    }
+
+    return byte;
+}
+
+
+/*!
+ * @brief Serve a buffer as RX input, repeat times in a row.
+ */
+void
+host_uart_set_rx (char const * const p_data, uint32_t const len,
+                  uint32_t const repeat)
+{
+    g_p_host_rx = p_data;
+    g_host_rx_len = len;
+    g_host_rx_pos = 0u;
+    g_host_rx_repeat = ((NULL == p_data) || (0u == len)) ? 0u : repeat;
+#if (UART_FRAMING == UART_FRAMING_SLIP)
+    slip_rx_reset(&g_host_rx_slip);
+#endif
+}
+
+
+/*!
+ * @brief Bytes of RX input not yet read.
+ */
+uint32_t
+host_uart_rx_pending (void)
+{
+    if (0u == g_host_rx_repeat)
+    {
+        return 0u;
+    }
+
+    return ((g_host_rx_repeat - 1u) * g_host_rx_len) +
+           (g_host_rx_len - g_host_rx_pos);
+}
+
+
+/*!
+ * @brief Total bytes "transmitted" so far.
+ */
+uint64_t
+host_uart_tx_bytes (void)
+{
+    return g_host_tx_bytes;
+}
+
+
+/*!
+ * @brief Echo transmitted data to stdout (off by default).
+ */
+void
+host_uart_set_echo (uint8_t const b_echo)
+{
+    g_b_host_echo = b_echo;
+}
+
+
+/*!
+ * @brief Monotonic time in nanoseconds.
+ */
+uint64_t
+host_time_ns (void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000u) + (uint64_t)ts.tv_nsec;
+}
+
+
+/* uart.h */
+
+int32_t
+uart_init (void)
+{
+    g_tx_state = UART_STATE_IDLE;
+    g_rx_state = UART_STATE_IDLE;
+    return 0;
+}
+
+int32_t
+uart_transmit_buffer (char const * const p_str)
+{
+    if (NULL == p_str)
+    {
+        return -1;
+    }
+
+    host_uart_sink(p_str, (uint32_t)strlen(p_str));
+    return 0;
+}
+
+int32_t
+uart_receive_buffer (void)
+{
+    return 0;
+}
+
+void
+uart_error_reset (void)
+{
+}
+
+int32_t
+uart_set_baud (uint32_t const baud)
+{
+    return (0u == baud) ? -1 : 0;
+}
+
+uint32_t
+uart_get_baud (void)
+{
+    return UART_BAUD_RATE;
+}
+
+int32_t
+uart_enqueue (char const * const p_data, uint32_t const len)
+{
+    if (NULL == p_data)
+    {
+        return -1;
+    }
+
+    host_uart_send(p_data, len);
+    g_host_tx_mark++;
+    return 0;
+}
+
+uint32_t
+uart_tx_free (void)
+{
+    return UART_TX_FIFO_SIZE_BYTES;
+}
+
+int32_t
+uart_enqueue_slices (uart_slice_t const * const p_slices, uint32_t const count)
+{
+    uint32_t i;
+
+    if (NULL == p_slices)
+    {
+        return -1;
+    }
+
+    for (i = 0u; i < count; i++)
+    {
+        host_uart_send(p_slices[i].p_data, p_slices[i].len);
+    }
+
+    g_host_tx_mark++;
+    return 0;
+}
+
+int32_t
+uart_enqueue_copy (uart_slice_t const * const p_slices, uint32_t const count)
+{
+    return uart_enqueue_slices(p_slices, count);
+}
+
+void
+uart_tx_batch_begin (void)
+{
+}
+
+void
+uart_tx_batch_flush (void)
+{
+}
+
+uint32_t
+uart_tx_slots_free (void)
+{
+    return UART_TX_DESC_COUNT;
+}
+
+uint32_t
+uart_tx_mark (void)
+{
+    return g_host_tx_mark;
+}
+
+bool_t
+uart_tx_done (uint32_t const mark)
+{
+    (void)mark;
+    return TRUE;
+}
+
+int32_t
+uart_rx_start (void)
+{
+    g_rx_state = UART_STATE_RX_BUSY;
+    return 0;
+}
+
+void
+uart_rx_stop (void)
+{
+    g_rx_state = UART_STATE_IDLE;
+}
+
+uint32_t
+uart_rx_available (void)
+{
+    return host_uart_rx_pending();
+}
+
+void
+uart_rx_hold (bool_t const b_hold)
+{
+    /* The simulated sender never overruns */
+    (void)b_hold;
+}
+
+uint32_t
+uart_rx_read (char * const p_dst, uint32_t const max_len)
+{
+    uint32_t count = 0u;
+
+    /* Hand out at most one ring's worth per call, like the real ring */
+    while ((count < max_len) && (count < UART_RX_RING_SIZE_BYTES) &&
+           (0u != g_host_rx_repeat))
+    {
+        p_dst[count] = host_uart_rx_take();
+        count++;
+    }
+
+    return count;
+}
+
+int32_t
+uart_frame_end (void)
+{
+#if (UART_FRAMING == UART_FRAMING_SLIP)
+    uint16_t const crc = g_host_tx_crc;
+    char const end = (char)SLIP_END;
+
+    if (0u != g_b_host_tx_open)
+    {
+        host_uart_frame_byte((uint8_t)(crc >> 8));
+        host_uart_frame_byte((uint8_t)crc);
+        host_uart_sink(&end, 1u);
+        g_b_host_tx_open = 0u;
+    }
+#endif
+
+    return 0;
+}
+
+int32_t
+uart_rx_read_frame (char * const p_dst, uint32_t const max_len)
+{
+#if (UART_FRAMING == UART_FRAMING_SLIP)
+    /* Decode input until a good frame ends; bad frames are skipped */
+    while (0u != g_host_rx_repeat)
+    {
+        uint8_t byte = (uint8_t)host_uart_rx_take();
+        slip_rx_event_t const event = slip_rx_byte(&g_host_rx_slip, &byte);
+
+        if (SLIP_RX_DATA == event)
+        {
+            if (g_host_rx_slip.len > UART_RX_RING_SIZE_BYTES)
+            {
+                slip_rx_fail(&g_host_rx_slip);
+            }
+            else
+            {
+                g_host_rx_frame[g_host_rx_slip.len - 1u] = (char)byte;
+            }
+        }
+        else if (SLIP_RX_FRAME == event)
+        {
+            uint32_t const len = g_host_rx_slip.frame_len;
+
+            if ((NULL == p_dst) || (len > max_len))
+            {
+                return -1;
+            }
+
+            (void)memcpy(p_dst, g_host_rx_frame, len);
+            return (int32_t)len;
+        }
+        else
+        {
+            /* ESC, idle END or a rejected frame */
+        }
+    }
+#else
+    (void)p_dst;
+    (void)max_len;
+#endif
+
+    return 0;
+}
+
+void
+uart_get_stats (uart_stats_t * const p_stats)
+{
+    /* Only the TX byte count is tracked on the host */
+    (void)memset(p_stats, 0, sizeof(*p_stats));
+    p_stats->tx_bytes = (uint32_t)g_host_tx_bytes;
+}
+
+
+/* clock.h - delay_get_cycles() always counts a 16 MHz core */
+
+int32_t
+clock_set_sysclk (uint32_t const hz)
+{
+    return (hz <= CLOCK_MAX_HZ) ? 0 : -1;
+}
+
+uint32_t
+clock_get_hz (void)
+{
+    return CLOCK_HSI_HZ;
+}
+
+
+/* delay.h */
+
+void
+delay_init (void)
+{
+    g_host_epoch_ns = host_time_ns();
+    g_host_ticks = 0u;
+}
+
+uint32_t
+delay_get_tick (void)
+{
+    uint32_t const now = (uint32_t)((host_time_ns() - g_host_epoch_ns) /
+                                    1000000u);
+
+    /* No SysTick here: catch the timer wheel up whenever time is read.
+     * Timer callbacks see the tick being delivered, as on the target. */
+    if (0u == g_b_host_in_tick)
+    {
+        g_b_host_in_tick = 1u;
+
+        while ((int32_t)(now - g_host_ticks) > 0)
+        {
+            g_host_ticks++;
+            timer_tick();
+        }
+
+        g_b_host_in_tick = 0u;
+    }
+
+    return g_host_ticks;
+}
+
+uint32_t
+delay_get_cycles (void)
+{
+    return (uint32_t)(((host_time_ns() - g_host_epoch_ns) *
+                       HOST_CYCLES_PER_NS_NUM) / HOST_CYCLES_PER_NS_DEN);
+}
+
+uint32_t
+delay_get_us (void)
+{
+    return (uint32_t)((host_time_ns() - g_host_epoch_ns) / 1000u);
+}
+
+uint8_t
+delay_elapsed (uint32_t start_tick, uint32_t delay_ms)
+{
+    return ((delay_get_tick() - start_tick) >= delay_ms) ? 1u : 0u;
+}
+
+uint32_t
+delay_start (void)
+{
+    return delay_get_tick();
+}
+
+void
+delay_ms (uint32_t milliseconds)
+{
+    uint32_t start = delay_get_tick();
+
+    while ((delay_get_tick() - start) < milliseconds)
+    {
+        /* Busy wait */
+    }
+}
+
+/*** end of file ***/
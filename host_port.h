@@ -0,0 +1,28 @@
+/** @file host_port.h
+ *
+ * @brief Host (PC) stand-ins for the UART and delay drivers.
+ *
+ * host_port.c implements the uart.h and delay.h interfaces without
+ * touching any registers, so jsmn.c and the JSON processing core can be
+ * built natively (HOST_BUILD) and benchmarked without a board.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#ifndef HOST_PORT_H
+#define HOST_PORT_H
+
+#include <stdint.h>
+
+/* Public API functions (host only) */
+void host_uart_set_rx(char const * const p_data, uint32_t const len,
+                      uint32_t const repeat);
+uint32_t host_uart_rx_pending(void);
+uint64_t host_uart_tx_bytes(void);
+void host_uart_set_echo(uint8_t const b_echo);
+uint64_t host_time_ns(void);
+
+#endif /* HOST_PORT_H */
+
+/*** end of file ***/
@@ -61,6 +61,94 @@ extern "C" {
 /* Unicode escape sequence length */
 #define UNICODE_HEX_DIGITS   4
 
+#ifdef JSMN_PARENT_LINKS
+/* Parent link as a token index (-1 for none, whatever the field width) */
+#define JSMN_PARENT_INDEX(p_tok) \
+    ((JSMN_NONE == (p_tok)->parent) ? -1 : (int32_t)(p_tok)->parent)
+#endif
+
+#ifdef JSMN_FAST_SCAN
+/* Word-at-a-time (SWAR) scanning: four input bytes per 32-bit test */
+#define SWAR_ONES            0x01010101u
+#define SWAR_HIGHS           0x80808080u
+#define SWAR_SPACES          0x20202020u
+
+/* Non-zero if any byte of v is 0x00 (exact as a yes/no test) */
+#define SWAR_HAS_ZERO(v)     (((v) - SWAR_ONES) & ~(v) & SWAR_HIGHS)
+
+/* Non-zero if any byte of v equals c */
+#define SWAR_HAS_BYTE(v, c)  SWAR_HAS_ZERO((v) ^ (SWAR_ONES * (uint32_t)(c)))
+
+/* Input read as words; may alias the char buffer */
+#if defined(__GNUC__)
+typedef uint32_t __attribute__((__may_alias__)) jsmn_word_t;
+#else
+typedef uint32_t jsmn_word_t;
+#endif
+
+/* Cortex-M0+ faults on unaligned word loads: words are read only from
+ * aligned positions, the byte loops cover the bytes in between */
+#define JSMN_WORD_ALIGNED(p) (0u == ((uintptr_t)(p) & (sizeof(uint32_t) - 1u)))
+#define JSMN_WORD_AT(p_js, pos) \
+    (*(jsmn_word_t const *)(void const *)&(p_js)[pos])
+
+/* Whitespace byte (same set as the main loop's whitespace cases) */
+#define JSMN_IS_SPACE(c)     ((CHAR_SPACE == (c)) || (CHAR_HTAB == (c)) || \
+                              (CHAR_LF == (c)) || (CHAR_CR == (c)))
+
+
+/*!
+ * @brief Skip whole words of string body (no quote, backslash or NUL).
+ *
+ * @param[in] pos Word-aligned start position.
+ *
+ * @return Position of the first word that needs a byte-wise look.
+ */
+static uint32_t
+jsmn_scan_string_words (char const * const p_js, uint32_t pos,
+                        size_t const len)
+{
+    while ((pos + sizeof(uint32_t)) <= len)
+    {
+        uint32_t const w = JSMN_WORD_AT(p_js, pos);
+
+        if (0u != (SWAR_HAS_ZERO(w) | SWAR_HAS_BYTE(w, CHAR_QUOTE) |
+                   SWAR_HAS_BYTE(w, CHAR_BACKSLASH)))
+        {
+            break;
+        }
+
+        pos += sizeof(uint32_t);
+    }
+
+    return pos;
+}
+
+
+/*!
+ * @brief Skip a whitespace run: bytes, and whole words of indentation.
+ *
+ * @return Position of the first non-whitespace byte (or len).
+ */
+static uint32_t
+jsmn_skip_space (char const * const p_js, uint32_t pos, size_t const len)
+{
+    while ((pos < len) && JSMN_IS_SPACE(p_js[pos]))
+    {
+        pos++;
+
+        while (JSMN_WORD_ALIGNED(&p_js[pos]) &&
+               ((pos + sizeof(uint32_t)) <= len) &&
+               (SWAR_SPACES == JSMN_WORD_AT(p_js, pos)))
+        {
+            pos += sizeof(uint32_t);
+        }
+    }
+
+    return pos;
+}
+#endif /* JSMN_FAST_SCAN */
+
 
 /*!
  * @brief Allocate next available token from token array.
@@ -82,11 +170,11 @@ jsmn_alloc_token (jsmn_parser_t * p_parser, jsmntok_t * p_tokens,
         p_tok = &p_tokens[p_parser->toknext];
         p_parser->toknext++;
         
-        p_tok->start = -1;
-        p_tok->end = -1;
+        p_tok->start = (jsmnidx_t)JSMN_NONE;
+        p_tok->end = (jsmnidx_t)JSMN_NONE;
         p_tok->size = 0;
 #ifdef JSMN_PARENT_LINKS
-        p_tok->parent = -1;
+        p_tok->parent = (jsmnidx_t)JSMN_NONE;
 #endif
     }
     
@@ -107,8 +195,8 @@ jsmn_fill_token (jsmntok_t * p_token, jsmntype_t const type,
                  int32_t const start, int32_t const end)
 {
     p_token->type = type;
-    p_token->start = start;
-    p_token->end = end;
+    p_token->start = (jsmnidx_t)start;
+    p_token->end = (jsmnidx_t)end;
     p_token->size = 0;
 }
 
@@ -201,7 +289,7 @@ jsmn_parse_primitive (jsmn_parser_t * p_parser, char const * const p_js,
                     (int32_t)p_parser->pos);
                     
 #ifdef JSMN_PARENT_LINKS
-    p_token->parent = p_parser->toksuper;
+    p_token->parent = (jsmnidx_t)p_parser->toksuper;
 #endif
     
     p_parser->pos--;
@@ -235,6 +323,24 @@ jsmn_parse_string (jsmn_parser_t * p_parser, char const * const p_js,
     for (; (p_parser->pos < len) && (CHAR_NULL != p_js[p_parser->pos]); 
          p_parser->pos++)
     {
+#ifdef JSMN_FAST_SCAN
+        /* Word tests only pay off past the first few bytes: short keys
+         * such as "uid" stay on the byte loop */
+        if (((p_parser->pos - start) > sizeof(uint32_t)) &&
+            JSMN_WORD_ALIGNED(&p_js[p_parser->pos]))
+        {
+            uint32_t const next = jsmn_scan_string_words(p_js,
+                                                         p_parser->pos, len);
+
+            if (next != p_parser->pos)
+            {
+                /* Re-enter the loop test at the first unscanned byte */
+                p_parser->pos = next - 1u;
+                continue;
+            }
+        }
+#endif
+
         char c = p_js[p_parser->pos];
 
         /* Quote: end of string */
@@ -257,7 +363,7 @@ jsmn_parse_string (jsmn_parser_t * p_parser, char const * const p_js,
                            (int32_t)p_parser->pos);
                            
 #ifdef JSMN_PARENT_LINKS
-            p_token->parent = p_parser->toksuper;
+            p_token->parent = (jsmnidx_t)p_parser->toksuper;
 #endif
             return 0;
         }
@@ -350,6 +456,14 @@ jsmn_parse (jsmn_parser_t * p_parser, char const * const p_js,
     int32_t count = (int32_t)p_parser->toknext;
     jsmntype_t type;
 
+#ifdef JSMN_COMPACT_TOKENS
+    /* Positions must fit the 16-bit token fields */
+    if (len > JSMN_COMPACT_MAX_LEN)
+    {
+        return JSMN_ERROR_INVAL;
+    }
+#endif
+
     for (; (p_parser->pos < len) && (CHAR_NULL != p_js[p_parser->pos]); 
          p_parser->pos++)
     {
@@ -388,12 +502,12 @@ jsmn_parse (jsmn_parser_t * p_parser, char const * const p_js,
                     p_t->size++;
                     
 #ifdef JSMN_PARENT_LINKS
-                    p_token->parent = p_parser->toksuper;
+                    p_token->parent = (jsmnidx_t)p_parser->toksuper;
 #endif
                 }
                 
                 p_token->type = (CHAR_BRACE_OPEN == c) ? JSMN_OBJECT : JSMN_ARRAY;
-                p_token->start = (int32_t)p_parser->pos;
+                p_token->start = (jsmnidx_t)p_parser->pos;
                 p_parser->toksuper = (int32_t)(p_parser->toknext - 1u);
                 break;
             }
@@ -418,19 +532,20 @@ jsmn_parse (jsmn_parser_t * p_parser, char const * const p_js,
                 
                 for (;;)
                 {
-                    if ((-1 != p_token->start) && (-1 == p_token->end))
+                    if ((JSMN_NONE != p_token->start) &&
+                        (JSMN_NONE == p_token->end))
                     {
                         if (type != p_token->type)
                         {
                             return JSMN_ERROR_INVAL;
                         }
                         
-                        p_token->end = (int32_t)(p_parser->pos + 1u);
-                        p_parser->toksuper = p_token->parent;
+                        p_token->end = (jsmnidx_t)(p_parser->pos + 1u);
+                        p_parser->toksuper = JSMN_PARENT_INDEX(p_token);
                         break;
                     }
                     
-                    if (-1 == p_token->parent)
+                    if (JSMN_NONE == p_token->parent)
                     {
                         if ((type != p_token->type) || (-1 == p_parser->toksuper))
                         {
@@ -446,7 +561,8 @@ jsmn_parse (jsmn_parser_t * p_parser, char const * const p_js,
                 {
                     p_token = &p_tokens[i];
                     
-                    if ((-1 != p_token->start) && (-1 == p_token->end))
+                    if ((JSMN_NONE != p_token->start) &&
+                        (JSMN_NONE == p_token->end))
                     {
                         if (type != p_token->type)
                         {
@@ -454,7 +570,7 @@ jsmn_parse (jsmn_parser_t * p_parser, char const * const p_js,
                         }
                         
                         p_parser->toksuper = -1;
-                        p_token->end = (int32_t)(p_parser->pos + 1u);
+                        p_token->end = (jsmnidx_t)(p_parser->pos + 1u);
                         break;
                     }
                 }
@@ -469,7 +585,8 @@ jsmn_parse (jsmn_parser_t * p_parser, char const * const p_js,
                 {
                     p_token = &p_tokens[i];
                     
-                    if ((-1 != p_token->start) && (-1 == p_token->end))
+                    if ((JSMN_NONE != p_token->start) &&
+                        (JSMN_NONE == p_token->end))
                     {
                         p_parser->toksuper = i;
                         break;
@@ -502,6 +619,11 @@ jsmn_parse (jsmn_parser_t * p_parser, char const * const p_js,
             case CHAR_LF:
             case CHAR_SPACE:
             {
+#ifdef JSMN_FAST_SCAN
+                /* Consume the whole run; the loop steps onto its end */
+                p_parser->pos = jsmn_skip_space(p_js, p_parser->pos + 1u,
+                                                len) - 1u;
+#endif
                 break;
             }
             
@@ -519,15 +641,16 @@ jsmn_parse (jsmn_parser_t * p_parser, char const * const p_js,
                     (JSMN_OBJECT != p_tokens[p_parser->toksuper].type))
                 {
 #ifdef JSMN_PARENT_LINKS
-                    p_parser->toksuper = p_tokens[p_parser->toksuper].parent;
+                    p_parser->toksuper =
+                        JSMN_PARENT_INDEX(&p_tokens[p_parser->toksuper]);
 #else
                     for (i = (int32_t)(p_parser->toknext - 1u); i >= 0; i--)
                     {
                         if ((JSMN_ARRAY == p_tokens[i].type) || 
                             (JSMN_OBJECT == p_tokens[i].type))
                         {
-                            if ((-1 != p_tokens[i].start) && 
-                                (-1 == p_tokens[i].end))
+                            if ((JSMN_NONE != p_tokens[i].start) && 
+                                (JSMN_NONE == p_tokens[i].end))
                             {
                                 p_parser->toksuper = i;
                                 break;
@@ -603,7 +726,8 @@ jsmn_parse (jsmn_parser_t * p_parser, char const * const p_js,
         for (i = (int32_t)(p_parser->toknext - 1u); i >= 0; i--)
         {
             /* Unmatched opened object or array */
-            if ((-1 != p_tokens[i].start) && (-1 == p_tokens[i].end))
+            if ((JSMN_NONE != p_tokens[i].start) &&
+                (JSMN_NONE == p_tokens[i].end))
             {
                 return JSMN_ERROR_PART;
             }
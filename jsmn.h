@@ -71,23 +71,53 @@ enum jsmnerr
     JSMN_ERROR_PART = -3    /* The string is not a full JSON packet */
 };
 
+/**
+ * Token field type and the "not set" value of start/end/parent.
+ * With JSMN_COMPACT_TOKENS fields are 16 bits wide: input is limited to
+ * JSMN_COMPACT_MAX_LEN bytes and 0xFFFF marks an unset field.
+ */
+#ifdef JSMN_COMPACT_TOKENS
+typedef uint16_t jsmnidx_t;
+#define JSMN_NONE              0xFFFF
+#define JSMN_COMPACT_MAX_LEN   0xFFFEu
+#else
+typedef int32_t jsmnidx_t;
+#define JSMN_NONE              (-1)
+#endif
+
 /**
  * JSON token description.
  * type     type (object, array, string etc.)
  * start    start position in JSON data string
  * end      end position in JSON data string
  * size     number of child tokens
+ *
+ * Default layout: 16 bytes (20 with JSMN_PARENT_LINKS).
+ * JSMN_COMPACT_TOKENS: 8 bytes (10 with JSMN_PARENT_LINKS).
  */
+#ifdef JSMN_COMPACT_TOKENS
+typedef struct jsmntok
+{
+    jsmnidx_t start;
+    jsmnidx_t end;
+    jsmnidx_t size;
+#ifdef JSMN_PARENT_LINKS
+    jsmnidx_t parent;
+#endif
+    uint8_t type;      /* jsmntype_t */
+} jsmntok_t;
+#else
 typedef struct jsmntok
 {
     jsmntype_t type;
-    int32_t start;
-    int32_t end;
-    int32_t size;
+    jsmnidx_t start;
+    jsmnidx_t end;
+    jsmnidx_t size;
 #ifdef JSMN_PARENT_LINKS
-    int32_t parent;
+    jsmnidx_t parent;
 #endif
 } jsmntok_t;
+#endif
 
 /**
  * JSON parser. Contains an array of token blocks available. Also stores
@@ -0,0 +1,36 @@
+/** @file jsonkeys_table.h
+ *
+ * @brief Root-key dispatch table (GENERATED - do not edit).
+ *
+ * Generated by gen_keytable.py from jsonkeys.def. Included once, by
+ * jsonprocess.c, after the key handlers are declared.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#ifndef JSONKEYS_TABLE_H
+#define JSONKEYS_TABLE_H
+
+/* slot = (len * A + first * B + last * C) & MASK */
+#define JSON_KEY_HASH_MUL_LEN    0u
+#define JSON_KEY_HASH_MUL_FIRST  2u
+#define JSON_KEY_HASH_MUL_LAST   1u
+#define JSON_KEY_TABLE_SIZE      8u
+#define JSON_KEY_HASH_MASK       (JSON_KEY_TABLE_SIZE - 1u)
+
+static json_key_t const g_key_table[JSON_KEY_TABLE_SIZE] =
+{
+    /*  0 */ { "admin", 5u, "- Admin: ", 9u, json_key_bool },
+    /*  1 */ { "groups", 6u, "- Groups: ", 10u, json_key_array },
+    /*  2 */ { "cmd", 3u, "- Cmd: ", 7u, json_key_command },
+    /*  3 */ { NULL, 0u, NULL, 0u, NULL },
+    /*  4 */ { "user", 4u, "- User: ", 8u, json_key_scalar },
+    /*  5 */ { NULL, 0u, NULL, 0u, NULL },
+    /*  6 */ { "uid", 3u, "- UID: ", 7u, json_key_int32 },
+    /*  7 */ { NULL, 0u, NULL, 0u, NULL }
+};
+
+#endif /* JSONKEYS_TABLE_H */
+
+/*** end of file ***/
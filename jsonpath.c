@@ -0,0 +1,593 @@
+/** @file jsonpath.c
+ *
+ * @brief Lazy JSON lookup implementation.
+ *
+ * A cursor walks the text. At each level only the keys (objects) or the
+ * element count (arrays) are looked at; every value off the path is
+ * skipped as a whole: strings to their closing quote (escapes honoured),
+ * objects/arrays by bracket depth with string awareness, primitives to
+ * the next delimiter. Memory use is the cursor and the compiled path.
+ *
+ * This is a lookup, not a validator: structure is only checked as far
+ * as needed to find the value, which is returned in the same form as a
+ * jsmn token would describe it.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "jsmn.h"
+#include "types.h"
+#include "jsonpath.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Scan cursor */
+typedef struct
+{
+    char const * p_js;
+    uint32_t len;
+    uint32_t pos;
+} json_cursor_t;
+
+
+/*!
+ * @brief Skip whitespace.
+ *
+ * @return TRUE if a byte follows, FALSE at the end of the input.
+ */
+static bool_t
+json_path_skip_space (json_cursor_t * const p_cur)
+{
+    while (p_cur->pos < p_cur->len)
+    {
+        char const c = p_cur->p_js[p_cur->pos];
+
+        if ((' ' != c) && ('\t' != c) && ('\n' != c) && ('\r' != c))
+        {
+            return ('\0' != c) ? TRUE : FALSE;
+        }
+
+        p_cur->pos++;
+    }
+
+    return FALSE;
+}
+
+
+/*!
+ * @brief Skip a string; the cursor is on its opening quote.
+ *
+ * @return 0 with the cursor after the closing quote, or
+ *         JSON_PATH_ERR_MALFORMED if the string is not terminated.
+ */
+static int32_t
+json_path_skip_string (json_cursor_t * const p_cur)
+{
+    char const * p = &p_cur->p_js[p_cur->pos + 1u];
+    char const * const p_end = &p_cur->p_js[p_cur->len];
+
+    while (p < p_end)
+    {
+        char const c = *p;
+
+        if ('"' == c)
+        {
+            p_cur->pos = (uint32_t)(p - p_cur->p_js) + 1u;
+            return 0;
+        }
+
+        if ('\\' == c)
+        {
+            /* Escaped byte (including \" and \\) cannot end the string */
+            if ((p_end - p) < 2)
+            {
+                break;
+            }
+            p += 2;
+            continue;
+        }
+
+        if ('\0' == c)
+        {
+            break;
+        }
+
+        p++;
+    }
+
+    return JSON_PATH_ERR_MALFORMED;
+}
+
+
+/*!
+ * @brief Check for a byte that ends a primitive.
+ */
+static inline bool_t
+json_path_is_delim (char const c)
+{
+    switch (c)
+    {
+        case ',':
+        case '}':
+        case ']':
+        case ':':
+        case ' ':
+        case '\t':
+        case '\r':
+        case '\n':
+        case '\0':
+            return TRUE;
+
+        default:
+            return FALSE;
+    }
+}
+
+
+/*!
+ * @brief Skip one value of any type; the cursor is on its first byte.
+ *
+ * @return 0 with the cursor after the value, or JSON_PATH_ERR_MALFORMED.
+ */
+static int32_t
+json_path_skip_value (json_cursor_t * const p_cur)
+{
+    char const * const p_js = p_cur->p_js;
+    uint32_t const len = p_cur->len;
+    uint32_t pos = p_cur->pos;
+    uint32_t depth = 0u;
+    char c = p_js[pos];
+
+    if (('{' != c) && ('[' != c))
+    {
+        if ('"' == c)
+        {
+            return json_path_skip_string(p_cur);
+        }
+
+        if (json_path_is_delim(c))
+        {
+            return JSON_PATH_ERR_MALFORMED;
+        }
+
+        /* Primitive: run to the delimiter */
+        while ((pos < len) && !json_path_is_delim(p_js[pos]))
+        {
+            pos++;
+        }
+
+        p_cur->pos = pos;
+        return 0;
+    }
+
+    /* Container: only quotes and brackets matter until it closes */
+    while (pos < len)
+    {
+        c = p_js[pos];
+
+        if ('"' == c)
+        {
+            p_cur->pos = pos;
+
+            if (0 != json_path_skip_string(p_cur))
+            {
+                return JSON_PATH_ERR_MALFORMED;
+            }
+
+            pos = p_cur->pos;
+            continue;
+        }
+
+        if (('{' == c) || ('[' == c))
+        {
+            if (depth >= JSON_PATH_MAX_SKIP_DEPTH)
+            {
+                return JSON_PATH_ERR_MALFORMED;
+            }
+            depth++;
+        }
+        else if (('}' == c) || (']' == c))
+        {
+            depth--;
+
+            if (0u == depth)
+            {
+                p_cur->pos = pos + 1u;
+                return 0;
+            }
+        }
+        else if ('\0' == c)
+        {
+            break;
+        }
+        else
+        {
+            /* ',', ':', whitespace and primitives inside the container */
+        }
+
+        pos++;
+    }
+
+    return JSON_PATH_ERR_MALFORMED;
+}
+
+
+/*!
+ * @brief Describe the value under the cursor without moving past it.
+ *
+ * @return 0 on success, or JSON_PATH_ERR_MALFORMED.
+ */
+static int32_t
+json_path_take_value (json_cursor_t * const p_cur, json_value_t * const p_value)
+{
+    uint32_t const start = p_cur->pos;
+    char const c = p_cur->p_js[start];
+    int32_t result = json_path_skip_value(p_cur);
+
+    if (0 != result)
+    {
+        return result;
+    }
+
+    if ('"' == c)
+    {
+        p_value->type = JSMN_STRING;
+        p_value->p_start = &p_cur->p_js[start + 1u];
+        p_value->len = p_cur->pos - start - 2u;
+    }
+    else
+    {
+        p_value->type = ('{' == c) ? JSMN_OBJECT :
+                        (('[' == c) ? JSMN_ARRAY : JSMN_PRIMITIVE);
+        p_value->p_start = &p_cur->p_js[start];
+        p_value->len = p_cur->pos - start;
+    }
+
+    return 0;
+}
+
+
+/*!
+ * @brief Step past the separator that follows a member or element.
+ *
+ * @return 1 if another member/element follows, 0 at the closing bracket
+ *         (consumed), or JSON_PATH_ERR_MALFORMED.
+ */
+static int32_t
+json_path_next_item (json_cursor_t * const p_cur, char const close)
+{
+    if (!json_path_skip_space(p_cur))
+    {
+        return JSON_PATH_ERR_MALFORMED;
+    }
+
+    if (',' == p_cur->p_js[p_cur->pos])
+    {
+        p_cur->pos++;
+        return 1;
+    }
+
+    if (close == p_cur->p_js[p_cur->pos])
+    {
+        p_cur->pos++;
+        return 0;
+    }
+
+    return JSON_PATH_ERR_MALFORMED;
+}
+
+
+/*!
+ * @brief Move the cursor onto the value of one member of an object.
+ *
+ * The cursor is on the object's '{'.
+ *
+ * @return 0 with the cursor on the member's value, or a negative code.
+ */
+static int32_t
+json_path_enter_member (json_cursor_t * const p_cur,
+                        json_path_segment_t const * const p_seg)
+{
+    int32_t more;
+
+    p_cur->pos++;
+
+    if (!json_path_skip_space(p_cur))
+    {
+        return JSON_PATH_ERR_MALFORMED;
+    }
+
+    if ('}' == p_cur->p_js[p_cur->pos])
+    {
+        return JSON_PATH_ERR_NOT_FOUND;
+    }
+
+    do
+    {
+        uint32_t key_start;
+        uint32_t key_len;
+
+        if (!json_path_skip_space(p_cur) || ('"' != p_cur->p_js[p_cur->pos]))
+        {
+            return JSON_PATH_ERR_MALFORMED;
+        }
+
+        key_start = p_cur->pos + 1u;
+
+        if (0 != json_path_skip_string(p_cur))
+        {
+            return JSON_PATH_ERR_MALFORMED;
+        }
+
+        key_len = p_cur->pos - key_start - 1u;
+
+        if (!json_path_skip_space(p_cur) || (':' != p_cur->p_js[p_cur->pos]))
+        {
+            return JSON_PATH_ERR_MALFORMED;
+        }
+
+        p_cur->pos++;
+
+        if (!json_path_skip_space(p_cur))
+        {
+            return JSON_PATH_ERR_MALFORMED;
+        }
+
+        if ((key_len == p_seg->key_len) &&
+            (0 == memcmp(&p_cur->p_js[key_start], p_seg->p_key, key_len)))
+        {
+            return 0;
+        }
+
+        if (0 != json_path_skip_value(p_cur))
+        {
+            return JSON_PATH_ERR_MALFORMED;
+        }
+
+        more = json_path_next_item(p_cur, '}');
+    } while (1 == more);
+
+    return (0 == more) ? JSON_PATH_ERR_NOT_FOUND : more;
+}
+
+
+/*!
+ * @brief Move the cursor onto one element of an array.
+ *
+ * The cursor is on the array's '['.
+ *
+ * @return 0 with the cursor on the element, or a negative code.
+ */
+static int32_t
+json_path_enter_element (json_cursor_t * const p_cur, uint32_t const index)
+{
+    uint32_t i = 0u;
+    int32_t more;
+
+    p_cur->pos++;
+
+    if (!json_path_skip_space(p_cur))
+    {
+        return JSON_PATH_ERR_MALFORMED;
+    }
+
+    if (']' == p_cur->p_js[p_cur->pos])
+    {
+        return JSON_PATH_ERR_NOT_FOUND;
+    }
+
+    do
+    {
+        if (!json_path_skip_space(p_cur))
+        {
+            return JSON_PATH_ERR_MALFORMED;
+        }
+
+        if (i == index)
+        {
+            return 0;
+        }
+
+        if (0 != json_path_skip_value(p_cur))
+        {
+            return JSON_PATH_ERR_MALFORMED;
+        }
+
+        i++;
+        more = json_path_next_item(p_cur, ']');
+    } while (1 == more);
+
+    return (0 == more) ? JSON_PATH_ERR_NOT_FOUND : more;
+}
+
+
+/*!
+ * @brief Compile a path string into segments.
+ *
+ * @param[in] p_path Path such as "cfg.pins[1]" (must outlive p_out).
+ * @param[out] p_out Compiled path.
+ *
+ * @return Number of segments, or JSON_PATH_ERR_ARG on a NULL pointer,
+ *         a syntax error or more than JSON_PATH_MAX_SEGMENTS segments.
+ */
+int32_t
+json_path_compile (char const * const p_path, json_path_t * const p_out)
+{
+    char const * p = p_path;
+
+    if ((NULL == p_path) || (NULL == p_out))
+    {
+        return JSON_PATH_ERR_ARG;
+    }
+
+    p_out->count = 0u;
+
+    while ('\0' != *p)
+    {
+        json_path_segment_t * p_seg;
+
+        if (p_out->count >= JSON_PATH_MAX_SEGMENTS)
+        {
+            return JSON_PATH_ERR_ARG;
+        }
+
+        p_seg = &p_out->segments[p_out->count];
+
+        if ('[' == *p)
+        {
+            uint32_t index = 0u;
+
+            p++;
+
+            if ((*p < '0') || (*p > '9'))
+            {
+                return JSON_PATH_ERR_ARG;
+            }
+
+            while ((*p >= '0') && (*p <= '9'))
+            {
+                index = (index * 10u) + (uint32_t)(*p - '0');
+                p++;
+            }
+
+            if (']' != *p)
+            {
+                return JSON_PATH_ERR_ARG;
+            }
+
+            p++;
+            p_seg->p_key = NULL;
+            p_seg->key_len = 0u;
+            p_seg->index = index;
+        }
+        else
+        {
+            /* A key; after the first segment it is introduced by '.' */
+            if (0u != p_out->count)
+            {
+                if ('.' != *p)
+                {
+                    return JSON_PATH_ERR_ARG;
+                }
+                p++;
+            }
+
+            p_seg->p_key = p;
+
+            while (('\0' != *p) && ('.' != *p) && ('[' != *p))
+            {
+                p++;
+            }
+
+            p_seg->key_len = (uint32_t)(p - p_seg->p_key);
+            p_seg->index = 0u;
+
+            if (0u == p_seg->key_len)
+            {
+                return JSON_PATH_ERR_ARG;
+            }
+        }
+
+        p_out->count++;
+    }
+
+    return (int32_t)p_out->count;
+}
+
+
+/*!
+ * @brief Find the value a compiled path points to.
+ *
+ * @param[in] p_js JSON document.
+ * @param[in] len Length of p_js.
+ * @param[in] p_path Compiled path.
+ * @param[out] p_value Located value (slice of p_js).
+ *
+ * @return 0 if found, or JSON_PATH_ERR_ARG / _NOT_FOUND / _MALFORMED.
+ */
+int32_t
+json_path_find (char const * const p_js, uint32_t const len,
+                json_path_t const * const p_path,
+                json_value_t * const p_value)
+{
+    json_cursor_t cur;
+    uint32_t i;
+
+    if ((NULL == p_js) || (NULL == p_path) || (NULL == p_value))
+    {
+        return JSON_PATH_ERR_ARG;
+    }
+
+    cur.p_js = p_js;
+    cur.len = len;
+    cur.pos = 0u;
+
+    for (i = 0u; i < p_path->count; i++)
+    {
+        json_path_segment_t const * const p_seg = &p_path->segments[i];
+        int32_t result;
+
+        if (!json_path_skip_space(&cur))
+        {
+            return JSON_PATH_ERR_MALFORMED;
+        }
+
+        if (NULL != p_seg->p_key)
+        {
+            result = ('{' == p_js[cur.pos]) ?
+                     json_path_enter_member(&cur, p_seg) :
+                     JSON_PATH_ERR_NOT_FOUND;
+        }
+        else
+        {
+            result = ('[' == p_js[cur.pos]) ?
+                     json_path_enter_element(&cur, p_seg->index) :
+                     JSON_PATH_ERR_NOT_FOUND;
+        }
+
+        if (0 != result)
+        {
+            return result;
+        }
+    }
+
+    if (!json_path_skip_space(&cur))
+    {
+        return JSON_PATH_ERR_MALFORMED;
+    }
+
+    return json_path_take_value(&cur, p_value);
+}
+
+
+/*!
+ * @brief Find a value by path string (compile + find in one call).
+ *
+ * @return 0 if found, or JSON_PATH_ERR_ARG / _NOT_FOUND / _MALFORMED.
+ */
+int32_t
+json_find (char const * const p_js, uint32_t const len,
+           char const * const p_path, json_value_t * const p_value)
+{
+    json_path_t path;
+    int32_t const result = json_path_compile(p_path, &path);
+
+    if (result < 0)
+    {
+        return result;
+    }
+
+    return json_path_find(p_js, len, &path, p_value);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/*** end of file ***/
@@ -0,0 +1,70 @@
+/** @file jsonpath.h
+ *
+ * @brief Lazy JSON lookup: find one value by path without tokenizing.
+ *
+ * json_find(p_js, len, "groups[2]", &value) scans the text once and
+ * stops at the requested value. Members and elements that are not on
+ * the path are skipped by quote/bracket counting, so no jsmntok_t is
+ * ever allocated. For repeated lookups the path can be compiled once
+ * with json_path_compile() and reused with json_path_find().
+ *
+ * Path syntax: members joined by '.', array indices in brackets, e.g.
+ * "cfg.uart.baud", "groups[2]", "tags[1][0]". An empty path ("")
+ * selects the root value. Keys are compared byte-for-byte with the raw
+ * (still escaped) key text and may not contain '.' or '['.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#ifndef JSONPATH_H
+#define JSONPATH_H
+
+#include <stdint.h>
+#include "jsmn.h"
+
+/* Maximum segments in one path */
+#define JSON_PATH_MAX_SEGMENTS    8u
+
+/* Nesting limit while skipping a subtree */
+#define JSON_PATH_MAX_SKIP_DEPTH  32u
+
+/* Error codes */
+#define JSON_PATH_ERR_ARG         (-1)   /* NULL pointer or bad path syntax */
+#define JSON_PATH_ERR_NOT_FOUND   (-2)   /* Key/index absent or type mismatch */
+#define JSON_PATH_ERR_MALFORMED   (-3)   /* Document ends early or is invalid */
+
+/* One path step: a member name or an array index */
+typedef struct
+{
+    char const * p_key;        /* NULL for an index step */
+    uint32_t key_len;
+    uint32_t index;
+} json_path_segment_t;
+
+/* Compiled path (refers to the path string, which must stay valid) */
+typedef struct
+{
+    json_path_segment_t segments[JSON_PATH_MAX_SEGMENTS];
+    uint32_t count;
+} json_path_t;
+
+/* Located value: a slice of the document, jsmn conventions */
+typedef struct
+{
+    jsmntype_t type;
+    char const * p_start;      /* Strings: content without the quotes */
+    uint32_t len;              /* Objects/arrays: including the brackets */
+} json_value_t;
+
+/* Public API functions */
+int32_t json_path_compile(char const * const p_path, json_path_t * const p_out);
+int32_t json_path_find(char const * const p_js, uint32_t const len,
+                       json_path_t const * const p_path,
+                       json_value_t * const p_value);
+int32_t json_find(char const * const p_js, uint32_t const len,
+                  char const * const p_path, json_value_t * const p_value);
+
+#endif /* JSONPATH_H */
+
+/*** end of file ***/
@@ -2,8 +2,18 @@
  *
  * @brief JSON parsing and UART transmission using JSMN library (non-blocking).
  *
- * Parses embedded JSON string and transmits key-value pairs via UART
- * using non-blocking delays to prevent CPU freezing.
+ * Parses JSON and transmits key-value pairs via UART using non-blocking
+ * delays to prevent CPU freezing. With JSON_SOURCE_UART the input is a
+ * live pipeline: RX ring -> jsonstream (frame detect + jsmn_parse) ->
+ * one of two frame buffers -> key dispatch -> TX. One frame is answered
+ * while the next one is received. Tokens of every document in flight
+ * live in one token arena (tokarena.h), carved in exact sizes. Documents
+ * that match a message type in jsonschema.def are read by its generated
+ * parser instead and need no tokens at all. Output lines are
+ * queued as slice lists (emit.h): constant prefixes plus slices of the
+ * JSON source, with no formatting or copying on the way out. With
+ * JSON_OUTPUT_CBOR the same walk goes out as one CBOR map per message
+ * instead (cbor.h), built from the same kind of slices.
  *
  * @par
  * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
@@ -11,99 +21,1713 @@
 
 #include <stdint.h>
 #include <stddef.h>
-#include <stdio.h>
 #include <string.h>
 #include "jsmn.h"
+#include "types.h"
 #include "uart.h"
 #include "delay.h"
+#include "clock.h"
+#include "sched.h"
+#include "timer.h"
+#include "ratelimit.h"
+#include "emit.h"
+#include "cbor.h"
+#include "jsonstream.h"
+#include "tokarena.h"
+#include "jsonschema.h"
+#include "jsonschema_gen.h"
+#include "profile.h"
+#include "trace.h"
+#include "jsonwriter.h"
+#include "jsontok.h"
 #include "jsonprocess.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-/* Maximum tokens expected in JSON string */
-#define MAX_JSON_TOKENS         15u
+/* Received-message buffers: one is answered while the next fills */
+#define JSON_RX_FRAME_COUNT     2u
 
-/* Maximum buffer size for formatted output strings */
-#define OUTPUT_BUFFER_SIZE      200u
+/* Backpressure (UART_FLOW_RTS_CTS): hold the sender while the TX FIFO is
+ * three quarters full or the arena has no room for another full message,
+ * release once the FIFO is half empty and the arena has room again */
+#define JSON_HOLD_TX_FREE_BYTES     (UART_TX_FIFO_SIZE_BYTES / 4u)
+#define JSON_RELEASE_TX_FREE_BYTES  (UART_TX_FIFO_SIZE_BYTES / 2u)
+#define JSON_HOLD_ARENA_FREE        JSON_STREAM_MAX_TOKENS
 
-/* Delay between UART transmissions in milliseconds */
-#define TX_DELAY_MS             500u
+/* Token arena shared by all documents in flight (override with -D) */
+#ifndef JSON_TOKEN_ARENA_SIZE
+#if (JSON_SOURCE == JSON_SOURCE_UART)
+#define JSON_TOKEN_ARENA_SIZE   (JSON_RX_FRAME_COUNT * JSON_STREAM_MAX_TOKENS)
+#else
+#define JSON_TOKEN_ARENA_SIZE   32u
+#endif
+#endif
+
+/* Answer jsonschema.def messages from their generated parser, without
+ * tokens. Default for whole documents only: in UART mode jsonstream has
+ * already tokenized a message to frame it, so a second pass costs more
+ * than the walk it replaces (override with -DJSON_USE_SCHEMA=0/1) */
+#ifndef JSON_USE_SCHEMA
+#if (JSON_SOURCE == JSON_SOURCE_UART)
+#define JSON_USE_SCHEMA         0
+#else
+#define JSON_USE_SCHEMA         1
+#endif
+#endif
+
+/* Maximum object/array nesting depth tracked by the token walker */
+#define JSON_MAX_DEPTH          8u
+
+/* Error codes for JSON processing */
+#define JSON_ERR_PARSE_FAILED   1
+#define JSON_ERR_NO_OBJECT      2
+#define JSON_SUCCESS            0
+
+/* JSON processor state machine (order mirrored by PROFILE_JSON_* probes) */
+typedef enum {
+    JSON_STATE_IDLE = 0,
+    JSON_STATE_PARSING,
+    JSON_STATE_TRANSMITTING,
+    JSON_STATE_WAITING,
+    JSON_STATE_COMPLETE
+} json_state_t;
+
+/* Walk step result */
+typedef enum {
+    JSON_STEP_CONTINUE = 0,   /* Bookkeeping only - walk on next call */
+    JSON_STEP_EMITTED,        /* A line was queued - apply TX pacing */
+    JSON_STEP_BLOCKED,        /* TX queue full - retry same token */
+    JSON_STEP_DONE            /* All tokens visited */
+} json_step_t;
+
+/* Commands requested with the "cmd" key */
+typedef enum {
+    JSON_CMD_NONE = 0,
+    JSON_CMD_PROFILE,         /* Dump the cycle-count probe table */
+    JSON_CMD_TRACE,           /* Dump the event trace */
+    JSON_CMD_STATS            /* Dump the UART and message counters */
+} json_cmd_t;
+
+/* One level of the explicit traversal stack */
+typedef struct {
+    jsmntype_t type;          /* JSMN_OBJECT or JSMN_ARRAY */
+    int32_t remaining;        /* Keys / elements still to visit */
+} json_frame_t;
+
+/* Global state for non-blocking operation */
+static json_state_t g_json_state = JSON_STATE_IDLE;
+static int32_t g_current_token = 1;  /* Walk cursor into g_p_tokens */
+static json_frame_t g_stack[JSON_MAX_DEPTH];
+static uint32_t g_depth = 0u;
+static int32_t g_skip_pending = 0;   /* Tokens left in an ignored subtree */
+static uint32_t g_delay_start = 0;
+static timer_entry_t g_wake_timer;   /* Ends a pacing or rate-limit wait */
+static json_cmd_t g_pending_cmd = JSON_CMD_NONE;
+static bool_t g_b_json_blocked = FALSE; /* Last step waited on an event */
+
+/* Document being processed: source text and its tokens */
+static char const * g_p_json = NULL;
+static jsmntok_t const * g_p_tokens = NULL;
+static int32_t g_parse_result = 0;   /* Token count or negative parse error */
+
+/* Document read by a generated schema parser (NULL = use the tokens) */
+static json_msg_t const * g_p_msg = NULL;
+static uint32_t g_schema_member = 0u; /* Member cursor into g_p_msg */
+static uint32_t g_schema_item = 0u;  /* 0 = key line next, n = element n-1 */
+
+/* Tokens of every document in flight, carved per message in exact sizes */
+NOINIT static jsmntok_t g_arena_tokens[JSON_TOKEN_ARENA_SIZE];
+static tok_arena_t g_arena;
+
+/* Output pacing policy (see json_set_pacing_*()) */
+static json_pacing_t g_pacing = JSON_PACING_DEFAULT;
+static uint32_t g_tx_delay_ms = JSON_DEFAULT_TX_DELAY_MS;
+static json_rate_unit_t g_rate_unit = JSON_RATE_BYTES_PER_SEC;
+static ratelimit_t g_rate_limit;
+static bool_t g_b_rate_charged = FALSE;     /* Message already paid for */
+
+/* Output batching (see json_set_batching()) */
+static uint32_t g_batch_max_bytes = 0u;     /* 0 = every line sent at once */
+static uint32_t g_batch_max_delay_ms = 0u;  /* 0 = flush at message end */
+static bool_t g_b_batch_open = FALSE;
+static uint32_t g_batch_bytes = 0u;         /* Line bytes in the open batch */
+static uint32_t g_batch_start = 0u;
+static timer_entry_t g_batch_timer;         /* Ends a batch held for more */
+
+/* Output encoding (see json_set_output()), latched per message */
+static json_output_t g_output = JSON_OUTPUT_DEFAULT;
+static json_output_t g_walk_output = JSON_OUTPUT_DEFAULT;
+static bool_t g_b_cbor_head = FALSE; /* Root map head not yet queued */
+
+/* Message counters (see json_get_stats()) and the {"cmd": "stats"} dump */
+#define JSON_STATS_LINE_COUNT   4u
+#define JSON_STATS_LINE_SIZE    192u  /* Longest line ("peaks", 7 numbers) */
+
+static json_stats_t g_stats;
+static uart_stats_t g_stats_uart_snap;      /* Copied when a dump starts */
+static json_stats_t g_stats_json_snap;
+static uint32_t g_stats_dump_next = 0u;     /* Dump resume point */
+
+/* Interrupt Enable Number */
+#define USART2_IRQn 28u
+
+#ifndef HOST_BUILD
+/* Inline functions for interrupt control */
+static inline void __enable_irq(void) {
+    __asm volatile ("cpsie i" : : : "memory");
+}
+
+static inline void NVIC_EnableIRQ(uint32_t IRQn) {
+    volatile uint32_t *NVIC_ISER0 = (volatile uint32_t *)0xE000E100;
+    NVIC_ISER0[IRQn >> 5] = (1u << (IRQn & 0x1F));
+}
+#else
+/* Host benchmark build (bench.c): no interrupt controller */
+static inline void __enable_irq(void) {
+}
+
+static inline void NVIC_EnableIRQ(uint32_t IRQn) {
+    (void)IRQn;
+}
+#endif
+
+#if (JSON_SOURCE == JSON_SOURCE_BUILTIN)
+/* Hardcoded JSON test string */
+static char const JSON_STRING[] =
+    "{\"user\": \"johndoe\", \"admin\": false, \"uid\": 1000,\n  "
+    "\"groups\": [\"users\", \"wheel\", \"audio\", \"video\"]}";
+
+#if (JSON_USE_SCHEMA)
+static json_msg_t g_builtin_msg;
+#endif
+#else
+/* Received frame lifecycle */
+typedef enum {
+    JSON_RX_FREE = 0,         /* Available to the stream callback */
+    JSON_RX_READY,            /* Holds a message waiting to be answered */
+    JSON_RX_ACTIVE,           /* Being walked; TX slices point into it */
+    JSON_RX_DRAINING          /* Fully queued, waiting for TX to finish */
+} json_rx_state_t;
+
+/* One received message: text plus its token block in g_arena, or its
+ * schema struct when a generated parser recognised it */
+typedef struct {
+    char text[JSON_STREAM_BUFFER_SIZE];
+#if (JSON_USE_SCHEMA)
+    json_msg_t msg;           /* msg.id == JSON_MSG_NONE: use p_tokens */
+#endif
+    jsmntok_t const * p_tokens;
+    int32_t num_tokens;       /* Token count or negative parse error */
+    uint32_t tok_mark;        /* tok_arena_mark() after the block */
+    uint32_t tx_mark;         /* uart_tx_mark() once fully queued */
+    json_rx_state_t state;
+} json_rx_frame_t;
+
+static json_stream_t g_stream;
+NOINIT static json_rx_frame_t g_rx_frames[JSON_RX_FRAME_COUNT];
+static uint32_t g_rx_fill = 0u;      /* Next frame the callback fills */
+static uint32_t g_rx_serve = 0u;     /* Next frame to answer */
+static uint32_t g_rx_drain = 0u;     /* Oldest frame still to be freed */
+static json_rx_frame_t * g_p_rx_active = NULL;
+static bool_t g_b_rx_held = FALSE;   /* Sender held by json_rx_backpressure() */
+#endif
+
+
+/* Root-key dispatch entry (table generated from jsonkeys.def) */
+typedef struct json_key json_key_t;
+
+typedef jsmntok_t const * (*json_key_handler_t)(emit_t * const p_emit,
+                                                json_key_t const * const p_key,
+                                                jsmntok_t const * const p_val);
+
+struct json_key {
+    char const * p_name;          /* JSON key text (NULL = empty slot) */
+    uint32_t name_len;            /* strlen(p_name), precomputed */
+    char const * p_prefix;        /* Output prefix, "- Label: " */
+    uint32_t prefix_len;          /* strlen(p_prefix), precomputed */
+    json_key_handler_t handler;   /* Emits the line, returns subtree to walk */
+};
+
+static jsmntok_t const * json_key_scalar(emit_t * const p_emit,
+                                         json_key_t const * const p_key,
+                                         jsmntok_t const * const p_val);
+static jsmntok_t const * json_key_int32(emit_t * const p_emit,
+                                        json_key_t const * const p_key,
+                                        jsmntok_t const * const p_val);
+static jsmntok_t const * json_key_bool(emit_t * const p_emit,
+                                       json_key_t const * const p_key,
+                                       jsmntok_t const * const p_val);
+static jsmntok_t const * json_key_array(emit_t * const p_emit,
+                                        json_key_t const * const p_key,
+                                        jsmntok_t const * const p_val);
+static jsmntok_t const * json_key_command(emit_t * const p_emit,
+                                          json_key_t const * const p_key,
+                                          jsmntok_t const * const p_val);
+
+#include "jsonkeys_table.h"
+
+
+/*!
+ * @brief Append the source text of a token to the line (no copy).
+ */
+static void
+json_emit_token (emit_t * const p_emit, jsmntok_t const * const p_tok)
+{
+    emit_slice(p_emit, g_p_json + p_tok->start,
+               (uint32_t)(p_tok->end - p_tok->start));
+}
+
+
+/*!
+ * @brief Emit a root key with a scalar value: "- Label: value".
+ */
+static jsmntok_t const *
+json_key_scalar (emit_t * const p_emit, json_key_t const * const p_key,
+                 jsmntok_t const * const p_val)
+{
+    emit_slice(p_emit, p_key->p_prefix, p_key->prefix_len);
+    json_emit_token(p_emit, p_val);
+    EMIT_LITERAL(p_emit, "\r\n");
+
+    return NULL;
+}
+
+
+/*!
+ * @brief Emit a typed scalar, noting a value that failed to decode.
+ *
+ * A value of the wrong type or range is still echoed, followed by
+ * " (expected <what>)", so the line shows both what arrived and why it
+ * was not accepted.
+ */
+static jsmntok_t const *
+json_key_typed (emit_t * const p_emit, json_key_t const * const p_key,
+                jsmntok_t const * const p_val, int32_t const result,
+                char const * const p_expected)
+{
+    emit_slice(p_emit, p_key->p_prefix, p_key->prefix_len);
+    json_emit_token(p_emit, p_val);
+
+    if (JSON_TOK_OK != result)
+    {
+        EMIT_LITERAL(p_emit, " (expected ");
+        emit_str(p_emit, p_expected);
+        EMIT_LITERAL(p_emit, ")");
+    }
+
+    EMIT_LITERAL(p_emit, "\r\n");
+
+    return NULL;
+}
+
+
+/*!
+ * @brief Emit a root key whose value must be an int32 integer.
+ */
+static jsmntok_t const *
+json_key_int32 (emit_t * const p_emit, json_key_t const * const p_key,
+                jsmntok_t const * const p_val)
+{
+    int32_t value;
+
+    return json_key_typed(p_emit, p_key, p_val,
+                          json_tok_to_i32(g_p_json, p_val, &value), "int32");
+}
+
+
+/*!
+ * @brief Emit a root key whose value must be true or false.
+ */
+static jsmntok_t const *
+json_key_bool (emit_t * const p_emit, json_key_t const * const p_key,
+               jsmntok_t const * const p_val)
+{
+    bool_t value;
+
+    return json_key_typed(p_emit, p_key, p_val,
+                          json_tok_to_bool(g_p_json, p_val, &value), "bool");
+}
+
+
+/*!
+ * @brief Emit a root key holding a list: "- Label:" then its elements.
+ *
+ * Only an array is walked; anything else is skipped.
+ */
+static jsmntok_t const *
+json_key_array (emit_t * const p_emit, json_key_t const * const p_key,
+                jsmntok_t const * const p_val)
+{
+    /* Prefix without its trailing space */
+    emit_slice(p_emit, p_key->p_prefix, p_key->prefix_len - 1u);
+    EMIT_LITERAL(p_emit, "\r\n");
+
+    return (JSMN_ARRAY == p_val->type) ? p_val : NULL;
+}
+
+
+/*!
+ * @brief Count one answered message by how it was read.
+ *
+ * @param[in] parse_result Token count, or a negative parse error code.
+ * @param[in] b_object     FALSE if the document is not a JSON object.
+ */
+static void
+json_stats_note (int32_t const parse_result, bool_t const b_object)
+{
+    g_stats.messages++;
+
+    switch (parse_result)
+    {
+        case JSMN_ERROR_NOMEM:          g_stats.parse_nomem++; break;
+        case JSMN_ERROR_INVAL:          g_stats.parse_inval++; break;
+        case JSMN_ERROR_PART:           g_stats.parse_part++;  break;
+        case JSON_STREAM_ERR_OVERFLOW:  g_stats.too_long++;    break;
+        case JSON_STREAM_ERR_FRAME:     g_stats.bad_frame++;   break;
+        default:
+        {
+            if (FALSE == b_object)
+            {
+                g_stats.not_object++;
+            }
+            break;
+        }
+    }
+}
+
+
+/*!
+ * @brief Write one stats line: {"stats":"<group>","<name>":<value>,...}.
+ */
+static void
+json_stats_write (json_writer_t * const p_writer, char const * const p_group,
+                  char const * const * const p_names,
+                  uint32_t const * const p_values, uint32_t const count)
+{
+    uint32_t i;
+
+    json_writer_begin_object(p_writer);
+    json_writer_key(p_writer, "stats");
+    json_writer_string(p_writer, p_group, (uint32_t)strlen(p_group));
+
+    for (i = 0u; i < count; i++)
+    {
+        json_writer_key(p_writer, p_names[i]);
+        json_writer_uint32(p_writer, p_values[i]);
+    }
+
+    json_writer_end_object(p_writer);
+}
+
+
+/*!
+ * @brief Queue the UART and message counters, one JSON object per line.
+ *
+ * All lines report one snapshot, taken when the dump starts. Resumable:
+ * if the TX queue fills up part way, call again later and the dump
+ * continues with the next line.
+ *
+ * @return 0 when every line is queued, -2 if it must be called again.
+ */
+static int32_t
+json_stats_dump (void)
+{
+    static char const * const uart_names[] =
+        { "tx_bytes", "rx_bytes", "rx_frames", "rx_dropped", "rx_frames_dropped" };
+    static char const * const error_names[] =
+        { "overrun", "framing", "parity", "noise" };
+    static char const * const peak_names[] =
+        { "rx_ring", "rx_ring_size", "tx_fifo", "tx_fifo_size",
+          "tx_desc", "tx_desc_count", "isr_max_cycles" };
+    static char const * const json_names[] =
+        { "messages", "nomem", "inval", "part", "too_long", "bad_frame",
+          "not_object" };
+    json_writer_t writer;
+    uart_stats_t const * const p_uart = &g_stats_uart_snap;
+    json_stats_t const * const p_json = &g_stats_json_snap;
+
+    if (0u == g_stats_dump_next)
+    {
+        uart_get_stats(&g_stats_uart_snap);
+        g_stats_json_snap = g_stats;
+    }
+
+    while (g_stats_dump_next < JSON_STATS_LINE_COUNT)
+    {
+        /* Whole lines only: a chunk that did not fit would cut one short */
+        if (FALSE == json_writer_uart_fits(JSON_STATS_LINE_SIZE))
+        {
+            return -2;
+        }
+
+        json_writer_init(&writer, json_writer_uart_sink, NULL);
+
+        if (0u == g_stats_dump_next)
+        {
+            uint32_t const values[] =
+                { p_uart->tx_bytes, p_uart->rx_bytes, p_uart->rx_frames,
+                  p_uart->rx_dropped, p_uart->rx_frames_dropped };
+
+            json_stats_write(&writer, "uart", uart_names, values, 5u);
+        }
+        else if (1u == g_stats_dump_next)
+        {
+            json_stats_write(&writer, "uart_errors", error_names,
+                             &p_uart->errors[UART_ERROR_OVERRUN], 4u);
+        }
+        else if (2u == g_stats_dump_next)
+        {
+            uint32_t const values[] =
+                { p_uart->rx_peak, UART_RX_RING_SIZE_BYTES,
+                  p_uart->tx_peak, UART_TX_FIFO_SIZE_BYTES,
+                  p_uart->tx_desc_peak, UART_TX_DESC_COUNT,
+                  p_uart->isr_max_cycles };
+
+            json_stats_write(&writer, "peaks", peak_names, values, 7u);
+        }
+        else
+        {
+            uint32_t const values[] =
+                { p_json->messages, p_json->parse_nomem, p_json->parse_inval,
+                  p_json->parse_part, p_json->too_long, p_json->bad_frame,
+                  p_json->not_object };
+
+            json_stats_write(&writer, "json", json_names, values, 7u);
+        }
+
+        if (0 != json_writer_finish(&writer))
+        {
+            return -2;
+        }
+
+        g_stats_dump_next++;
+    }
+
+    g_stats_dump_next = 0u;
+
+    return 0;
+}
+
+
+/*!
+ * @brief Remember the command named by a "cmd" value, if it is known.
+ *
+ * The command itself runs from JSON_STATE_COMPLETE, after the answer to
+ * the message is queued, so its output follows the echoed line.
+ */
+static void
+json_check_command (jsmntok_t const * const p_val)
+{
+    static char const cmd_profile[] = "profile";
+    static char const cmd_trace[] = "trace";
+    static char const cmd_stats[] = "stats";
+    uint32_t len = (uint32_t)(p_val->end - p_val->start);
+
+    if (JSMN_STRING != p_val->type)
+    {
+        return;
+    }
+
+    if (((sizeof(cmd_profile) - 1u) == len) &&
+        (0 == memcmp(g_p_json + p_val->start, cmd_profile, len)))
+    {
+        g_pending_cmd = JSON_CMD_PROFILE;
+    }
+    else if (((sizeof(cmd_trace) - 1u) == len) &&
+             (0 == memcmp(g_p_json + p_val->start, cmd_trace, len)))
+    {
+        g_pending_cmd = JSON_CMD_TRACE;
+    }
+    else if (((sizeof(cmd_stats) - 1u) == len) &&
+             (0 == memcmp(g_p_json + p_val->start, cmd_stats, len)))
+    {
+        g_pending_cmd = JSON_CMD_STATS;
+    }
+    else
+    {
+        /* Unknown command: echoed only */
+    }
+}
+
+
+/*!
+ * @brief Emit a "cmd" key like a scalar and remember the command.
+ */
+static jsmntok_t const *
+json_key_command (emit_t * const p_emit, json_key_t const * const p_key,
+                  jsmntok_t const * const p_val)
+{
+    (void)json_key_scalar(p_emit, p_key, p_val);
+    json_check_command(p_val);
+
+    return NULL;
+}
+
+
+/*!
+ * @brief Run the command requested by the last message, if any.
+ *
+ * In UART_FRAMING_SLIP this also closes the frame, so the answer and
+ * any command output travel as one frame.
+ *
+ * @return 0 when done (or nothing to do), -2 to call again (TX queue full).
+ */
+static int32_t
+json_run_command (void)
+{
+    int32_t result = 0;
+
+    if (JSON_CMD_PROFILE == g_pending_cmd)
+    {
+        result = profile_dump();
+    }
+    else if (JSON_CMD_TRACE == g_pending_cmd)
+    {
+        result = trace_dump();
+    }
+    else if (JSON_CMD_STATS == g_pending_cmd)
+    {
+        result = json_stats_dump();
+    }
+    else
+    {
+        /* No command pending */
+    }
+
+    if (0 == result)
+    {
+        g_pending_cmd = JSON_CMD_NONE;
+        result = uart_frame_end();
+    }
+
+    return result;
+}
+
+
+/*!
+ * @brief Look up a key in the generated dispatch table.
+ *
+ * One hash of (length, first byte, last byte) selects the only candidate
+ * slot; a single memcmp() then rejects keys that are not in the table.
+ *
+ * @return Table entry, or NULL if the key is unknown.
+ */
+static json_key_t const *
+json_key_lookup (char const * const p_text, uint32_t const len)
+{
+    json_key_t const * p_entry;
+    uint32_t slot;
+
+    if (0u == len)
+    {
+        return NULL;
+    }
+
+    slot = ((len * JSON_KEY_HASH_MUL_LEN) +
+            ((uint32_t)(uint8_t)p_text[0] * JSON_KEY_HASH_MUL_FIRST) +
+            ((uint32_t)(uint8_t)p_text[len - 1u] * JSON_KEY_HASH_MUL_LAST)) &
+           JSON_KEY_HASH_MASK;
+    p_entry = &g_key_table[slot];
+
+    if ((len != p_entry->name_len) ||
+        (0 != memcmp(p_entry->p_name, p_text, len)))
+    {
+        return NULL;
+    }
+
+    return p_entry;
+}
+
+
+/*!
+ * @brief Text for a (negative) jsmn_parse() result, without printf.
+ */
+static char const *
+json_error_text (int32_t const code)
+{
+    static char const * const error_text[] = { "-1", "-2", "-3" };
+
+    if ((code < 0) && (code >= -3))
+    {
+        return error_text[(uint32_t)(-code) - 1u];
+    }
+
+    if (JSON_STREAM_ERR_OVERFLOW == code)
+    {
+        return "message too long";
+    }
+
+    if (JSON_STREAM_ERR_FRAME == code)
+    {
+        return "incomplete frame";
+    }
+
+    return "?";
+}
+
+
+static void json_wake_parse(void * p_ctx);
+
+
+/*!
+ * @brief Send the open output batch (no-op if none is open).
+ */
+static void
+json_batch_flush (void)
+{
+    if (g_b_batch_open)
+    {
+        timer_stop(&g_batch_timer);
+        g_b_batch_open = FALSE;
+        uart_tx_batch_flush();
+    }
+}
+
+
+/*!
+ * @brief Copy a line into the output batch, opening one if needed.
+ *
+ * The batch is flushed once it holds g_batch_max_bytes, and at once if
+ * the line does not fit: the TX queue only drains after a flush.
+ *
+ * @return As emit_commit_copy().
+ */
+static int32_t
+json_batch_send (emit_t * const p_emit)
+{
+    int32_t result;
+
+    if (FALSE == g_b_batch_open)
+    {
+        uart_tx_batch_begin();
+        g_b_batch_open = TRUE;
+        g_batch_bytes = 0u;
+        g_batch_start = delay_start();
+
+        if (0u != g_batch_max_delay_ms)
+        {
+            (void)timer_start(&g_batch_timer, g_batch_max_delay_ms,
+                              json_wake_parse, NULL);
+        }
+    }
+
+    result = emit_commit_copy(p_emit);
+
+    if (0 == result)
+    {
+        g_batch_bytes += p_emit->bytes;
+    }
+
+    if ((0 != result) || (g_batch_bytes >= g_batch_max_bytes))
+    {
+        json_batch_flush();
+    }
+
+    return result;
+}
+
+
+/*!
+ * @brief Queue an emitted line on the UART TX queue, subject to pacing.
+ *
+ * In rate-limited mode the line is only queued once the token bucket
+ * holds enough credit: its length in bytes/s mode, or one unit for the
+ * first line of a message in messages/s mode. Queue space is checked
+ * first so credit is never spent on a line that cannot be sent. With batching on the line is
+ * copied into the open batch instead of queued as slices.
+ *
+ * @return 0 if queued, -2 if the TX queue or rate limit has no room yet
+ *         (retry later).
+ */
+static int32_t
+json_send (emit_t * const p_emit)
+{
+    if (JSON_PACING_RATE_LIMITED == g_pacing)
+    {
+        if (uart_tx_slots_free() < p_emit->count)
+        {
+            return -2;
+        }
+
+        if (JSON_RATE_BYTES_PER_SEC == g_rate_unit)
+        {
+            if (0u == ratelimit_consume(&g_rate_limit, p_emit->bytes))
+            {
+                return -2;
+            }
+        }
+        else if (FALSE == g_b_rate_charged)
+        {
+            if (0u == ratelimit_consume(&g_rate_limit, 1u))
+            {
+                return -2;
+            }
+            g_b_rate_charged = TRUE;
+        }
+    }
+
+    if (0u != g_batch_max_bytes)
+    {
+        return json_batch_send(p_emit);
+    }
+
+    return emit_commit(p_emit);
+}
+
+
+/*!
+ * @brief Queue an error notice in the current output encoding.
+ *
+ * Text: "<label><detail>" as one line. CBOR: a one-member map
+ * {"error": "<label><detail>"}.
+ *
+ * @return As json_send().
+ */
+static int32_t
+json_send_error (emit_t * const p_emit, char const * const p_label,
+                 char const * const p_detail)
+{
+    uint32_t const label_len = (uint32_t)strlen(p_label);
+    uint32_t const detail_len = (uint32_t)strlen(p_detail);
+
+    emit_begin(p_emit);
+
+    if (JSON_OUTPUT_CBOR == g_output)
+    {
+        cbor_head(p_emit, CBOR_MAJOR_MAP, 1u);
+        cbor_text(p_emit, "error", 5u);
+        cbor_head(p_emit, CBOR_MAJOR_TEXT, label_len + detail_len);
+        emit_slice(p_emit, p_label, label_len);
+        emit_slice(p_emit, p_detail, detail_len);
+    }
+    else
+    {
+        emit_slice(p_emit, p_label, label_len);
+        emit_slice(p_emit, p_detail, detail_len);
+        EMIT_LITERAL(p_emit, "\r\n");
+    }
+
+    return json_send(p_emit);
+}
+
+
+/*!
+ * @brief Reset the token walker to the first key of the root object.
+ *
+ * Also latches the output encoding for the message about to be walked.
+ */
+static void
+json_walk_reset (void)
+{
+    g_walk_output = g_output;
+    g_b_cbor_head = (JSON_OUTPUT_CBOR == g_output) ? TRUE : FALSE;
+    g_schema_member = 0u;
+    g_schema_item = 0u;
+    g_current_token = 1;
+    g_skip_pending = 0;
+    g_depth = 1u;
+    g_stack[0].type = JSMN_OBJECT;
+    g_stack[0].remaining = ((NULL == g_p_msg) && (g_parse_result > 0)) ?
+                           g_p_tokens[0].size : 0;
+}
+
+
+/*!
+ * @brief Enter a container value: push a frame, or skip it if too deep.
+ */
+static void
+json_walk_enter (jsmntok_t const * const p_tok)
+{
+    if (g_depth < JSON_MAX_DEPTH)
+    {
+        g_stack[g_depth].type = p_tok->type;
+        g_stack[g_depth].remaining = p_tok->size;
+        g_depth++;
+        g_current_token++;
+    }
+    else
+    {
+        g_skip_pending = 1;
+    }
+}
+
+
+/*!
+ * @brief Build the line for one key (object member) of the walk.
+ *
+ * Root keys are dispatched through g_key_table (see jsonkeys.def); keys
+ * of nested objects are printed generically, indented by depth.
+ *
+ * @return Pointer to the value token to descend into, or NULL if the
+ *         value was printed inline (or is to be skipped).
+ */
+static jsmntok_t const *
+json_format_member (emit_t * const p_emit, jsmntok_t const * const p_key,
+                    jsmntok_t const * const p_val, uint32_t const indent)
+{
+    bool_t b_container = ((JSMN_OBJECT == p_val->type) ||
+                          (JSMN_ARRAY == p_val->type));
+    jsmntok_t const * p_descend = NULL;
+
+    emit_begin(p_emit);
+
+    if (1u != g_depth)
+    {
+        emit_indent(p_emit, indent);
+        EMIT_LITERAL(p_emit, "- ");
+        json_emit_token(p_emit, p_key);
+
+        if (b_container)
+        {
+            EMIT_LITERAL(p_emit, ":\r\n");
+            p_descend = p_val;
+        }
+        else
+        {
+            EMIT_LITERAL(p_emit, ": ");
+            json_emit_token(p_emit, p_val);
+            EMIT_LITERAL(p_emit, "\r\n");
+        }
+    }
+    else
+    {
+        json_key_t const * p_entry = (JSMN_STRING != p_key->type) ? NULL :
+            json_key_lookup(g_p_json + p_key->start,
+                            (uint32_t)(p_key->end - p_key->start));
+
+        if (NULL != p_entry)
+        {
+            p_descend = p_entry->handler(p_emit, p_entry, p_val);
+        }
+        else
+        {
+            EMIT_LITERAL(p_emit, "Unexpected key: ");
+            json_emit_token(p_emit, p_key);
+            EMIT_LITERAL(p_emit, "\r\n");
+        }
+    }
+
+    return p_descend;
+}
+
+
+/*!
+ * @brief Advance the token walk by one bounded step.
+ *
+ * Uses the explicit cursor (g_current_token) and frame stack (g_stack)
+ * so arrays and nested objects are emitted one line per call instead
+ * of in a blocking loop. Each call visits at most two tokens.
+ *
+ * @param[out] p_emit Emitter used to build the line.
+ *
+ * @return Step result telling the state machine what to do next.
+ */
+static json_step_t
+json_walk_step (emit_t * const p_emit)
+{
+    json_frame_t * p_top;
+    jsmntok_t const * p_tok;
+    uint32_t indent;
+
+    if (g_current_token >= g_parse_result)
+    {
+        return JSON_STEP_DONE;
+    }
+
+    p_tok = &g_p_tokens[g_current_token];
+
+    /* Skipping an ignored subtree: one token per call, no output */
+    if (g_skip_pending > 0)
+    {
+        g_skip_pending += p_tok->size - 1;
+        g_current_token++;
+        return JSON_STEP_CONTINUE;
+    }
+
+    if (0u == g_depth)
+    {
+        return JSON_STEP_DONE;
+    }
+
+    p_top = &g_stack[g_depth - 1u];
+
+    /* Current container finished - pop back to its parent */
+    if (p_top->remaining <= 0)
+    {
+        g_depth--;
+        return (0u == g_depth) ? JSON_STEP_DONE : JSON_STEP_CONTINUE;
+    }
+
+    indent = 2u * (g_depth - 1u);
+
+    if (JSMN_ARRAY == p_top->type)
+    {
+        if ((JSMN_OBJECT == p_tok->type) || (JSMN_ARRAY == p_tok->type))
+        {
+            p_top->remaining--;
+            json_walk_enter(p_tok);
+            return JSON_STEP_CONTINUE;
+        }
+
+        emit_begin(p_emit);
+        emit_indent(p_emit, indent);
+        EMIT_LITERAL(p_emit, "* ");
+        json_emit_token(p_emit, p_tok);
+        EMIT_LITERAL(p_emit, "\r\n");
+
+        if (0 != json_send(p_emit))
+        {
+            return JSON_STEP_BLOCKED;
+        }
+
+        p_top->remaining--;
+        g_current_token++;
+        return JSON_STEP_EMITTED;
+    }
+    else
+    {
+        jsmntok_t const * p_val;
+        jsmntok_t const * p_descend;
+
+        if ((g_current_token + 1) >= g_parse_result)
+        {
+            return JSON_STEP_DONE;
+        }
+
+        p_val = &g_p_tokens[g_current_token + 1];
+        p_descend = json_format_member(p_emit, p_tok, p_val, indent);
+
+        if (0 != json_send(p_emit))
+        {
+            return JSON_STEP_BLOCKED;
+        }
+
+        p_top->remaining--;
+        g_current_token++;
+
+        if (NULL != p_descend)
+        {
+            json_walk_enter(p_descend);
+        }
+        else if ((JSMN_OBJECT == p_val->type) || (JSMN_ARRAY == p_val->type))
+        {
+            g_skip_pending = 1;
+        }
+        else
+        {
+            g_current_token++;
+        }
+
+        return JSON_STEP_EMITTED;
+    }
+}
+
+
+/*!
+ * @brief Describe a schema field's value as the jsmn token it replaces.
+ *
+ * Lets the root-key handlers from jsonkeys.def answer a schema message
+ * exactly as they answer a tokenized one.
+ */
+static void
+json_schema_token (json_field_view_t const * const p_view,
+                   jsmntok_t * const p_tok)
+{
+    uint32_t const start = (uint32_t)(p_view->value.p_start - g_p_json);
+
+    switch (p_view->type)
+    {
+        case JSON_FIELD_STRING:
+        {
+            p_tok->type = JSMN_STRING;
+            break;
+        }
+
+        case JSON_FIELD_STRING_ARRAY:
+        {
+            p_tok->type = JSMN_ARRAY;
+            break;
+        }
+
+        default:
+        {
+            p_tok->type = JSMN_PRIMITIVE;
+            break;
+        }
+    }
+
+    p_tok->start = (jsmnidx_t)start;
+    p_tok->end = (jsmnidx_t)(start + p_view->value.len);
+    p_tok->size = (jsmnidx_t)p_view->item_count;
+#ifdef JSMN_PARENT_LINKS
+    p_tok->parent = JSMN_NONE;
+#endif
+}
+
+
+/*!
+ * @brief Advance the answer to a schema message by one bounded step.
+ *
+ * Members are answered in document order, one line per call: the root
+ * key through g_key_table, then one line per array element.
+ *
+ * @return Step result, as json_walk_step().
+ */
+static json_step_t
+json_schema_step (emit_t * const p_emit)
+{
+    json_field_view_t view;
+
+    if (0 != json_msg_field(g_p_msg, json_msg_order(g_p_msg, g_schema_member),
+                            &view))
+    {
+        /* Past the last member */
+        return JSON_STEP_DONE;
+    }
+
+    emit_begin(p_emit);
+
+    if (0u == g_schema_item)
+    {
+        json_key_t const * p_entry = json_key_lookup(view.p_key, view.key_len);
+        jsmntok_t const * p_descend = NULL;
+        jsmntok_t value;
+
+        json_schema_token(&view, &value);
+
+        if (NULL != p_entry)
+        {
+            p_descend = p_entry->handler(p_emit, p_entry, &value);
+        }
+        else
+        {
+            EMIT_LITERAL(p_emit, "Unexpected key: ");
+            emit_slice(p_emit, view.p_key, view.key_len);
+            EMIT_LITERAL(p_emit, "\r\n");
+        }
+
+        if (0 != json_send(p_emit))
+        {
+            return JSON_STEP_BLOCKED;
+        }
+
+        if ((NULL != p_descend) && (0u != view.item_count))
+        {
+            g_schema_item = 1u;
+        }
+        else
+        {
+            g_schema_member++;
+        }
+
+        return JSON_STEP_EMITTED;
+    }
+
+    /* Array element, indented like the token walker's depth-2 lines */
+    emit_indent(p_emit, 2u);
+    EMIT_LITERAL(p_emit, "* ");
+    emit_slice(p_emit, view.p_items[g_schema_item - 1u].p_start,
+               view.p_items[g_schema_item - 1u].len);
+    EMIT_LITERAL(p_emit, "\r\n");
+
+    if (0 != json_send(p_emit))
+    {
+        return JSON_STEP_BLOCKED;
+    }
+
+    if (g_schema_item < view.item_count)
+    {
+        g_schema_item++;
+    }
+    else
+    {
+        g_schema_item = 0u;
+        g_schema_member++;
+    }
+
+    return JSON_STEP_EMITTED;
+}
+
+
+/*!
+ * @brief Start a CBOR step: the root map head rides on the first item.
+ *
+ * @param[out] p_emit Emitter used to build the step's bytes.
+ * @param[in] members Member count of the root map.
+ */
+static void
+json_cbor_begin (emit_t * const p_emit, uint32_t const members)
+{
+    emit_begin(p_emit);
+
+    if (g_b_cbor_head)
+    {
+        cbor_head(p_emit, CBOR_MAJOR_MAP, members);
+    }
+}
+
+
+/*!
+ * @brief Queue a CBOR step, recording that the root map head is out.
+ *
+ * @return As json_send().
+ */
+static int32_t
+json_cbor_send (emit_t * const p_emit)
+{
+    if (0 != json_send(p_emit))
+    {
+        return -2;
+    }
+
+    g_b_cbor_head = FALSE;
+
+    return 0;
+}
+
+
+/*!
+ * @brief End a CBOR message, sending the root map head if no member did.
+ */
+static json_step_t
+json_cbor_done (emit_t * const p_emit)
+{
+    if (g_b_cbor_head && (0 != json_cbor_send(p_emit)))
+    {
+        return JSON_STEP_BLOCKED;
+    }
+
+    return JSON_STEP_DONE;
+}
+
+
+/*!
+ * @brief Append the CBOR item for a value token.
+ *
+ * Containers only get their head (definite length from the token size);
+ * their contents follow in later steps. A container too deep for
+ * g_stack is sent as null, matching json_walk_enter() skipping it.
+ */
+static void
+json_cbor_value (emit_t * const p_emit, jsmntok_t const * const p_tok)
+{
+    char const * const p_text = g_p_json + p_tok->start;
+    uint32_t const len = (uint32_t)(p_tok->end - p_tok->start);
+
+    switch (p_tok->type)
+    {
+        case JSMN_STRING:
+        {
+            cbor_text(p_emit, p_text, len);
+            break;
+        }
+
+        case JSMN_PRIMITIVE:
+        {
+            cbor_primitive(p_emit, p_text, len);
+            break;
+        }
+
+        case JSMN_OBJECT:
+        case JSMN_ARRAY:
+        {
+            if (g_depth < JSON_MAX_DEPTH)
+            {
+                cbor_head(p_emit, (JSMN_OBJECT == p_tok->type) ?
+                          CBOR_MAJOR_MAP : CBOR_MAJOR_ARRAY,
+                          (uint32_t)p_tok->size);
+            }
+            else
+            {
+                cbor_simple(p_emit, CBOR_NULL);
+            }
+            break;
+        }
+
+        default:
+        {
+            cbor_simple(p_emit, CBOR_NULL);
+            break;
+        }
+    }
+}
+
+
+/*!
+ * @brief Advance the CBOR encoding of the token walk by one bounded step.
+ *
+ * Same cursor and frame stack as json_walk_step(), but every member is
+ * encoded as it is (JSON keys, no labels, nothing dropped) so the map
+ * and array counts stay exact. Root keys are still looked up, only so
+ * that a "cmd" runs its command. One item (plus its key) per call.
+ *
+ * @return Step result, as json_walk_step().
+ */
+static json_step_t
+json_cbor_walk_step (emit_t * const p_emit)
+{
+    json_frame_t * p_top;
+    jsmntok_t const * p_tok;
+    jsmntok_t const * p_val;
+
+    json_cbor_begin(p_emit, (uint32_t)g_p_tokens[0].size);
+
+    /* Finished containers need no closing byte - just pop them */
+    while ((g_depth > 0u) && (g_stack[g_depth - 1u].remaining <= 0))
+    {
+        g_depth--;
+    }
+
+    if ((0u == g_depth) || (g_current_token >= g_parse_result))
+    {
+        return json_cbor_done(p_emit);
+    }
+
+    p_tok = &g_p_tokens[g_current_token];
+
+    /* Skipping a subtree sent as null: one token per call, no output */
+    if (g_skip_pending > 0)
+    {
+        g_skip_pending += p_tok->size - 1;
+        g_current_token++;
+        return JSON_STEP_CONTINUE;
+    }
+
+    p_top = &g_stack[g_depth - 1u];
+    p_val = p_tok;
+
+    if (JSMN_OBJECT == p_top->type)
+    {
+        if ((g_current_token + 1) >= g_parse_result)
+        {
+            return json_cbor_done(p_emit);
+        }
+
+        p_val = &g_p_tokens[g_current_token + 1];
+        cbor_text(p_emit, g_p_json + p_tok->start,
+                  (uint32_t)(p_tok->end - p_tok->start));
+
+        if (1u == g_depth)
+        {
+            json_key_t const * const p_entry =
+                json_key_lookup(g_p_json + p_tok->start,
+                                (uint32_t)(p_tok->end - p_tok->start));
+
+            if ((NULL != p_entry) && (json_key_command == p_entry->handler))
+            {
+                json_check_command(p_val);
+            }
+        }
+    }
+
+    json_cbor_value(p_emit, p_val);
+
+    if (0 != json_cbor_send(p_emit))
+    {
+        return JSON_STEP_BLOCKED;
+    }
+
+    p_top->remaining--;
+
+    if (p_val != p_tok)
+    {
+        g_current_token++;
+    }
+
+    if ((JSMN_OBJECT == p_val->type) || (JSMN_ARRAY == p_val->type))
+    {
+        json_walk_enter(p_val);
+    }
+    else
+    {
+        g_current_token++;
+    }
+
+    return JSON_STEP_EMITTED;
+}
+
+
+/*!
+ * @brief Advance the CBOR encoding of a schema message by one step.
+ *
+ * Members in document order, as json_schema_step(); a string array is
+ * its array head, then one element per call.
+ *
+ * @return Step result, as json_walk_step().
+ */
+static json_step_t
+json_cbor_schema_step (emit_t * const p_emit)
+{
+    uint32_t const field_count = json_msg_field_count(g_p_msg);
+    json_field_view_t view;
+    uint32_t members = 0u;
+
+    /* Members in the document, for the root map head */
+    while (g_b_cbor_head && (json_msg_order(g_p_msg, members) < field_count))
+    {
+        members++;
+    }
+
+    json_cbor_begin(p_emit, members);
+
+    if (0 != json_msg_field(g_p_msg, json_msg_order(g_p_msg, g_schema_member),
+                            &view))
+    {
+        /* Past the last member */
+        return json_cbor_done(p_emit);
+    }
+
+    if (0u == g_schema_item)
+    {
+        json_key_t const * const p_entry = json_key_lookup(view.p_key,
+                                                           view.key_len);
+        jsmntok_t value;
+
+        json_schema_token(&view, &value);
+        cbor_text(p_emit, view.p_key, view.key_len);
+
+        if (JSON_FIELD_STRING_ARRAY == view.type)
+        {
+            cbor_head(p_emit, CBOR_MAJOR_ARRAY, view.item_count);
+        }
+        else
+        {
+            json_cbor_value(p_emit, &value);
+        }
+
+        if ((NULL != p_entry) && (json_key_command == p_entry->handler))
+        {
+            json_check_command(&value);
+        }
+
+        if (0 != json_cbor_send(p_emit))
+        {
+            return JSON_STEP_BLOCKED;
+        }
+
+        if ((JSON_FIELD_STRING_ARRAY == view.type) && (0u != view.item_count))
+        {
+            g_schema_item = 1u;
+        }
+        else
+        {
+            g_schema_member++;
+        }
+
+        return JSON_STEP_EMITTED;
+    }
+
+    cbor_text(p_emit, view.p_items[g_schema_item - 1u].p_start,
+              view.p_items[g_schema_item - 1u].len);
+
+    if (0 != json_cbor_send(p_emit))
+    {
+        return JSON_STEP_BLOCKED;
+    }
+
+    if (g_schema_item < view.item_count)
+    {
+        g_schema_item++;
+    }
+    else
+    {
+        g_schema_item = 0u;
+        g_schema_member++;
+    }
+
+    return JSON_STEP_EMITTED;
+}
+
+
+#if (JSON_SOURCE == JSON_SOURCE_UART)
+/*!
+ * @brief Stream callback: store a received message in the fill frame.
+ *
+ * A message that one of the generated schema parsers recognises keeps
+ * its struct in the frame and takes no arena block.
+ *
+ * @return 0 if stored, -2 if both frames are still in use or the token
+ *         arena has no room yet (the stream keeps the message and input
+ *         waits in the RX ring).
+ */
+static int32_t
+json_rx_on_message (void * p_ctx, char const * p_js, uint32_t len,
+                    jsmntok_t const * p_tokens, int32_t num_tokens)
+{
+    json_rx_frame_t * p_frame = &g_rx_frames[g_rx_fill];
+    jsmntok_t * p_block = NULL;
+
+    (void)p_ctx;
+
+    if (JSON_RX_FREE != p_frame->state)
+    {
+        return -2;
+    }
+
+#if (JSON_USE_SCHEMA)
+    p_frame->msg.id = JSON_MSG_NONE;
+#endif
+
+    if (num_tokens > 0)
+    {
+        (void)memcpy(p_frame->text, p_js, len);
+
+#if (JSON_USE_SCHEMA)
+        if (JSON_MSG_NONE == json_msg_parse(p_frame->text, len, &p_frame->msg))
+#endif
+        {
+            /* Exactly as many tokens as the message has */
+            p_block = tok_arena_alloc(&g_arena, (uint32_t)num_tokens);
+
+            if (NULL == p_block)
+            {
+                return -2;
+            }
+
+            (void)memcpy(p_block, p_tokens,
+                         (uint32_t)num_tokens * sizeof(jsmntok_t));
+        }
+    }
+
+    p_frame->p_tokens = p_block;
+    p_frame->tok_mark = tok_arena_mark(&g_arena);
+    p_frame->num_tokens = num_tokens;
+    p_frame->state = JSON_RX_READY;
+    g_rx_fill = (g_rx_fill + 1u) % JSON_RX_FRAME_COUNT;
+
+    return 0;
+}
+
+
+/*!
+ * @brief Free frames whose output has left the UART.
+ *
+ * Frames finish in the order they were filled and are freed in that
+ * order too, which is what tok_arena_release() needs.
+ *
+ * @return TRUE if at least one frame was freed.
+ */
+static bool_t
+json_rx_release (void)
+{
+    json_rx_frame_t * p_frame = &g_rx_frames[g_rx_drain];
+    bool_t b_freed = FALSE;
+
+    while ((JSON_RX_DRAINING == p_frame->state) &&
+           uart_tx_done(p_frame->tx_mark))
+    {
+        tok_arena_release(&g_arena, p_frame->tok_mark);
+        p_frame->state = JSON_RX_FREE;
+        b_freed = TRUE;
+
+        g_rx_drain = (g_rx_drain + 1u) % JSON_RX_FRAME_COUNT;
+        p_frame = &g_rx_frames[g_rx_drain];
+    }
+
+    return b_freed;
+}
+
+
+/*!
+ * @brief Hold the sender while output or token storage falls behind.
+ *
+ * Input that cannot be answered yet would otherwise pile up in the RX
+ * ring until it overruns; holding RTS early keeps the ring for bursts.
+ * A full ring still holds the sender by itself (see uart_rx_hold()).
+ */
+static void
+json_rx_backpressure (void)
+{
+    uint32_t const tx_free = uart_tx_free();
+    uint32_t const arena_free = tok_arena_free(&g_arena);
+
+    if (g_b_rx_held)
+    {
+        if ((tx_free >= JSON_RELEASE_TX_FREE_BYTES) &&
+            (arena_free >= JSON_HOLD_ARENA_FREE))
+        {
+            g_b_rx_held = FALSE;
+            uart_rx_hold(FALSE);
+        }
+    }
+    else if ((tx_free < JSON_HOLD_TX_FREE_BYTES) ||
+             (arena_free < JSON_HOLD_ARENA_FREE))
+    {
+        g_b_rx_held = TRUE;
+        uart_rx_hold(TRUE);
+    }
+}
+
+
+/*!
+ * @brief Background work for the RX pipeline, run on every call.
+ *
+ * Frees finished frames and pulls newly received bytes into the stream,
+ * so reception overlaps answering.
+ */
+static void
+json_rx_service (void)
+{
+    (void)json_rx_release();
+    (void)json_stream_poll_uart(&g_stream);
+    json_rx_backpressure();
+}
+
+
+/*!
+ * @brief Make the next received frame the current document.
+ *
+ * @return TRUE if a frame was taken, FALSE if none is waiting.
+ */
+static bool_t
+json_rx_next (void)
+{
+    json_rx_frame_t * p_frame = &g_rx_frames[g_rx_serve];
+
+    if (JSON_RX_READY != p_frame->state)
+    {
+        return FALSE;
+    }
+
+    p_frame->state = JSON_RX_ACTIVE;
+    g_rx_serve = (g_rx_serve + 1u) % JSON_RX_FRAME_COUNT;
+    g_p_rx_active = p_frame;
+
+    g_p_json = p_frame->text;
+    g_p_tokens = p_frame->p_tokens;
+    g_parse_result = p_frame->num_tokens;
+#if (JSON_USE_SCHEMA)
+    g_p_msg = (JSON_MSG_NONE != p_frame->msg.id) ? &p_frame->msg : NULL;
+#endif
+
+    return TRUE;
+}
+
+
+/*!
+ * @brief Finish the current frame once all its output is queued.
+ *
+ * The frame is freed later by json_rx_service(), when the TX engine no
+ * longer reads slices that point into it.
+ */
+static void
+json_rx_finish (void)
+{
+    if (NULL != g_p_rx_active)
+    {
+        g_p_rx_active->tx_mark = uart_tx_mark();
+        g_p_rx_active->state = JSON_RX_DRAINING;
+        g_p_rx_active = NULL;
+    }
+
+    g_json_state = JSON_STATE_IDLE;
+}
+#endif
 
-/* Error codes for JSON processing */
-#define JSON_ERR_PARSE_FAILED   1
-#define JSON_ERR_NO_OBJECT      2
-#define JSON_SUCCESS            0
 
-/* JSON processor state machine */
-typedef enum {
-    JSON_STATE_IDLE = 0,
-    JSON_STATE_PARSING,
-    JSON_STATE_TRANSMITTING,
-    JSON_STATE_WAITING,
-    JSON_STATE_COMPLETE
-} json_state_t;
+/*!
+ * @brief RX task: pull received bytes into the stream.
+ *
+ * Runs straight from the RX interrupt's signal, so input keeps flowing
+ * while the answer to the previous message waits on TX or pacing.
+ *
+ * @return TRUE while input is still waiting behind a full stream buffer.
+ */
+static bool_t
+json_task_rx (void)
+{
+#if (JSON_SOURCE == JSON_SOURCE_UART)
+    int32_t const delivered = json_stream_poll_uart(&g_stream);
 
-/* Global state for non-blocking operation */
-static json_state_t g_json_state = JSON_STATE_IDLE;
-static int32_t g_current_token = 1;  /* Start at 1 to skip root object */
-static uint32_t g_delay_start = 0;
-static jsmn_parser_t g_parser;
-static jsmntok_t g_tokens[MAX_JSON_TOKENS];
-static int32_t g_parse_result = 0;
+    json_rx_backpressure();
 
-/* Interrupt Enable Number */
-#define USART2_IRQn 28u
+    if (delivered > 0)
+    {
+        sched_signal(SCHED_TASK_PARSE);
+    }
 
-/* Inline functions for interrupt control */
-static inline void __enable_irq(void) {
-    __asm volatile ("cpsie i" : : : "memory");
+    return ((delivered > 0) ||
+            ((FALSE == g_stream.b_held) && (0u != uart_rx_available()))) ?
+           TRUE : FALSE;
+#else
+    return FALSE;
+#endif
 }
 
-static inline void NVIC_EnableIRQ(uint32_t IRQn) {
-    volatile uint32_t *NVIC_ISER0 = (volatile uint32_t *)0xE000E100;
-    NVIC_ISER0[IRQn >> 5] = (1u << (IRQn & 0x1F));
-}
 
-/* External UART state variables */
-extern volatile uart_state_t g_tx_state;
+/*!
+ * @brief TX task: free sent frames and resume blocked output.
+ *
+ * @return FALSE (runs again on the next retired slice).
+ */
+static bool_t
+json_task_tx (void)
+{
+#if (JSON_SOURCE == JSON_SOURCE_UART)
+    if (json_rx_release())
+    {
+        /* A message held back for want of a frame may fit now */
+        sched_signal(SCHED_TASK_RX);
+    }
 
-/* Hardcoded JSON test string */
-static char const JSON_STRING[] =
-    "{\"user\": \"johndoe\", \"admin\": false, \"uid\": 1000,\n  "
-    "\"groups\": [\"users\", \"wheel\", \"audio\", \"video\"]}";
+    json_rx_backpressure();
+#endif
+
+    sched_signal(SCHED_TASK_PARSE);
+
+    return FALSE;
+}
 
 
 /*!
- * @brief Compare JSON token string with target string.
+ * @brief Parse task: one step of the JSON state machine.
+ *
+ * @return TRUE until the step has to wait for RX, TX or time.
  */
-static int32_t
-jsoneq(char const * const p_json, jsmntok_t const * const p_tok, 
-       char const * const p_s)
+static bool_t
+json_task_parse (void)
 {
-    int32_t result = -1;
-    size_t target_len = strlen(p_s);
-    int32_t token_len = p_tok->end - p_tok->start;
+    (void)json_process();
 
-    if ((JSMN_STRING == p_tok->type) && 
-        ((int32_t)target_len == token_len) &&
-        (0 == strncmp(p_json + p_tok->start, p_s, (size_t)token_len)))
-    {
-        result = 0;
-    }
+    return (FALSE == g_b_json_blocked) ? TRUE : FALSE;
+}
 
-    return result;
+
+/*!
+ * @brief Timer callback: a time-based wait is over, re-check it.
+ *
+ * Pacing delays and the rate limiter only clear as time passes, which no
+ * RX or TX event reports.
+ */
+static void
+json_wake_parse (void * p_ctx)
+{
+    (void)p_ctx;
+    sched_signal(SCHED_TASK_PARSE);
 }
 
 
 /*!
  * @brief Initialize JSON processing subsystem.
+ *
+ * Also installs the bridge's tasks in the scheduler (see sched_run()).
  */
 void json_process_init(void)
 {
+#if (JSON_SOURCE == JSON_SOURCE_UART)
+    uint32_t i;
+#endif
+
+    /* Core clock first: SysTick and the baud rate divisor derive from it.
+     * If the PLL fails the bridge carries on from HSI16. */
+    (void)clock_set_sysclk(CLOCK_SYSCLK_HZ);
+
     /* Initialize delay subsystem */
     delay_init();
+    profile_reset();
+    trace_reset();
     
     /* Initialize UART */
     (void)uart_init();
@@ -112,172 +1736,241 @@ void json_process_init(void)
     NVIC_EnableIRQ(USART2_IRQn);
     __enable_irq();
     
-    /* Parse JSON once at initialization */
-    jsmn_init(&g_parser);
-    g_parse_result = jsmn_parse(&g_parser, JSON_STRING, strlen(JSON_STRING), 
-                                g_tokens, MAX_JSON_TOKENS);
+    (void)tok_arena_init(&g_arena, g_arena_tokens, JSON_TOKEN_ARENA_SIZE);
+    
+    g_p_msg = NULL;
+    g_parse_result = 0;
+    
+#if (JSON_SOURCE == JSON_SOURCE_BUILTIN)
+    /* Parsed by the first state machine step (json_builtin_parse()) */
+    g_p_json = NULL;
+    g_p_tokens = NULL;
+#else
+    /* Receive continuously; messages are parsed as they arrive */
+    for (i = 0u; i < JSON_RX_FRAME_COUNT; i++)
+    {
+        g_rx_frames[i].state = JSON_RX_FREE;
+    }
+    g_rx_fill = 0u;
+    g_rx_serve = 0u;
+    g_rx_drain = 0u;
+    g_p_rx_active = NULL;
+    g_b_rx_held = FALSE;
+    uart_rx_hold(FALSE);
+    
+    json_stream_init(&g_stream, json_rx_on_message, NULL);
+    (void)uart_rx_start();
+#endif
     
     /* Reset state machine */
     g_json_state = JSON_STATE_IDLE;
-    g_current_token = 1;
+    g_b_rate_charged = FALSE;
+    json_walk_reset();
+    json_batch_flush();
+
+    sched_init();
+    (void)sched_task_set(SCHED_TASK_RX, json_task_rx);
+    (void)sched_task_set(SCHED_TASK_TX, json_task_tx);
+    (void)sched_task_set(SCHED_TASK_PARSE, json_task_parse);
+    sched_signal(SCHED_TASK_RX);
+    sched_signal(SCHED_TASK_PARSE);
 }
 
 
 /*!
- * @brief Process JSON with non-blocking state machine.
- *
- * Call this repeatedly in main loop. It progresses through parsing
- * and transmission states without blocking.
+ * @brief Format the next output line in the encoding of this message.
+ */
+static json_step_t
+json_output_step (emit_t * const p_emit)
+{
+    if (JSON_OUTPUT_CBOR == g_walk_output)
+    {
+        return (NULL != g_p_msg) ? json_cbor_schema_step(p_emit) :
+                                   json_cbor_walk_step(p_emit);
+    }
+
+    return (NULL != g_p_msg) ? json_schema_step(p_emit) :
+                               json_walk_step(p_emit);
+}
+
+
+#if (JSON_SOURCE == JSON_SOURCE_BUILTIN)
+/*!
+ * @brief Parse the built-in document, once.
  *
- * @return 0 if still processing, positive error code on failure,
- *         1 when complete.
+ * Deferred from json_process_init() to the first step, so the clock,
+ * UART and scheduler are all running before the parse cost is paid:
+ * generated parser if the message type is known, otherwise count
+ * tokens, then fill that many.
  */
-int32_t json_process(void)
+static void
+json_builtin_parse (void)
+{
+    jsmntok_t * p_tokens = NULL;
+    PROFILE_START(parse_start);
+
+    if (NULL != g_p_json)
+    {
+        return;
+    }
+
+#if (JSON_USE_SCHEMA)
+    if (JSON_MSG_NONE != json_msg_parse(JSON_STRING,
+                                        (uint32_t)strlen(JSON_STRING),
+                                        &g_builtin_msg))
+    {
+        g_p_msg = &g_builtin_msg;
+    }
+    else
+#endif
+    {
+        g_parse_result = tok_arena_parse(&g_arena, JSON_STRING,
+                                         (uint32_t)strlen(JSON_STRING),
+                                         &p_tokens);
+    }
+    PROFILE_STOP(PROFILE_JSMN_PARSE, parse_start);
+    g_p_json = JSON_STRING;
+    g_p_tokens = p_tokens;
+}
+#endif
+
+
+/*!
+ * @brief Run one step of the JSON state machine (see json_process()).
+ */
+static int32_t json_process_step(void)
 {
-    char output_buffer[OUTPUT_BUFFER_SIZE];
-    int32_t i;
+    emit_t line;
+
+    g_b_json_blocked = FALSE;
+
+#if (JSON_SOURCE == JSON_SOURCE_UART)
+    json_rx_service();
+#endif
 
     switch (g_json_state)
     {
         case JSON_STATE_IDLE:
         {
+#if (JSON_SOURCE == JSON_SOURCE_UART)
+            /* Wait for a received message */
+            if ((NULL == g_p_rx_active) && (FALSE == json_rx_next()))
+            {
+                /* An open batch waits for more messages until its time
+                 * is up (g_batch_timer wakes this task then) */
+                if (g_b_batch_open &&
+                    delay_elapsed(g_batch_start, g_batch_max_delay_ms))
+                {
+                    json_batch_flush();
+                }
+                g_b_json_blocked = TRUE;
+                break;
+            }
+#else
+            json_builtin_parse();
+#endif
+
+            /* Recognised by a generated parser: no tokens to check */
+            if (NULL != g_p_msg)
+            {
+                json_stats_note(0, TRUE);
+                json_walk_reset();
+                g_json_state = JSON_STATE_TRANSMITTING;
+                break;
+            }
+
             /* Check if parsing succeeded */
             if (g_parse_result < 0)
             {
-                (void)sprintf(output_buffer, "Failed to parse JSON: %ld\r\n", 
-                              (long)g_parse_result);
-                
-                if (UART_STATE_IDLE == g_tx_state)
+                if (0 == json_send_error(&line, "Failed to parse JSON: ",
+                                         json_error_text(g_parse_result)))
                 {
-                    (void)uart_transmit_buffer(output_buffer);
+                    json_stats_note(g_parse_result, TRUE);
                     g_json_state = JSON_STATE_COMPLETE;
                 }
+                else
+                {
+                    g_b_json_blocked = TRUE;
+                }
                 return JSON_ERR_PARSE_FAILED;
             }
 
             /* Verify top-level element is an object */
-            if ((g_parse_result < 1) || (JSMN_OBJECT != g_tokens[0].type))
+            if ((g_parse_result < 1) || (JSMN_OBJECT != g_p_tokens[0].type))
             {
-                (void)sprintf(output_buffer, "Object expected\r\n");
-                
-                if (UART_STATE_IDLE == g_tx_state)
+                if (0 == json_send_error(&line, "Object expected", ""))
                 {
-                    (void)uart_transmit_buffer(output_buffer);
+                    json_stats_note(g_parse_result, FALSE);
                     g_json_state = JSON_STATE_COMPLETE;
                 }
+                else
+                {
+                    g_b_json_blocked = TRUE;
+                }
                 return JSON_ERR_NO_OBJECT;
             }
             
-            /* Start processing tokens */
+            /* Start processing tokens below the root object */
+            json_stats_note(g_parse_result, TRUE);
+            json_walk_reset();
             g_json_state = JSON_STATE_TRANSMITTING;
-            g_current_token = 1;
             break;
         }
 
         case JSON_STATE_TRANSMITTING:
         {
-            /* Only transmit if UART is idle */
-            if (UART_STATE_IDLE != g_tx_state)
-            {
-                break;  /* Wait for previous transmission to complete */
-            }
-            
-            /* Check if we've processed all tokens */
-            if (g_current_token >= g_parse_result)
-            {
-                g_json_state = JSON_STATE_COMPLETE;
-                break;
-            }
-            
-            i = g_current_token;
-            
-            /* Process current token */
-            if (0 == jsoneq(JSON_STRING, &g_tokens[i], "user"))
-            {
-                (void)sprintf(output_buffer, "- User: %.*s\r\n", 
-                              g_tokens[i + 1].end - g_tokens[i + 1].start,
-                              JSON_STRING + g_tokens[i + 1].start);
-                (void)uart_transmit_buffer(output_buffer);
-                g_current_token += 2;
-                
-                /* Start non-blocking delay */
-                g_delay_start = delay_start();
-                g_json_state = JSON_STATE_WAITING;
-            }
-            else if (0 == jsoneq(JSON_STRING, &g_tokens[i], "admin"))
-            {
-                (void)sprintf(output_buffer, "- Admin: %.*s\r\n", 
-                              g_tokens[i + 1].end - g_tokens[i + 1].start,
-                              JSON_STRING + g_tokens[i + 1].start);
-                (void)uart_transmit_buffer(output_buffer);
-                g_current_token += 2;
-                
-                g_delay_start = delay_start();
-                g_json_state = JSON_STATE_WAITING;
-            }
-            else if (0 == jsoneq(JSON_STRING, &g_tokens[i], "uid"))
+            json_step_t step = json_output_step(&line);
+
+            /* Batched: format the rest of the message in this same call
+             * rather than one scheduler pass per line */
+            while ((0u != g_batch_max_bytes) &&
+                   (JSON_PACING_FIXED_DELAY != g_pacing) &&
+                   ((JSON_STEP_EMITTED == step) || (JSON_STEP_CONTINUE == step)))
             {
-                (void)sprintf(output_buffer, "- UID: %.*s\r\n", 
-                              g_tokens[i + 1].end - g_tokens[i + 1].start,
-                              JSON_STRING + g_tokens[i + 1].start);
-                (void)uart_transmit_buffer(output_buffer);
-                g_current_token += 2;
-                
-                g_delay_start = delay_start();
-                g_json_state = JSON_STATE_WAITING;
+                step = json_output_step(&line);
             }
-            else if (0 == jsoneq(JSON_STRING, &g_tokens[i], "groups"))
+
+            switch (step)
             {
-                int32_t j;
-                
-                (void)sprintf(output_buffer, "- Groups:\r\n");
-                (void)uart_transmit_buffer(output_buffer);
-                
-                g_delay_start = delay_start();
-                g_json_state = JSON_STATE_WAITING;
-                
-                /* Verify groups is an array */
-                if (JSMN_ARRAY != g_tokens[i + 1].type)
+                case JSON_STEP_EMITTED:
                 {
-                    g_current_token++;
+                    if (JSON_PACING_FIXED_DELAY == g_pacing)
+                    {
+                        /* Start non-blocking delay; the timer wakes the
+                         * parse task on the tick it elapses */
+                        g_delay_start = delay_start();
+                        (void)timer_start(&g_wake_timer, g_tx_delay_ms,
+                                          json_wake_parse, NULL);
+                        g_json_state = JSON_STATE_WAITING;
+                    }
                     break;
                 }
-                
-                /* Process array elements */
-                for (j = 0; j < g_tokens[i + 1].size; j++)
+
+                case JSON_STEP_DONE:
                 {
-                    /* This still blocks for array elements - see note below */
-                    jsmntok_t const * const p_group = &g_tokens[i + j + 2];
-                    
-                    /* Wait for UART idle */
-                    while (UART_STATE_IDLE != g_tx_state) {
-                        /* Spin wait - could be improved */
-                    }
-                    
-                    (void)sprintf(output_buffer, "  * %.*s\r\n", 
-                                  p_group->end - p_group->start, 
-                                  JSON_STRING + p_group->start);
-                    (void)uart_transmit_buffer(output_buffer);
-                    
-                    /* Non-blocking delay between array elements */
-                    uint32_t array_delay = delay_start();
-                    while (!delay_elapsed(array_delay, TX_DELAY_MS)) {
-                        /* Allow other processing here */
+                    g_json_state = JSON_STATE_COMPLETE;
+                    break;
+                }
+
+                case JSON_STEP_BLOCKED:
+                {
+                    /* TX queue or rate limit full - retry on next call.
+                     * TX space is reported by the TX task, credit only
+                     * by time: look again on the next tick */
+                    if (JSON_PACING_RATE_LIMITED == g_pacing)
+                    {
+                        (void)timer_start(&g_wake_timer, 1u,
+                                          json_wake_parse, NULL);
                     }
+                    g_b_json_blocked = TRUE;
+                    break;
+                }
+
+                default:
+                {
+                    /* CONTINUE - resume on next call */
+                    break;
                 }
-                
-                g_current_token += g_tokens[i + 1].size + 2;
-            }
-            else
-            {
-                (void)sprintf(output_buffer, "Unexpected key: %.*s\r\n", 
-                              g_tokens[i].end - g_tokens[i].start,
-                              JSON_STRING + g_tokens[i].start);
-                (void)uart_transmit_buffer(output_buffer);
-                g_current_token++;
-                
-                g_delay_start = delay_start();
-                g_json_state = JSON_STATE_WAITING;
             }
             break;
         }
@@ -285,18 +1978,48 @@ int32_t json_process(void)
         case JSON_STATE_WAITING:
         {
             /* Non-blocking delay - check if time has elapsed */
-            if (delay_elapsed(g_delay_start, TX_DELAY_MS))
+            if (delay_elapsed(g_delay_start, g_tx_delay_ms))
             {
                 g_json_state = JSON_STATE_TRANSMITTING;
             }
-            /* Otherwise, return and let main loop do other work */
+            else
+            {
+                /* Return and let main loop do other work */
+                g_b_json_blocked = TRUE;
+            }
             break;
         }
 
         case JSON_STATE_COMPLETE:
         {
+            /* Commands run once the answer is queued; retry if TX is full */
+            if (0 != json_run_command())
+            {
+                g_b_json_blocked = TRUE;
+                break;
+            }
+
+            /* The next message pays for itself again */
+            g_b_rate_charged = FALSE;
+
+#if (JSON_SOURCE == JSON_SOURCE_UART)
+            /* Message end: the batch goes out unless it may still wait
+             * for the next message */
+            if ((0u == g_batch_max_delay_ms) ||
+                delay_elapsed(g_batch_start, g_batch_max_delay_ms))
+            {
+                json_batch_flush();
+            }
+
+            /* Answer queued - release the frame and wait for the next */
+            json_rx_finish();
+            break;
+#else
             /* Reset for next iteration if needed */
+            json_batch_flush();
+            g_b_json_blocked = TRUE;
             return JSON_SUCCESS;
+#endif
         }
 
         default:
@@ -305,19 +2028,197 @@ int32_t json_process(void)
             break;
         }
     }
+
+    /* Waiting on TX space, pacing or a command: the batch must go out */
+    if (g_b_json_blocked && (JSON_STATE_IDLE != g_json_state))
+    {
+        json_batch_flush();
+    }
     
     /* Still processing */
     return 0;
 }
 
 
+/*!
+ * @brief Process JSON with non-blocking state machine.
+ *
+ * Call this repeatedly in main loop. It progresses through parsing
+ * and transmission states without blocking. With JSON_SOURCE_UART each
+ * received message is answered in turn and the processor then waits for
+ * the next one. In a PROFILE_ENABLE build every call is timed against
+ * the probe of the state it started in; in a TRACE_ENABLE build every
+ * state change is traced.
+ *
+ * @return 0 if still processing, positive error code on failure,
+ *         1 when complete.
+ */
+int32_t json_process(void)
+{
+    int32_t result;
+#ifdef PROFILE_ENABLE
+    profile_probe_t const probe =
+        (profile_probe_t)((uint32_t)PROFILE_JSON_IDLE + (uint32_t)g_json_state);
+#endif
+#ifdef TRACE_ENABLE
+    json_state_t const state_in = g_json_state;
+#endif
+
+    PROFILE_START(step_start);
+    result = json_process_step();
+    PROFILE_STOP(probe, step_start);
+
+#ifdef TRACE_ENABLE
+    if (g_json_state != state_in)
+    {
+        TRACE(TRACE_EV_JSON_STATE,
+              ((uint32_t)state_in << 8) | (uint32_t)g_json_state);
+    }
+#endif
+
+    return result;
+}
+
+
 /*!
  * @brief Reset JSON processor to process data again.
  */
 void json_process_reset(void)
 {
+    timer_stop(&g_wake_timer);
+    json_batch_flush();
     g_json_state = JSON_STATE_IDLE;
-    g_current_token = 1;
+    g_b_rate_charged = FALSE;
+    json_walk_reset();
+}
+
+/*!
+ * @brief Pace output with a fixed gap after every line.
+ *
+ * @param[in] delay_ms Gap in milliseconds (0 behaves like full rate).
+ */
+void json_set_pacing_fixed(uint32_t const delay_ms)
+{
+    g_tx_delay_ms = delay_ms;
+    g_pacing = JSON_PACING_FIXED_DELAY;
+}
+
+
+/*!
+ * @brief Emit lines back-to-back, limited only by TX queue space.
+ */
+void json_set_pacing_full_rate(void)
+{
+    g_pacing = JSON_PACING_FULL_RATE;
+}
+
+
+/*!
+ * @brief Pace output with a token bucket.
+ *
+ * In messages/s mode a message costs one unit however many lines or
+ * CBOR items it takes; each line still waits for TX queue space.
+ *
+ * @param[in] unit JSON_RATE_BYTES_PER_SEC or JSON_RATE_MESSAGES_PER_SEC.
+ * @param[in] rate Sustained rate in the chosen unit per second.
+ * @param[in] burst Largest burst in the chosen unit.
+ *
+ * @return 0 on success, -1 if the parameters are invalid (pacing unchanged).
+ */
+int32_t json_set_rate_limit(json_rate_unit_t const unit, uint32_t const rate,
+                            uint32_t const burst)
+{
+    if ((JSON_RATE_BYTES_PER_SEC != unit) &&
+        (JSON_RATE_MESSAGES_PER_SEC != unit))
+    {
+        return -1;
+    }
+
+    if ((0u == rate) || (0 != ratelimit_init(&g_rate_limit, rate, burst)))
+    {
+        return -1;
+    }
+
+    g_rate_unit = unit;
+    g_pacing = JSON_PACING_RATE_LIMITED;
+
+    return 0;
+}
+
+
+/*!
+ * @brief Batch output: all lines of a message leave as one transfer.
+ *
+ * Lines are copied into the TX FIFO back-to-back and the UART is only
+ * started when the batch is flushed, so a message with many small
+ * fields costs one DMA transfer (or one TXE run) and one pass of the
+ * parse task rather than one of each per line. Output queued before
+ * the batch opened finishes first; nothing of the batch leaves before
+ * the flush, even if a transfer was running. Pacing still applies:
+ * under JSON_PACING_FIXED_DELAY every gap flushes.
+ *
+ * A batch is flushed at the end of the message, or with max_delay_ms
+ * set, held open for the following messages until max_delay_ms after
+ * its first line. It also goes out early once it holds max_bytes, and
+ * whenever processing has to wait for TX space.
+ *
+ * @param[in] max_bytes Flush threshold (1 .. UART_TX_FIFO_SIZE_BYTES).
+ * @param[in] max_delay_ms Longest hold across messages (0 = none).
+ *
+ * @return 0 on success, -1 if max_bytes is out of range (unchanged).
+ */
+int32_t json_set_batching(uint32_t const max_bytes, uint32_t const max_delay_ms)
+{
+    if ((0u == max_bytes) || (max_bytes > UART_TX_FIFO_SIZE_BYTES))
+    {
+        return -1;
+    }
+
+    g_batch_max_bytes = max_bytes;
+    g_batch_max_delay_ms = max_delay_ms;
+
+    return 0;
+}
+
+
+/*!
+ * @brief Stop batching; an open batch is sent now.
+ */
+void json_set_batching_off(void)
+{
+    g_batch_max_bytes = 0u;
+    json_batch_flush();
+}
+
+
+/*!
+ * @brief Select the output encoding.
+ *
+ * A message already being answered keeps the encoding it started with;
+ * the new one applies from the next message.
+ *
+ * @param[in] output JSON_OUTPUT_TEXT or JSON_OUTPUT_CBOR.
+ */
+void json_set_output(json_output_t const output)
+{
+    g_output = output;
+}
+
+
+/*!
+ * @brief Take a copy of the message counters.
+ *
+ * Every answered message counts once, including those answered with a
+ * parse error; the UART side is read with uart_get_stats().
+ *
+ * @param[out] p_stats Filled with the counters since start-up.
+ */
+void json_get_stats(json_stats_t * const p_stats)
+{
+    if (NULL != p_stats)
+    {
+        *p_stats = g_stats;
+    }
 }
 
 #ifdef __cplusplus
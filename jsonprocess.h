@@ -11,9 +11,82 @@
 
 #include <stdint.h>
 
+/* Input sources */
+#define JSON_SOURCE_BUILTIN        0u   /* Compiled-in demo document, sent once */
+#define JSON_SOURCE_UART           1u   /* Live JSON messages received on USART2 */
+
+/* Select input source (override with -DJSON_SOURCE=...) */
+#ifndef JSON_SOURCE
+#define JSON_SOURCE                JSON_SOURCE_UART
+#endif
+
+/* Output pacing policies */
+typedef enum {
+    JSON_PACING_FIXED_DELAY = 0,   /* Fixed gap after every line (human-readable) */
+    JSON_PACING_FULL_RATE,         /* No gap - bounded only by TX queue space */
+    JSON_PACING_RATE_LIMITED       /* Token bucket in bytes/s or messages/s */
+} json_pacing_t;
+
+/* Units for JSON_PACING_RATE_LIMITED */
+typedef enum {
+    JSON_RATE_BYTES_PER_SEC = 0,
+    JSON_RATE_MESSAGES_PER_SEC     /* One unit per message, any line count */
+} json_rate_unit_t;
+
+/* Pacing applied at start-up: live traffic is answered at line rate */
+#ifndef JSON_PACING_DEFAULT
+#if (JSON_SOURCE == JSON_SOURCE_UART)
+#define JSON_PACING_DEFAULT        JSON_PACING_FULL_RATE
+#else
+#define JSON_PACING_DEFAULT        JSON_PACING_FIXED_DELAY
+#endif
+#endif
+
+/* Gap used by JSON_PACING_FIXED_DELAY until changed at runtime */
+#define JSON_DEFAULT_TX_DELAY_MS   500u
+
+/* Output encodings */
+typedef enum {
+    JSON_OUTPUT_TEXT = 0,          /* "- Label: value" lines (human-readable) */
+    JSON_OUTPUT_CBOR               /* One CBOR map per message (cbor.h) */
+} json_output_t;
+
+/* Encoding used at start-up (override with -DJSON_OUTPUT_DEFAULT=...) */
+#ifndef JSON_OUTPUT_DEFAULT
+#define JSON_OUTPUT_DEFAULT        JSON_OUTPUT_TEXT
+#endif
+
+/* Message counters since start-up (json_get_stats()), all free-running */
+typedef struct {
+    uint32_t messages;             /* Messages answered, good or bad */
+    uint32_t parse_nomem;          /* JSMN_ERROR_NOMEM: too many tokens */
+    uint32_t parse_inval;          /* JSMN_ERROR_INVAL: invalid character */
+    uint32_t parse_part;           /* JSMN_ERROR_PART: truncated document */
+    uint32_t too_long;             /* Larger than the receive buffer */
+    uint32_t bad_frame;            /* Frame ended inside a message */
+    uint32_t not_object;           /* Parsed, but not a JSON object */
+} json_stats_t;
+
 /* Public API functions */
 void json_process_init(void);
 int32_t json_process(void);
+void json_process_reset(void);
+
+/* Runtime pacing configuration */
+void json_set_pacing_fixed(uint32_t const delay_ms);
+void json_set_pacing_full_rate(void);
+int32_t json_set_rate_limit(json_rate_unit_t const unit, uint32_t const rate,
+                            uint32_t const burst);
+
+/* Runtime output batching (one UART transfer per message) */
+int32_t json_set_batching(uint32_t const max_bytes, uint32_t const max_delay_ms);
+void json_set_batching_off(void);
+
+/* Runtime output encoding (applies from the next message) */
+void json_set_output(json_output_t const output);
+
+/* Statistics */
+void json_get_stats(json_stats_t * const p_stats);
 
 #endif /* JSONPROCESS_H */
 
@@ -14,6 +14,18 @@
 #include "jsmn.h"
 #include "uart.h"
 #include "delay.h"
+#include "jsonstream.h"
+#include "tokarena.h"
+#include "jsonpath.h"
+#include "jsonschema_gen.h"
+#include "emit.h"
+#include "cbor.h"
+#include "sched.h"
+#include "timer.h"
+#include "trace.h"
+#include "jsonwriter.h"
+#include "jsontok.h"
+#include "jsonprocess.h"
 
 /* Test configuration */
 #define MAX_TOKENS 20
@@ -298,6 +310,668 @@ void test_json_extract_boolean(void)
     report_test("Extract Boolean Value", passed);
 }
 
+/* ============================================
+ * TEST 9: Streaming Parse Across Chunks
+ * ============================================ */
+static uint32_t g_stream_messages = 0;
+static int32_t g_stream_tokens = 0;
+static int g_stream_uid_ok = 0;
+
+static int32_t stream_on_message(void * p_ctx, char const * p_js, uint32_t len,
+                                 jsmntok_t const * p_tokens, int32_t num_tokens)
+{
+    (void)p_ctx;
+    (void)len;
+
+    g_stream_messages++;
+    g_stream_tokens = num_tokens;
+
+    /* "uid" value must survive being split across chunks */
+    for (int i = 1; (i + 1) < num_tokens; i++) {
+        if ((jsoneq(p_js, &p_tokens[i], "uid") == 0) &&
+            ((p_tokens[i + 1].end - p_tokens[i + 1].start) == 4) &&
+            (strncmp(p_js + p_tokens[i + 1].start, "1000", 4) == 0)) {
+            g_stream_uid_ok++;
+        }
+    }
+
+    return 0;
+}
+
+void test_json_stream_chunks(void)
+{
+    static json_stream_t stream;
+
+    /* Two messages back to back, fed 7 bytes at a time */
+    char const json[] =
+        "{\"user\": \"johndoe\", \"uid\": 1000}\r\n"
+        "{\"uid\": 1000, \"groups\": [\"users\", \"wheel\"]}\r\n";
+    uint32_t total = (uint32_t)strlen(json);
+    int32_t delivered = 0;
+
+    json_stream_init(&stream, stream_on_message, NULL);
+
+    for (uint32_t offset = 0; offset < total; offset += 7u) {
+        uint32_t chunk = ((total - offset) < 7u) ? (total - offset) : 7u;
+        delivered += json_stream_feed(&stream, json + offset, chunk);
+    }
+
+    int passed = (delivered == 2) && (g_stream_messages == 2) &&
+                 (g_stream_tokens == 7) && (g_stream_uid_ok == 2);
+
+    report_test("Streaming Parse Across Chunks", passed);
+}
+
+/* ============================================
+ * TEST 10: Long Strings at Every Alignment
+ * ============================================ */
+void test_json_long_strings(void)
+{
+    jsmn_parser_t parser;
+    jsmntok_t tokens[MAX_TOKENS];
+
+    /* Long value with escapes, then a whitespace run (JSMN_FAST_SCAN
+     * word paths) - token output must not depend on buffer alignment */
+    char const json[] =
+        "{\"msg\": \"0123456789abcdefghij\\\"quoted\\\" tail0123456789\","
+        "    \"n\": 42}";
+    uint32_t const len = (uint32_t)strlen(json);
+    int32_t const value_end = (int32_t)(strstr(json, "\",") - json);
+    static uint32_t buffer_words[(sizeof(json) + 3u + 3u) / 4u];
+    char * const p_buffer = (char *)buffer_words;
+    int passed = 1;
+
+    for (uint32_t offset = 0; offset < 4u; offset++) {
+        memcpy(p_buffer + offset, json, len);
+
+        jsmn_init(&parser);
+        int32_t result = jsmn_parse(&parser, p_buffer + offset, len,
+                                    tokens, MAX_TOKENS);
+
+        if ((result != 5) ||
+            (tokens[2].type != JSMN_STRING) || (tokens[2].start != 9) ||
+            (tokens[2].end != value_end) ||
+            (jsoneq(json, &tokens[3], "n") != 0) ||
+            (tokens[4].end - tokens[4].start != 2)) {
+            passed = 0;
+        }
+    }
+
+    report_test("Long Strings at Every Alignment", passed);
+}
+
+/* ============================================
+ * TEST 11: Unclosed Object Keeps End Unset
+ * ============================================ */
+void test_json_open_object(void)
+{
+    jsmn_parser_t parser;
+    jsmntok_t tokens[MAX_TOKENS];
+
+    /* The stream framer relies on end == JSMN_NONE (any token layout) */
+    char const json[] = "{\"a\": [1, 2";
+
+    jsmn_init(&parser);
+    int32_t result = jsmn_parse(&parser, json, strlen(json), tokens, MAX_TOKENS);
+
+    int passed = (result == JSMN_ERROR_PART) && (parser.toknext == 5u) &&
+                 (tokens[0].start == 0) && (tokens[0].end == JSMN_NONE) &&
+                 (tokens[2].end == JSMN_NONE) && (tokens[4].end == 11);
+
+    report_test("Unclosed Object Keeps End Unset", passed);
+}
+
+/* ============================================
+ * TEST 12: Token Arena (Exact Sizing, FIFO Release)
+ * ============================================ */
+void test_token_arena(void)
+{
+    static jsmntok_t storage[16];
+    tok_arena_t arena;
+    jsmntok_t * p_tokens = NULL;
+    char const json[] =
+        "{\"user\": \"johndoe\", \"admin\": false, \"uid\": 1000,\n  "
+        "\"groups\": [\"users\", \"wheel\", \"audio\", \"video\"]}";
+    int passed = (tok_arena_init(&arena, storage, 8u) == 0);
+
+    /* Two blocks fill the arena; a third must wait */
+    jsmntok_t * p_a = tok_arena_alloc(&arena, 5u);
+    uint32_t mark_a = tok_arena_mark(&arena);
+    jsmntok_t * p_b = tok_arena_alloc(&arena, 3u);
+    uint32_t mark_b = tok_arena_mark(&arena);
+
+    passed = passed && (p_a == &storage[0]) && (p_b == &storage[5]) &&
+             (tok_arena_alloc(&arena, 1u) == NULL);
+
+    /* Oldest-first release makes room at the start (no wrap split) */
+    tok_arena_release(&arena, mark_a);
+    passed = passed && (tok_arena_alloc(&arena, 4u) == &storage[0]) &&
+             (tok_arena_alloc(&arena, 2u) == NULL);
+    tok_arena_release(&arena, mark_b);
+    passed = passed && (tok_arena_alloc(&arena, 4u) == &storage[4]);
+
+    /* Count pass + fill pass: exactly 13 tokens carved */
+    (void)tok_arena_init(&arena, storage, 16u);
+    int32_t count = tok_arena_parse(&arena, json, strlen(json), &p_tokens);
+    passed = passed && (count == 13) && (p_tokens == &storage[0]) &&
+             (p_tokens[0].type == JSMN_OBJECT) &&
+             (tok_arena_alloc(&arena, 4u) == NULL) &&
+             (tok_arena_alloc(&arena, 3u) == &storage[13]);
+
+    /* Malformed document: block given back, O(1) reset empties all */
+    tok_arena_reset(&arena);
+    count = tok_arena_parse(&arena, "{\"a\": 1]", 9u, &p_tokens);
+    passed = passed && (count == JSMN_ERROR_INVAL) && (p_tokens == NULL) &&
+             (tok_arena_alloc(&arena, 16u) == &storage[0]);
+
+    report_test("Token Arena Sizing", passed);
+}
+
+/* ============================================
+ * TEST 13: Path Lookup Without Tokens
+ * ============================================ */
+void test_json_path_find(void)
+{
+    char const json[] =
+        "{\"user\": \"johndoe\", \"admin\": false, \"uid\": 1000,\n  "
+        "\"groups\": [\"users\", \"wheel\", \"audio\", \"video\"]}";
+    uint32_t const len = (uint32_t)strlen(json);
+    json_path_t path;
+    json_value_t value;
+
+    /* String element: slice excludes the quotes */
+    int passed = (json_find(json, len, "groups[2]", &value) == 0) &&
+                 (value.type == JSMN_STRING) && (value.len == 5u) &&
+                 (strncmp(value.p_start, "audio", 5) == 0);
+
+    /* Precompiled path, primitive value */
+    passed = passed && (json_path_compile("uid", &path) == 1) &&
+             (json_path_find(json, len, &path, &value) == 0) &&
+             (value.type == JSMN_PRIMITIVE) && (value.len == 4u) &&
+             (strncmp(value.p_start, "1000", 4) == 0);
+
+    /* Container value: slice includes the brackets */
+    passed = passed && (json_find(json, len, "groups", &value) == 0) &&
+             (value.type == JSMN_ARRAY) && (value.p_start[0] == '[') &&
+             (value.p_start[value.len - 1u] == ']');
+
+    /* Missing key, index past the end, bad path, truncated input */
+    passed = passed &&
+             (json_find(json, len, "shell", &value) == JSON_PATH_ERR_NOT_FOUND) &&
+             (json_find(json, len, "groups[4]", &value) == JSON_PATH_ERR_NOT_FOUND) &&
+             (json_find(json, len, "groups[x]", &value) == JSON_PATH_ERR_ARG) &&
+             (json_find(json, 40u, "groups[0]", &value) == JSON_PATH_ERR_MALFORMED);
+
+    report_test("Path Lookup Without Tokens", passed);
+}
+
+/* ============================================
+ * TEST 14: Generated Schema Parser and Writer
+ * ============================================ */
+void test_json_schema(void)
+{
+    char const json[] =
+        "{\"user\": \"johndoe\", \"admin\": false, \"uid\": 1000,\n  "
+        "\"groups\": [\"users\", \"wheel\", \"audio\", \"video\"]}";
+    char const canonical[] =
+        "{\"user\": \"johndoe\", \"admin\": false, \"uid\": 1000, "
+        "\"groups\": [\"users\", \"wheel\", \"audio\", \"video\"]}";
+    static json_msg_t msg;
+    static char out[128];
+    json_user_record_t const * p_rec = &msg.u.user_record;
+    int32_t written = 0;
+
+    /* Known message: struct filled straight from the text */
+    int passed = (json_msg_parse(json, strlen(json), &msg) == JSON_MSG_USER_RECORD) &&
+                 (p_rec->present == 0xFu) && (p_rec->uid == 1000) &&
+                 (p_rec->admin == FALSE) && (p_rec->user.len == 7u) &&
+                 (strncmp(p_rec->user.p_start, "johndoe", 7) == 0) &&
+                 (p_rec->groups_count == 4u) &&
+                 (strncmp(p_rec->groups[2].p_start, "audio", 5) == 0);
+
+    /* Writer reproduces the document (canonical spacing) */
+    written = json_msg_write(&msg, out, sizeof(out));
+    passed = passed && (written == (int32_t)(sizeof(canonical) - 1u)) &&
+             (memcmp(out, canonical, sizeof(canonical) - 1u) == 0) &&
+             (json_msg_write(&msg, out, 16u) == -2);
+
+    /* Second message type, and documents left to the generic path */
+    passed = passed &&
+             (json_msg_parse("{\"cmd\": \"profile\"}", 18u, &msg) == JSON_MSG_COMMAND) &&
+             (json_msg_parse("{\"uid\": 1.5}", 12u, &msg) == JSON_MSG_NONE) &&
+             (json_msg_parse("{\"user\": \"a\", \"x\": 1}", 21u, &msg) == JSON_MSG_NONE) &&
+             (json_msg_parse("{\"user\": \"a\"", 12u, &msg) == JSON_MSG_NONE);
+
+    report_test("Generated Schema Parser", passed);
+}
+
+/* ============================================
+ * TEST 15: CBOR Encoding From Source Slices
+ * ============================================ */
+void test_cbor_encode(void)
+{
+    char const json[] = "{\"uid\": 1000, \"x\": -2.25e3, \"ok\": true}";
+    static uint8_t const expected[] =
+    {
+        0xA3u,                                  /* map(3) */
+        0x63u, 'u', 'i', 'd', 0x19u, 0x03u, 0xE8u,
+        0x61u, 'x', 0xC4u, 0x82u, 0x01u, 0x38u, 0xE0u,  /* 4([1, -225]) */
+        0x62u, 'o', 'k', 0xF5u
+    };
+    static char out[32];
+    emit_t line;
+    uint32_t len = 0u;
+    uint32_t i;
+
+    emit_begin(&line);
+    cbor_head(&line, CBOR_MAJOR_MAP, 3u);
+    cbor_text(&line, &json[2], 3u);
+    cbor_primitive(&line, &json[8], 4u);
+    cbor_text(&line, &json[15], 1u);
+    cbor_primitive(&line, &json[19], 7u);
+    cbor_text(&line, &json[29], 2u);
+    cbor_primitive(&line, &json[34], 4u);
+
+    /* Flatten the slice list the UART would send */
+    for (i = 0u; (i < line.count) && (i < EMIT_MAX_SLICES); i++)
+    {
+        if ((len + line.slices[i].len) <= sizeof(out))
+        {
+            memcpy(&out[len], line.slices[i].p_data, line.slices[i].len);
+        }
+        len += line.slices[i].len;
+    }
+
+    /* Strings are slices of the source, not copies */
+    int passed = (line.count <= EMIT_MAX_SLICES) &&
+                 (len == sizeof(expected)) && (line.bytes == len) &&
+                 (memcmp(out, expected, sizeof(expected)) == 0) &&
+                 (line.slices[2].p_data == &json[2]);
+
+    /* Integer too wide for a head: sent as its text */
+    emit_begin(&line);
+    cbor_primitive(&line, "4294967296", 10u);
+    passed = passed && (line.count == 2u) && (line.bytes == 11u) &&
+             ((uint8_t)line.slices[0].p_data[0] == 0x6Au);
+
+    report_test("CBOR Encoding From Slices", passed);
+}
+
+/* ============================================
+ * TEST 16: Scheduler Priority and Re-run
+ * ============================================ */
+static char g_sched_order[8];
+static uint32_t g_sched_count = 0u;
+static uint32_t g_sched_parse_runs = 0u;
+
+static void sched_note(char const id)
+{
+    if (g_sched_count < sizeof(g_sched_order)) {
+        g_sched_order[g_sched_count] = id;
+    }
+    g_sched_count++;
+}
+
+static bool_t sched_stub_rx(void)
+{
+    sched_note('R');
+    return FALSE;
+}
+
+static bool_t sched_stub_parse(void)
+{
+    sched_note('P');
+    g_sched_parse_runs++;
+
+    /* More work once, then wait */
+    return (g_sched_parse_runs < 2u) ? TRUE : FALSE;
+}
+
+static bool_t sched_stub_housekeeping(void)
+{
+    sched_note('H');
+    return FALSE;
+}
+
+void test_sched_priority(void)
+{
+    uint32_t runs = 0u;
+    uint32_t const tick = delay_get_tick();
+
+    /* SysTick signals HOUSEKEEPING: start right after a tick so none
+     * lands in the middle of the check */
+    while (delay_get_tick() == tick) {
+        /* Wait for the next millisecond */
+    }
+
+    sched_init();
+    (void)sched_task_set(SCHED_TASK_RX, sched_stub_rx);
+    (void)sched_task_set(SCHED_TASK_PARSE, sched_stub_parse);
+    (void)sched_task_set(SCHED_TASK_HOUSEKEEPING, sched_stub_housekeeping);
+
+    /* Signalled lowest priority first; TX has no body */
+    sched_signal(SCHED_TASK_HOUSEKEEPING);
+    sched_signal(SCHED_TASK_PARSE);
+    sched_signal(SCHED_TASK_TX);
+    sched_signal(SCHED_TASK_RX);
+
+    while (sched_run_once() && (runs < 10u)) {
+        runs++;
+    }
+
+    /* RX, TX (consumed), PARSE twice, then HOUSEKEEPING */
+    int passed = (runs == 5u) && (g_sched_count == 4u) &&
+                 (memcmp(g_sched_order, "RPPH", 4u) == 0) &&
+                 (sched_run_once() == FALSE) &&
+                 (sched_task_set(SCHED_TASK_COUNT, sched_stub_rx) == -1);
+
+    sched_init();
+
+    report_test("Scheduler Priority and Re-run", passed);
+}
+
+/* ============================================
+ * TEST 17: Timer Wheel Expiry
+ * ============================================ */
+static volatile uint32_t g_timer_fired_at[4];
+static volatile uint32_t g_timer_fire_count = 0u;
+
+static void timer_note(void * p_ctx)
+{
+    /* Runs in SysTick_Handler: record the tick it fired on */
+    *(volatile uint32_t *)p_ctx = delay_get_tick();
+    g_timer_fire_count++;
+}
+
+void test_timer_wheel(void)
+{
+    static timer_entry_t timers[4];
+    uint32_t const tick = delay_get_tick();
+    uint32_t start;
+    uint32_t us_start;
+    uint32_t us_elapsed;
+    uint32_t i;
+
+    for (i = 0u; i < 4u; i++) {
+        g_timer_fired_at[i] = 0u;
+    }
+
+    /* Start all timers early in one millisecond */
+    while (delay_get_tick() == tick) {
+        /* Wait for the next millisecond */
+    }
+    start = delay_get_tick();
+    us_start = delay_get_us();
+
+    (void)timer_start(&timers[0], 3u, timer_note, (void *)&g_timer_fired_at[0]);
+    (void)timer_start(&timers[1], 70u, timer_note, (void *)&g_timer_fired_at[1]);
+    (void)timer_start(&timers[2], 64u, timer_note, (void *)&g_timer_fired_at[2]);
+    (void)timer_start(&timers[3], 5u, timer_note, (void *)&g_timer_fired_at[3]);
+    timer_stop(&timers[3]);
+
+    delay_nb(100);
+    us_elapsed = delay_get_us() - us_start;
+
+    /* Exact ticks, across a full turn (64) and beyond (70); the stopped
+     * timer never fires */
+    int passed = (g_timer_fire_count == 3u) &&
+                 (g_timer_fired_at[0] == (start + 3u)) &&
+                 (g_timer_fired_at[1] == (start + 70u)) &&
+                 (g_timer_fired_at[2] == (start + 64u)) &&
+                 (g_timer_fired_at[3] == 0u) &&
+                 (timer_active(&timers[1]) == FALSE) &&
+                 (timer_start(&timers[0], 0u, timer_note, NULL) == -1) &&
+                 (timer_start(NULL, 1u, timer_note, NULL) == -1) &&
+                 (us_elapsed >= 99000u) && (us_elapsed < 102000u);
+
+    report_test("Timer Wheel Expiry", passed);
+}
+
+/* ============================================
+ * TEST 18: Trace Ring Record and Dump
+ * ============================================ */
+void test_trace_ring(void)
+{
+    uint32_t pending_full;
+    uint32_t tries = 0u;
+    int32_t dumped = -2;
+    uint32_t i;
+
+    /* Only an event no handler records, so the count is exact */
+    trace_reset();
+    trace_set_mask(TRACE_MASK(TRACE_EV_RX_HOLD));
+    TRACE(TRACE_EV_JSON_STATE, 1u);
+
+    /* Two more than fit: the newest two are dropped */
+    for (i = 0u; i < (TRACE_RING_RECORDS + 2u); i++) {
+        TRACE(TRACE_EV_RX_HOLD, i);
+    }
+    pending_full = trace_pending();
+
+    /* Resumable dump: retry while the TX queue is full */
+    while ((dumped != 0) && (tries < 100u)) {
+        dumped = trace_dump();
+        delay_nb(10);
+        tries++;
+    }
+
+    int passed = (pending_full == TRACE_RING_RECORDS) &&
+                 (dumped == 0) &&
+                 (trace_pending() == 0u);
+
+    trace_reset();
+
+    report_test("Trace Ring Record and Dump", passed);
+}
+
+/* ============================================
+ * TEST 19: Streaming JSON Writer
+ * ============================================ */
+typedef struct {
+    char text[128];
+    uint32_t len;
+    uint32_t calls;
+    uint32_t limit;           /* Refuse chunks past this many bytes */
+} writer_capture_t;
+
+static int32_t writer_capture_sink(void * p_ctx, char const * p_data, uint32_t len)
+{
+    writer_capture_t * p_cap = (writer_capture_t *)p_ctx;
+
+    if ((p_cap->len + len) > p_cap->limit) {
+        return -2;
+    }
+
+    memcpy(&p_cap->text[p_cap->len], p_data, len);
+    p_cap->len += len;
+    p_cap->calls++;
+
+    return 0;
+}
+
+void test_json_writer(void)
+{
+    static char const expected[] =
+        "{\"id\":-2147483648,\"n\":[0,4294967295,true,null],"
+        "\"s\":\"a\\\"b\\\\\\n\\u0001\",\"o\":{}}\r\n";
+    static char const text[] = "a\"b\\\n\x01";
+    static writer_capture_t cap;
+    json_writer_t writer;
+    int32_t result;
+    int32_t misuse;
+    int32_t full;
+
+    memset(&cap, 0, sizeof(cap));
+    cap.limit = sizeof(cap.text);
+
+    json_writer_init(&writer, writer_capture_sink, &cap);
+    json_writer_begin_object(&writer);
+    json_writer_key(&writer, "id");
+    json_writer_int32(&writer, (-2147483647 - 1));
+    json_writer_key(&writer, "n");
+    json_writer_begin_array(&writer);
+    json_writer_uint32(&writer, 0u);
+    json_writer_uint32(&writer, 4294967295u);
+    json_writer_bool(&writer, TRUE);
+    json_writer_null(&writer);
+    json_writer_end_array(&writer);
+    json_writer_key(&writer, "s");
+    json_writer_string(&writer, text, sizeof(text) - 1u);
+    json_writer_key(&writer, "o");
+    json_writer_begin_object(&writer);
+    json_writer_end_object(&writer);
+    json_writer_end_object(&writer);
+    result = json_writer_finish(&writer);
+
+    /* Mismatched close: latched, nothing after it reaches the sink */
+    json_writer_init(&writer, writer_capture_sink, &cap);
+    json_writer_begin_object(&writer);
+    json_writer_end_array(&writer);
+    misuse = json_writer_finish(&writer);
+
+    /* A sink with no room for the second chunk */
+    cap.limit = cap.len + JSON_WRITER_CHUNK_BYTES;
+    json_writer_init(&writer, writer_capture_sink, &cap);
+    json_writer_string(&writer, expected, sizeof(expected) - 1u);
+    full = json_writer_finish(&writer);
+
+    int passed = (result == 0) && (misuse == -1) && (full == -2) &&
+                 (cap.calls >= 4u) &&
+                 (cap.len >= (sizeof(expected) - 1u)) &&
+                 (memcmp(cap.text, expected, sizeof(expected) - 1u) == 0);
+
+    report_test("Streaming JSON Writer", passed);
+}
+
+/* ============================================
+ * TEST 20: Typed Token Decoders
+ * ============================================ */
+void test_json_tok_decode(void)
+{
+    jsmn_parser_t parser;
+    jsmntok_t tokens[24];
+    int32_t i32_min = 0;
+    int32_t i32_max = 0;
+    uint32_t u32_max = 0u;
+    int32_t temp = 0;
+    int32_t whole = 0;
+    int32_t neg = 0;
+    bool_t admin = TRUE;
+    int32_t unused;
+    bool_t b_unused;
+
+    char const json[] =
+        "{\"a\": -2147483648, \"b\": 2147483647, \"c\": 4294967295, "
+        "\"d\": 2147483648, \"e\": 23.456, \"f\": 7, \"g\": -0.5, "
+        "\"h\": false, \"i\": 1e3, \"j\": 012, \"k\": \"5\"}";
+
+    jsmn_init(&parser);
+    int32_t count = jsmn_parse(&parser, json, strlen(json), tokens, 24u);
+
+    int passed = (count == 23) &&
+                 (json_tok_to_i32(json, &tokens[2], &i32_min) == JSON_TOK_OK) &&
+                 (json_tok_to_i32(json, &tokens[4], &i32_max) == JSON_TOK_OK) &&
+                 (json_tok_to_u32(json, &tokens[6], &u32_max) == JSON_TOK_OK) &&
+                 (json_tok_to_i32(json, &tokens[6], &unused) == JSON_TOK_ERR_RANGE) &&
+                 (json_tok_to_i32(json, &tokens[8], &unused) == JSON_TOK_ERR_RANGE) &&
+                 (json_tok_to_u32(json, &tokens[2], (uint32_t *)&unused) == JSON_TOK_ERR_RANGE) &&
+                 (json_tok_to_fixed(json, &tokens[10], 2u, &temp) == JSON_TOK_OK) &&
+                 (json_tok_to_i32(json, &tokens[10], &unused) == JSON_TOK_ERR_TYPE) &&
+                 (json_tok_to_fixed(json, &tokens[12], 3u, &whole) == JSON_TOK_OK) &&
+                 (json_tok_to_fixed(json, &tokens[14], 1u, &neg) == JSON_TOK_OK) &&
+                 (json_tok_to_bool(json, &tokens[16], &admin) == JSON_TOK_OK) &&
+                 (json_tok_to_bool(json, &tokens[12], &b_unused) == JSON_TOK_ERR_TYPE) &&
+                 (json_tok_to_i32(json, &tokens[18], &unused) == JSON_TOK_ERR_TYPE) &&
+                 (json_tok_to_i32(json, &tokens[20], &unused) == JSON_TOK_ERR_TYPE) &&
+                 (json_tok_to_i32(json, &tokens[22], &unused) == JSON_TOK_ERR_TYPE) &&
+                 (i32_min == (-2147483647 - 1)) && (i32_max == 2147483647) &&
+                 (u32_max == 4294967295u) && (temp == 2345) &&
+                 (whole == 7000) && (neg == -5) && (admin == FALSE);
+
+    report_test("Typed Token Decoders", passed);
+}
+
+/* ============================================
+ * TEST 21: Resumable Walk Matches the Blocking Walk
+ * ============================================ */
+typedef struct {
+    char text[160];
+    uint32_t len;
+    uint32_t lines;
+    int overflow;
+} walk_capture_t;
+
+static int32_t walk_capture_tap(void * p_ctx, uart_slice_t const * p_slices,
+                                uint32_t count)
+{
+    walk_capture_t * p_cap = (walk_capture_t *)p_ctx;
+    uint32_t i;
+
+    for (i = 0u; i < count; i++) {
+        if ((p_cap->len + p_slices[i].len) > sizeof(p_cap->text)) {
+            p_cap->overflow = 1;
+            return 0;
+        }
+        memcpy(&p_cap->text[p_cap->len], p_slices[i].p_data, p_slices[i].len);
+        p_cap->len += p_slices[i].len;
+    }
+    p_cap->lines++;
+    return 0;
+}
+
+void test_json_walk_resumable(void)
+{
+    /* What the old blocking walk (one sprintf line per field, spinning
+     * through the array) printed for the built-in document */
+    static char const expected[] =
+        "- User: johndoe\r\n"
+        "- Admin: false\r\n"
+        "- UID: 1000\r\n"
+        "- Groups:\r\n"
+        "  * users\r\n"
+        "  * wheel\r\n"
+        "  * audio\r\n"
+        "  * video\r\n";
+    static walk_capture_t cap;
+    uint32_t calls_to_finish = 0u;
+    uint32_t most_per_call = 0u;
+    uint32_t i;
+
+    memset(&cap, 0, sizeof(cap));
+    wait_tx_idle();
+
+    /* Built-in document (test build), token walk, no gaps, no batching */
+    json_process_init();
+    json_set_pacing_full_rate();
+    json_set_batching_off();
+    json_set_output(JSON_OUTPUT_TEXT);
+    emit_set_tap(walk_capture_tap, &cap);
+
+    for (i = 0u; i < 64u; i++) {
+        uint32_t const lines_before = cap.lines;
+
+        (void)json_process();
+
+        if ((cap.lines - lines_before) > most_per_call) {
+            most_per_call = cap.lines - lines_before;
+        }
+        if ((0u == calls_to_finish) && (cap.len >= (sizeof(expected) - 1u))) {
+            calls_to_finish = i + 1u;
+        }
+    }
+
+    emit_set_tap(NULL, NULL);
+
+    /* Same bytes in the same order, at most one line per step, and the
+     * array elements came from separate steps */
+    int passed = !cap.overflow && (cap.lines == 8u) &&
+                 (cap.len == (sizeof(expected) - 1u)) &&
+                 (memcmp(cap.text, expected, sizeof(expected) - 1u) == 0) &&
+                 (most_per_call == 1u) && (calls_to_finish >= 8u);
+
+    report_test("Resumable Walk Matches Blocking Walk", passed);
+}
+
 /* ============================================
  * TEST SUMMARY
  * ============================================ */
@@ -307,14 +981,28 @@ void print_summary(void)
     safe_transmit("  JSON Processing Test Summary\r\n");
     safe_transmit("========================================\r\n");
     
-    safe_transmit("Total Tests:  8\r\n");
+    safe_transmit("Total Tests:  21\r\n");
     
-    if (tests_passed == 8) {
-        safe_transmit("Passed:       8\r\n");
-    } else if (tests_passed == 7) {
-        safe_transmit("Passed:       7\r\n");
+    if (tests_passed == 21) {
+        safe_transmit("Passed:       21\r\n");
+    } else if (tests_passed == 20) {
+        safe_transmit("Passed:       20\r\n");
+    } else if (tests_passed == 19) {
+        safe_transmit("Passed:       19\r\n");
+    } else if (tests_passed == 18) {
+        safe_transmit("Passed:       18\r\n");
+    } else if (tests_passed == 17) {
+        safe_transmit("Passed:       17\r\n");
+    } else if (tests_passed == 16) {
+        safe_transmit("Passed:       16\r\n");
+    } else if (tests_passed == 15) {
+        safe_transmit("Passed:       15\r\n");
+    } else if (tests_passed == 14) {
+        safe_transmit("Passed:       14\r\n");
+    } else if (tests_passed == 13) {
+        safe_transmit("Passed:       13\r\n");
     } else if (tests_passed >= 5) {
-        safe_transmit("Passed:       5-6\r\n");
+        safe_transmit("Passed:       5-12\r\n");
     } else {
         safe_transmit("Passed:       <5\r\n");
     }
@@ -384,6 +1072,46 @@ int32_t main(void)
     test_json_extract_boolean();
     delay_nb(100);
     
+    test_json_stream_chunks();
+    delay_nb(100);
+    
+    test_json_long_strings();
+    delay_nb(100);
+    
+    test_json_open_object();
+    delay_nb(100);
+    
+    test_token_arena();
+    delay_nb(100);
+    
+    test_json_path_find();
+    delay_nb(100);
+    
+    test_json_schema();
+    delay_nb(100);
+    
+    test_cbor_encode();
+    delay_nb(100);
+    
+    test_sched_priority();
+    delay_nb(100);
+    
+    test_timer_wheel();
+    delay_nb(100);
+    
+    test_trace_ring();
+    delay_nb(100);
+    
+    test_json_writer();
+    delay_nb(100);
+    
+    test_json_tok_decode();
+    delay_nb(100);
+    
+    /* Last: re-runs json_process_init() (clock, UART, scheduler) */
+    test_json_walk_resumable();
+    delay_nb(100);
+    
     /* Print summary */
     print_summary();
     
@@ -0,0 +1,579 @@
+/** @file jsonschema.c
+ *
+ * @brief Scanner and writer used by the generated schema parsers.
+ *
+ * The scanner reads exactly the shapes a schema allows: one object of
+ * string / int32 / bool / string-array members. Anything else (nested
+ * objects, floats, unknown keys...) is reported as JSON_SCHEMA_NO_MATCH
+ * so the caller can fall back to the generic jsmn path, which also
+ * produces the proper error for documents that are really malformed.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "types.h"
+#include "jsonschema.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Longest decimal int32 text, "-2147483648" */
+#define JSON_INT32_TEXT_MAX     11u
+
+
+/*!
+ * @brief Skip whitespace.
+ *
+ * @return TRUE if a byte follows, FALSE at the end of the input.
+ */
+static bool_t
+json_scan_space (json_scan_t * const p_scan)
+{
+    while (p_scan->pos < p_scan->len)
+    {
+        char const c = p_scan->p_js[p_scan->pos];
+
+        if ((' ' != c) && ('\t' != c) && ('\n' != c) && ('\r' != c))
+        {
+            return ('\0' != c) ? TRUE : FALSE;
+        }
+
+        p_scan->pos++;
+    }
+
+    return FALSE;
+}
+
+
+/*!
+ * @brief Check for a byte that may follow a primitive.
+ */
+static bool_t
+json_scan_is_delim (char const c)
+{
+    switch (c)
+    {
+        case ',':
+        case '}':
+        case ']':
+        case ' ':
+        case '\t':
+        case '\r':
+        case '\n':
+            return TRUE;
+
+        default:
+            return FALSE;
+    }
+}
+
+
+/*!
+ * @brief Start scanning an object.
+ *
+ * @return 1 if members follow, 0 for an empty object, JSON_SCHEMA_NO_MATCH
+ *         if the document is not an object, or JSON_SCHEMA_ERR_MALFORMED.
+ */
+int32_t
+json_scan_object (json_scan_t * const p_scan, char const * const p_js,
+                  uint32_t const len)
+{
+    p_scan->p_js = p_js;
+    p_scan->len = len;
+    p_scan->pos = 0u;
+
+    if (!json_scan_space(p_scan))
+    {
+        return JSON_SCHEMA_ERR_MALFORMED;
+    }
+
+    if ('{' != p_js[p_scan->pos])
+    {
+        return JSON_SCHEMA_NO_MATCH;
+    }
+
+    p_scan->pos++;
+
+    if (!json_scan_space(p_scan))
+    {
+        return JSON_SCHEMA_ERR_MALFORMED;
+    }
+
+    if ('}' == p_js[p_scan->pos])
+    {
+        p_scan->pos++;
+        return 0;
+    }
+
+    return 1;
+}
+
+
+/*!
+ * @brief Read a member name and its ':'; the cursor ends on the value.
+ *
+ * @return JSON_SCHEMA_OK, or a negative result code.
+ */
+int32_t
+json_scan_key (json_scan_t * const p_scan, json_str_t * const p_key)
+{
+    int32_t result;
+
+    if (!json_scan_space(p_scan))
+    {
+        return JSON_SCHEMA_ERR_MALFORMED;
+    }
+
+    result = json_scan_string(p_scan, p_key);
+
+    if (JSON_SCHEMA_OK != result)
+    {
+        return result;
+    }
+
+    if (!json_scan_space(p_scan) || (':' != p_scan->p_js[p_scan->pos]))
+    {
+        return JSON_SCHEMA_ERR_MALFORMED;
+    }
+
+    p_scan->pos++;
+
+    return json_scan_space(p_scan) ? JSON_SCHEMA_OK : JSON_SCHEMA_ERR_MALFORMED;
+}
+
+
+/*!
+ * @brief Step past the separator after a member value.
+ *
+ * @return 1 if another member follows, 0 at the closing '}', or
+ *         JSON_SCHEMA_ERR_MALFORMED.
+ */
+int32_t
+json_scan_next (json_scan_t * const p_scan)
+{
+    char c;
+
+    if (!json_scan_space(p_scan))
+    {
+        return JSON_SCHEMA_ERR_MALFORMED;
+    }
+
+    c = p_scan->p_js[p_scan->pos];
+    p_scan->pos++;
+
+    if (',' == c)
+    {
+        return 1;
+    }
+
+    return ('}' == c) ? 0 : JSON_SCHEMA_ERR_MALFORMED;
+}
+
+
+/*!
+ * @brief Check that nothing but whitespace follows the object.
+ *
+ * @return JSON_SCHEMA_OK, or JSON_SCHEMA_NO_MATCH for trailing text.
+ */
+int32_t
+json_scan_end (json_scan_t * const p_scan)
+{
+    return json_scan_space(p_scan) ? JSON_SCHEMA_NO_MATCH : JSON_SCHEMA_OK;
+}
+
+
+/*!
+ * @brief Read a string value (slice without the quotes, not unescaped).
+ *
+ * @return JSON_SCHEMA_OK, JSON_SCHEMA_NO_MATCH if the value is not a
+ *         string, or JSON_SCHEMA_ERR_MALFORMED if it is not terminated.
+ */
+int32_t
+json_scan_string (json_scan_t * const p_scan, json_str_t * const p_out)
+{
+    char const * const p_js = p_scan->p_js;
+    uint32_t pos = p_scan->pos;
+
+    if ((pos >= p_scan->len) || ('"' != p_js[pos]))
+    {
+        return JSON_SCHEMA_NO_MATCH;
+    }
+
+    pos++;
+
+    while (pos < p_scan->len)
+    {
+        char const c = p_js[pos];
+
+        if ('"' == c)
+        {
+            p_out->p_start = &p_js[p_scan->pos + 1u];
+            p_out->len = pos - p_scan->pos - 1u;
+            p_scan->pos = pos + 1u;
+            return JSON_SCHEMA_OK;
+        }
+
+        if ('\\' == c)
+        {
+            /* Escaped byte (including \" and \\) cannot end the string */
+            pos += 2u;
+            continue;
+        }
+
+        if ('\0' == c)
+        {
+            break;
+        }
+
+        pos++;
+    }
+
+    return JSON_SCHEMA_ERR_MALFORMED;
+}
+
+
+/*!
+ * @brief Read a decimal integer that fits int32_t.
+ *
+ * Fractions, exponents, leading zeros and out-of-range values are
+ * JSON_SCHEMA_NO_MATCH: such a message is left to the generic path.
+ *
+ * @param[out] p_text Source text of the number (for zero-copy echo).
+ *
+ * @return JSON_SCHEMA_OK, or JSON_SCHEMA_NO_MATCH.
+ */
+int32_t
+json_scan_int32 (json_scan_t * const p_scan, int32_t * const p_out,
+                 json_str_t * const p_text)
+{
+    char const * const p_js = p_scan->p_js;
+    uint32_t const start = p_scan->pos;
+    uint32_t pos = start;
+    uint32_t units = 7u;            /* INT32_MAX = 214748364 * 10 + 7 */
+    uint32_t value = 0u;
+    bool_t b_negative = FALSE;
+
+    if ((pos < p_scan->len) && ('-' == p_js[pos]))
+    {
+        b_negative = TRUE;
+        units = 8u;
+        pos++;
+    }
+
+    if ((pos >= p_scan->len) || (p_js[pos] < '0') || (p_js[pos] > '9') ||
+        (('0' == p_js[pos]) && ((pos + 1u) < p_scan->len) &&
+         (p_js[pos + 1u] >= '0') && (p_js[pos + 1u] <= '9')))
+    {
+        return JSON_SCHEMA_NO_MATCH;
+    }
+
+    while ((pos < p_scan->len) && (p_js[pos] >= '0') && (p_js[pos] <= '9'))
+    {
+        uint32_t const digit = (uint32_t)(p_js[pos] - '0');
+
+        /* Range check without a division per digit */
+        if ((value > 214748364u) || ((214748364u == value) && (digit > units)))
+        {
+            return JSON_SCHEMA_NO_MATCH;
+        }
+
+        value = (value * 10u) + digit;
+        pos++;
+    }
+
+    if ((pos < p_scan->len) && !json_scan_is_delim(p_js[pos]))
+    {
+        return JSON_SCHEMA_NO_MATCH;
+    }
+
+    *p_out = b_negative ? (int32_t)(0u - value) : (int32_t)value;
+    p_text->p_start = &p_js[start];
+    p_text->len = pos - start;
+    p_scan->pos = pos;
+
+    return JSON_SCHEMA_OK;
+}
+
+
+/*!
+ * @brief Read true or false.
+ *
+ * @param[out] p_text Source text of the literal (for zero-copy echo).
+ *
+ * @return JSON_SCHEMA_OK, or JSON_SCHEMA_NO_MATCH.
+ */
+int32_t
+json_scan_bool (json_scan_t * const p_scan, bool_t * const p_out,
+                json_str_t * const p_text)
+{
+    char const * const p_at = &p_scan->p_js[p_scan->pos];
+    uint32_t const avail = p_scan->len - p_scan->pos;
+    uint32_t len;
+
+    if ((avail >= 4u) && (0 == memcmp(p_at, "true", 4u)))
+    {
+        *p_out = TRUE;
+        len = 4u;
+    }
+    else if ((avail >= 5u) && (0 == memcmp(p_at, "false", 5u)))
+    {
+        *p_out = FALSE;
+        len = 5u;
+    }
+    else
+    {
+        return JSON_SCHEMA_NO_MATCH;
+    }
+
+    if ((len < avail) && !json_scan_is_delim(p_at[len]))
+    {
+        return JSON_SCHEMA_NO_MATCH;
+    }
+
+    p_text->p_start = p_at;
+    p_text->len = len;
+    p_scan->pos += len;
+
+    return JSON_SCHEMA_OK;
+}
+
+
+/*!
+ * @brief Read an array of at most max strings.
+ *
+ * @param[out] p_text Source text of the whole array, brackets included.
+ *
+ * @return JSON_SCHEMA_OK, JSON_SCHEMA_NO_MATCH (not an array of strings,
+ *         or more than max), or JSON_SCHEMA_ERR_MALFORMED.
+ */
+int32_t
+json_scan_string_array (json_scan_t * const p_scan,
+                        json_str_t * const p_items, uint32_t const max,
+                        uint32_t * const p_count, json_str_t * const p_text)
+{
+    uint32_t const start = p_scan->pos;
+    uint32_t count = 0u;
+    char c;
+
+    if ((start >= p_scan->len) || ('[' != p_scan->p_js[start]))
+    {
+        return JSON_SCHEMA_NO_MATCH;
+    }
+
+    p_scan->pos++;
+
+    if (!json_scan_space(p_scan))
+    {
+        return JSON_SCHEMA_ERR_MALFORMED;
+    }
+
+    c = p_scan->p_js[p_scan->pos];
+
+    if (']' == c)
+    {
+        p_scan->pos++;
+    }
+
+    while (']' != c)
+    {
+        int32_t result;
+
+        if (count >= max)
+        {
+            return JSON_SCHEMA_NO_MATCH;
+        }
+
+        result = json_scan_string(p_scan, &p_items[count]);
+
+        if (JSON_SCHEMA_OK != result)
+        {
+            return result;
+        }
+
+        count++;
+
+        if (!json_scan_space(p_scan))
+        {
+            return JSON_SCHEMA_ERR_MALFORMED;
+        }
+
+        c = p_scan->p_js[p_scan->pos];
+        p_scan->pos++;
+
+        if (',' == c)
+        {
+            if (!json_scan_space(p_scan))
+            {
+                return JSON_SCHEMA_ERR_MALFORMED;
+            }
+        }
+        else if (']' != c)
+        {
+            return JSON_SCHEMA_ERR_MALFORMED;
+        }
+        else
+        {
+            /* Closing bracket consumed */
+        }
+    }
+
+    *p_count = count;
+    p_text->p_start = &p_scan->p_js[start];
+    p_text->len = p_scan->pos - start;
+
+    return JSON_SCHEMA_OK;
+}
+
+
+/*!
+ * @brief Start writing into a buffer.
+ */
+void
+json_out_init (json_out_t * const p_out, char * const p_buf,
+               uint32_t const size)
+{
+    p_out->p_buf = p_buf;
+    p_out->size = size;
+    p_out->len = 0u;
+    p_out->b_overflow = FALSE;
+}
+
+
+/*!
+ * @brief Append bytes; on overflow the output is marked and stops growing.
+ */
+void
+json_out_raw (json_out_t * const p_out, char const * const p_data,
+              uint32_t const len)
+{
+    if ((TRUE == p_out->b_overflow) || (len > (p_out->size - p_out->len)))
+    {
+        p_out->b_overflow = TRUE;
+        return;
+    }
+
+    (void)memcpy(&p_out->p_buf[p_out->len], p_data, len);
+    p_out->len += len;
+}
+
+
+/*!
+ * @brief Append a member name: "key": (with ", " before all but the first).
+ */
+void
+json_out_key (json_out_t * const p_out, char const * const p_key,
+              uint32_t const key_len, bool_t const b_first)
+{
+    if (FALSE == b_first)
+    {
+        json_out_raw(p_out, ", ", 2u);
+    }
+
+    json_out_raw(p_out, "\"", 1u);
+    json_out_raw(p_out, p_key, key_len);
+    json_out_raw(p_out, "\": ", 3u);
+}
+
+
+/*!
+ * @brief Append a string value (slice is still escaped, written as is).
+ */
+void
+json_out_string (json_out_t * const p_out, json_str_t const * const p_str)
+{
+    json_out_raw(p_out, "\"", 1u);
+    json_out_raw(p_out, p_str->p_start, p_str->len);
+    json_out_raw(p_out, "\"", 1u);
+}
+
+
+/*!
+ * @brief Append a decimal integer.
+ */
+void
+json_out_int32 (json_out_t * const p_out, int32_t const value)
+{
+    char text[JSON_INT32_TEXT_MAX];
+    uint32_t pos = JSON_INT32_TEXT_MAX;
+    uint32_t magnitude = (value < 0) ? (0u - (uint32_t)value) : (uint32_t)value;
+
+    do
+    {
+        pos--;
+        text[pos] = (char)('0' + (magnitude % 10u));
+        magnitude /= 10u;
+    } while (0u != magnitude);
+
+    if (value < 0)
+    {
+        pos--;
+        text[pos] = '-';
+    }
+
+    json_out_raw(p_out, &text[pos], JSON_INT32_TEXT_MAX - pos);
+}
+
+
+/*!
+ * @brief Append true or false.
+ */
+void
+json_out_bool (json_out_t * const p_out, bool_t const value)
+{
+    if (TRUE == value)
+    {
+        json_out_raw(p_out, "true", 4u);
+    }
+    else
+    {
+        json_out_raw(p_out, "false", 5u);
+    }
+}
+
+
+/*!
+ * @brief Append an array of strings.
+ */
+void
+json_out_string_array (json_out_t * const p_out,
+                       json_str_t const * const p_items, uint32_t const count)
+{
+    uint32_t i;
+
+    json_out_raw(p_out, "[", 1u);
+
+    for (i = 0u; i < count; i++)
+    {
+        if (0u != i)
+        {
+            json_out_raw(p_out, ", ", 2u);
+        }
+
+        json_out_string(p_out, &p_items[i]);
+    }
+
+    json_out_raw(p_out, "]", 1u);
+}
+
+
+/*!
+ * @brief Finish the output.
+ *
+ * @return Bytes written, or -2 if the buffer was too small.
+ */
+int32_t
+json_out_finish (json_out_t * const p_out)
+{
+    return (TRUE == p_out->b_overflow) ? -2 : (int32_t)p_out->len;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/*** end of file ***/
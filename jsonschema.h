@@ -0,0 +1,116 @@
+/** @file jsonschema.h
+ *
+ * @brief Runtime for the generated schema parsers (gen_schema.py).
+ *
+ * Message types listed in jsonschema.def are compiled by gen_schema.py
+ * into jsonschema_gen.h / jsonschema_gen.c: one flat struct per message,
+ * a parser that fills it straight from the text (no jsmntok_t array)
+ * and a writer that serializes it again. The generated code is built on
+ * the small scanner and writer below.
+ *
+ * Strings are not copied or unescaped: a json_str_t is a slice of the
+ * source text (bounds as a jsmn string token), valid as long as the
+ * source buffer is.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#ifndef JSONSCHEMA_H
+#define JSONSCHEMA_H
+
+#include <stdint.h>
+#include "types.h"
+
+/* Result codes of the scanner and the generated parsers */
+#define JSON_SCHEMA_OK            0
+#define JSON_SCHEMA_ERR_ARG       (-1)   /* NULL pointer */
+#define JSON_SCHEMA_NO_MATCH      (-2)   /* Valid so far, but not this message */
+#define JSON_SCHEMA_ERR_MALFORMED (-3)   /* Truncated or invalid document */
+
+/* Field types understood by gen_schema.py */
+typedef enum
+{
+    JSON_FIELD_STRING = 0,
+    JSON_FIELD_INT32,
+    JSON_FIELD_BOOL,
+    JSON_FIELD_STRING_ARRAY
+} json_field_type_t;
+
+/* Slice of the source text */
+typedef struct
+{
+    char const * p_start;
+    uint32_t len;
+} json_str_t;
+
+/* Member of a message type (tables generated from jsonschema.def) */
+typedef struct
+{
+    char const * p_key;
+    uint32_t key_len;
+    json_field_type_t type;
+} json_field_desc_t;
+
+/* Generic view of one field of a parsed message (see json_msg_field()) */
+typedef struct
+{
+    char const * p_key;
+    uint32_t key_len;
+    json_field_type_t type;
+    json_str_t value;             /* Value text, jsmn token bounds */
+    json_str_t const * p_items;   /* JSON_FIELD_STRING_ARRAY elements */
+    uint32_t item_count;
+} json_field_view_t;
+
+/* Scan cursor */
+typedef struct
+{
+    char const * p_js;
+    uint32_t len;
+    uint32_t pos;
+} json_scan_t;
+
+/* Serializer output buffer */
+typedef struct
+{
+    char * p_buf;
+    uint32_t size;
+    uint32_t len;
+    bool_t b_overflow;
+} json_out_t;
+
+/* Scanner (used by jsonschema_gen.c) */
+int32_t json_scan_object(json_scan_t * const p_scan, char const * const p_js,
+                         uint32_t const len);
+int32_t json_scan_key(json_scan_t * const p_scan, json_str_t * const p_key);
+int32_t json_scan_next(json_scan_t * const p_scan);
+int32_t json_scan_end(json_scan_t * const p_scan);
+int32_t json_scan_string(json_scan_t * const p_scan, json_str_t * const p_out);
+int32_t json_scan_int32(json_scan_t * const p_scan, int32_t * const p_out,
+                        json_str_t * const p_text);
+int32_t json_scan_bool(json_scan_t * const p_scan, bool_t * const p_out,
+                       json_str_t * const p_text);
+int32_t json_scan_string_array(json_scan_t * const p_scan,
+                               json_str_t * const p_items, uint32_t const max,
+                               uint32_t * const p_count,
+                               json_str_t * const p_text);
+
+/* Writer (used by jsonschema_gen.c) */
+void json_out_init(json_out_t * const p_out, char * const p_buf,
+                   uint32_t const size);
+void json_out_raw(json_out_t * const p_out, char const * const p_data,
+                  uint32_t const len);
+void json_out_key(json_out_t * const p_out, char const * const p_key,
+                  uint32_t const key_len, bool_t const b_first);
+void json_out_string(json_out_t * const p_out, json_str_t const * const p_str);
+void json_out_int32(json_out_t * const p_out, int32_t const value);
+void json_out_bool(json_out_t * const p_out, bool_t const value);
+void json_out_string_array(json_out_t * const p_out,
+                           json_str_t const * const p_items,
+                           uint32_t const count);
+int32_t json_out_finish(json_out_t * const p_out);
+
+#endif /* JSONSCHEMA_H */
+
+/*** end of file ***/
@@ -0,0 +1,532 @@
+/** @file jsonschema_gen.c
+ *
+ * @brief Schema message parsers and writers (GENERATED - do not edit).
+ *
+ * Generated by gen_schema.py from jsonschema.def.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "types.h"
+#include "jsonschema.h"
+#include "jsonschema_gen.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Members of user_record, in field order */
+static json_field_desc_t const g_user_record_fields[JSON_USER_RECORD_FIELD_COUNT] =
+{
+    { "user", 4u, JSON_FIELD_STRING },
+    { "admin", 5u, JSON_FIELD_BOOL },
+    { "uid", 3u, JSON_FIELD_INT32 },
+    { "groups", 6u, JSON_FIELD_STRING_ARRAY }
+};
+
+/* Members of command, in field order */
+static json_field_desc_t const g_command_fields[JSON_COMMAND_FIELD_COUNT] =
+{
+    { "cmd", 3u, JSON_FIELD_STRING }
+};
+
+
+/*!
+ * @brief Parse a user_record message without tokenizing it.
+ *
+ * @return JSON_SCHEMA_OK, JSON_SCHEMA_NO_MATCH if the document is not a
+ *         user_record, or JSON_SCHEMA_ERR_ARG / _ERR_MALFORMED.
+ */
+int32_t
+json_user_record_parse (char const * const p_js, uint32_t const len,
+                        json_user_record_t * const p_out)
+{
+    json_scan_t scan;
+    json_str_t key;
+    int32_t result;
+
+    if ((NULL == p_js) || (NULL == p_out))
+    {
+        return JSON_SCHEMA_ERR_ARG;
+    }
+
+    p_out->present = 0u;
+    p_out->count = 0u;
+    result = json_scan_object(&scan, p_js, len);
+
+    while (1 == result)
+    {
+        uint32_t field = JSON_USER_RECORD_FIELD_COUNT;
+
+        result = json_scan_key(&scan, &key);
+
+        if (JSON_SCHEMA_OK != result)
+        {
+            return result;
+        }
+
+        switch (key.len)
+        {
+            case 3u:
+            {
+                if (0 == memcmp(key.p_start, "uid", 3u))
+                {
+                    field = 2u;
+                    result = json_scan_int32(&scan, &p_out->uid, &p_out->text[2u]);
+                }
+                break;
+            }
+
+            case 4u:
+            {
+                if (0 == memcmp(key.p_start, "user", 4u))
+                {
+                    field = 0u;
+                    result = json_scan_string(&scan, &p_out->user);
+                    p_out->text[0u] = p_out->user;
+                }
+                break;
+            }
+
+            case 5u:
+            {
+                if (0 == memcmp(key.p_start, "admin", 5u))
+                {
+                    field = 1u;
+                    result = json_scan_bool(&scan, &p_out->admin, &p_out->text[1u]);
+                }
+                break;
+            }
+
+            case 6u:
+            {
+                if (0 == memcmp(key.p_start, "groups", 6u))
+                {
+                    field = 3u;
+                    result = json_scan_string_array(&scan, p_out->groups,
+                                                    JSON_USER_RECORD_GROUPS_MAX,
+                                                    &p_out->groups_count,
+                                                    &p_out->text[3u]);
+                }
+                break;
+            }
+
+            default:
+            {
+                break;
+            }
+        }
+
+        if (JSON_USER_RECORD_FIELD_COUNT == field)
+        {
+            return JSON_SCHEMA_NO_MATCH;   /* Not a member of this message */
+        }
+
+        if (JSON_SCHEMA_OK != result)
+        {
+            return result;
+        }
+
+        if (0u != (p_out->present & (1u << field)))
+        {
+            return JSON_SCHEMA_NO_MATCH;   /* Duplicate key */
+        }
+
+        p_out->present |= (1u << field);
+        p_out->order[p_out->count] = (uint8_t)field;
+        p_out->count++;
+        result = json_scan_next(&scan);
+    }
+
+    if (JSON_SCHEMA_OK != result)
+    {
+        return result;
+    }
+
+    return json_scan_end(&scan);
+}
+
+
+/*!
+ * @brief Serialize a user_record message (present fields only).
+ *
+ * @return Bytes written, -1 on a NULL pointer, -2 if p_buf is too small.
+ */
+int32_t
+json_user_record_write (json_user_record_t const * const p_msg,
+                        char * const p_buf, uint32_t const size)
+{
+    json_out_t out;
+    bool_t b_first = TRUE;
+
+    if ((NULL == p_msg) || (NULL == p_buf))
+    {
+        return JSON_SCHEMA_ERR_ARG;
+    }
+
+    json_out_init(&out, p_buf, size);
+    json_out_raw(&out, "{", 1u);
+
+    if (0u != (p_msg->present & JSON_USER_RECORD_HAS_USER))
+    {
+        json_out_key(&out, "user", 4u, b_first);
+        json_out_string(&out, &p_msg->user);
+        b_first = FALSE;
+    }
+
+    if (0u != (p_msg->present & JSON_USER_RECORD_HAS_ADMIN))
+    {
+        json_out_key(&out, "admin", 5u, b_first);
+        json_out_bool(&out, p_msg->admin);
+        b_first = FALSE;
+    }
+
+    if (0u != (p_msg->present & JSON_USER_RECORD_HAS_UID))
+    {
+        json_out_key(&out, "uid", 3u, b_first);
+        json_out_int32(&out, p_msg->uid);
+        b_first = FALSE;
+    }
+
+    if (0u != (p_msg->present & JSON_USER_RECORD_HAS_GROUPS))
+    {
+        json_out_key(&out, "groups", 6u, b_first);
+        json_out_string_array(&out, p_msg->groups, p_msg->groups_count);
+        b_first = FALSE;
+    }
+
+    json_out_raw(&out, "}", 1u);
+
+    return json_out_finish(&out);
+}
+
+
+/*!
+ * @brief Parse a command message without tokenizing it.
+ *
+ * @return JSON_SCHEMA_OK, JSON_SCHEMA_NO_MATCH if the document is not a
+ *         command, or JSON_SCHEMA_ERR_ARG / _ERR_MALFORMED.
+ */
+int32_t
+json_command_parse (char const * const p_js, uint32_t const len,
+                    json_command_t * const p_out)
+{
+    json_scan_t scan;
+    json_str_t key;
+    int32_t result;
+
+    if ((NULL == p_js) || (NULL == p_out))
+    {
+        return JSON_SCHEMA_ERR_ARG;
+    }
+
+    p_out->present = 0u;
+    p_out->count = 0u;
+    result = json_scan_object(&scan, p_js, len);
+
+    while (1 == result)
+    {
+        uint32_t field = JSON_COMMAND_FIELD_COUNT;
+
+        result = json_scan_key(&scan, &key);
+
+        if (JSON_SCHEMA_OK != result)
+        {
+            return result;
+        }
+
+        switch (key.len)
+        {
+            case 3u:
+            {
+                if (0 == memcmp(key.p_start, "cmd", 3u))
+                {
+                    field = 0u;
+                    result = json_scan_string(&scan, &p_out->cmd);
+                    p_out->text[0u] = p_out->cmd;
+                }
+                break;
+            }
+
+            default:
+            {
+                break;
+            }
+        }
+
+        if (JSON_COMMAND_FIELD_COUNT == field)
+        {
+            return JSON_SCHEMA_NO_MATCH;   /* Not a member of this message */
+        }
+
+        if (JSON_SCHEMA_OK != result)
+        {
+            return result;
+        }
+
+        if (0u != (p_out->present & (1u << field)))
+        {
+            return JSON_SCHEMA_NO_MATCH;   /* Duplicate key */
+        }
+
+        p_out->present |= (1u << field);
+        p_out->order[p_out->count] = (uint8_t)field;
+        p_out->count++;
+        result = json_scan_next(&scan);
+    }
+
+    if (JSON_SCHEMA_OK != result)
+    {
+        return result;
+    }
+
+    return json_scan_end(&scan);
+}
+
+
+/*!
+ * @brief Serialize a command message (present fields only).
+ *
+ * @return Bytes written, -1 on a NULL pointer, -2 if p_buf is too small.
+ */
+int32_t
+json_command_write (json_command_t const * const p_msg,
+                    char * const p_buf, uint32_t const size)
+{
+    json_out_t out;
+    bool_t b_first = TRUE;
+
+    if ((NULL == p_msg) || (NULL == p_buf))
+    {
+        return JSON_SCHEMA_ERR_ARG;
+    }
+
+    json_out_init(&out, p_buf, size);
+    json_out_raw(&out, "{", 1u);
+
+    if (0u != (p_msg->present & JSON_COMMAND_HAS_CMD))
+    {
+        json_out_key(&out, "cmd", 3u, b_first);
+        json_out_string(&out, &p_msg->cmd);
+        b_first = FALSE;
+    }
+
+    json_out_raw(&out, "}", 1u);
+
+    return json_out_finish(&out);
+}
+
+
+/*!
+ * @brief Parse a document as the first message type it matches.
+ *
+ * @return The message type, or JSON_MSG_NONE if none matches (use the
+ *         generic jsmn path then).
+ */
+json_msg_id_t
+json_msg_parse (char const * const p_js, uint32_t const len,
+                json_msg_t * const p_out)
+{
+    int32_t result = JSON_SCHEMA_NO_MATCH;
+
+    if (NULL == p_out)
+    {
+        return JSON_MSG_NONE;
+    }
+
+    /* Stop at the first match; a malformed document matches nothing */
+    if (JSON_SCHEMA_NO_MATCH == result)
+    {
+        result = json_user_record_parse(p_js, len, &p_out->u.user_record);
+        p_out->id = JSON_MSG_USER_RECORD;
+    }
+
+    if (JSON_SCHEMA_NO_MATCH == result)
+    {
+        result = json_command_parse(p_js, len, &p_out->u.command);
+        p_out->id = JSON_MSG_COMMAND;
+    }
+
+    if (JSON_SCHEMA_OK != result)
+    {
+        p_out->id = JSON_MSG_NONE;
+    }
+
+    return p_out->id;
+}
+
+
+/*!
+ * @brief Serialize any parsed message.
+ *
+ * @return Bytes written, -1 for JSON_MSG_NONE or a NULL pointer, -2 if
+ *         p_buf is too small.
+ */
+int32_t
+json_msg_write (json_msg_t const * const p_msg, char * const p_buf,
+                uint32_t const size)
+{
+    if (NULL == p_msg)
+    {
+        return JSON_SCHEMA_ERR_ARG;
+    }
+
+    switch (p_msg->id)
+    {
+        case JSON_MSG_USER_RECORD:
+        {
+            return json_user_record_write(&p_msg->u.user_record, p_buf, size);
+        }
+
+        case JSON_MSG_COMMAND:
+        {
+            return json_command_write(&p_msg->u.command, p_buf, size);
+        }
+
+        default:
+        {
+            return JSON_SCHEMA_ERR_ARG;
+        }
+    }
+}
+
+
+/*!
+ * @brief Number of fields of the message's type (0 for JSON_MSG_NONE).
+ */
+uint32_t
+json_msg_field_count (json_msg_t const * const p_msg)
+{
+    switch (p_msg->id)
+    {
+        case JSON_MSG_USER_RECORD:
+        {
+            return JSON_USER_RECORD_FIELD_COUNT;
+        }
+
+        case JSON_MSG_COMMAND:
+        {
+            return JSON_COMMAND_FIELD_COUNT;
+        }
+
+        default:
+        {
+            return 0u;
+        }
+    }
+}
+
+
+/*!
+ * @brief Field index of the member at a position in the document.
+ *
+ * @return Field index for json_msg_field(), or json_msg_field_count()
+ *         once position is past the last member.
+ */
+uint32_t
+json_msg_order (json_msg_t const * const p_msg, uint32_t const position)
+{
+    switch (p_msg->id)
+    {
+        case JSON_MSG_USER_RECORD:
+        {
+            json_user_record_t const * const p_rec = &p_msg->u.user_record;
+
+            return (position < p_rec->count) ? p_rec->order[position] :
+                                               JSON_USER_RECORD_FIELD_COUNT;
+        }
+
+        case JSON_MSG_COMMAND:
+        {
+            json_command_t const * const p_rec = &p_msg->u.command;
+
+            return (position < p_rec->count) ? p_rec->order[position] :
+                                               JSON_COMMAND_FIELD_COUNT;
+        }
+
+        default:
+        {
+            return 0u;
+        }
+    }
+}
+
+
+/*!
+ * @brief Generic view of field index (in jsonschema.def order).
+ *
+ * @return 0 if the field is present, -2 if it is absent, -1 if index
+ *         is out of range.
+ */
+int32_t
+json_msg_field (json_msg_t const * const p_msg, uint32_t const index,
+                json_field_view_t * const p_view)
+{
+    json_field_desc_t const * p_desc = NULL;
+    json_str_t const * p_text = NULL;
+    uint32_t present = 0u;
+
+    p_view->p_items = NULL;
+    p_view->item_count = 0u;
+
+    if (index >= json_msg_field_count(p_msg))
+    {
+        return -1;
+    }
+
+    switch (p_msg->id)
+    {
+        case JSON_MSG_USER_RECORD:
+        {
+            json_user_record_t const * const p_rec = &p_msg->u.user_record;
+
+            p_desc = &g_user_record_fields[index];
+            p_text = &p_rec->text[index];
+            present = p_rec->present;
+
+            if (3u == index)
+            {
+                p_view->p_items = p_rec->groups;
+                p_view->item_count = p_rec->groups_count;
+            }
+            break;
+        }
+
+        case JSON_MSG_COMMAND:
+        {
+            json_command_t const * const p_rec = &p_msg->u.command;
+
+            p_desc = &g_command_fields[index];
+            p_text = &p_rec->text[index];
+            present = p_rec->present;
+            break;
+        }
+
+        default:
+        {
+            return -1;
+        }
+    }
+
+    if (0u == (present & (1u << index)))
+    {
+        return -2;
+    }
+
+    p_view->p_key = p_desc->p_key;
+    p_view->key_len = p_desc->key_len;
+    p_view->type = p_desc->type;
+    p_view->value = *p_text;
+
+    return 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/*** end of file ***/
@@ -0,0 +1,92 @@
+/** @file jsonschema_gen.h
+ *
+ * @brief Schema message structs and parsers (GENERATED - do not edit).
+ *
+ * Generated by gen_schema.py from jsonschema.def.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#ifndef JSONSCHEMA_GEN_H
+#define JSONSCHEMA_GEN_H
+
+#include <stdint.h>
+#include "types.h"
+#include "jsonschema.h"
+
+/* Message types, in the order json_msg_parse() tries them */
+typedef enum
+{
+    JSON_MSG_NONE = 0,
+    JSON_MSG_USER_RECORD,
+    JSON_MSG_COMMAND
+} json_msg_id_t;
+
+/* user_record */
+#define JSON_USER_RECORD_FIELD_COUNT         4u
+#define JSON_USER_RECORD_GROUPS_MAX          4u
+#define JSON_USER_RECORD_HAS_USER            (1u << 0)
+#define JSON_USER_RECORD_HAS_ADMIN           (1u << 1)
+#define JSON_USER_RECORD_HAS_UID             (1u << 2)
+#define JSON_USER_RECORD_HAS_GROUPS          (1u << 3)
+
+typedef struct
+{
+    uint32_t present;           /* JSON_USER_RECORD_HAS_* bits */
+    json_str_t user;
+    bool_t admin;
+    int32_t uid;
+    json_str_t groups[JSON_USER_RECORD_GROUPS_MAX];
+    uint32_t groups_count;
+    json_str_t text[JSON_USER_RECORD_FIELD_COUNT];  /* Value text per field */
+    uint8_t order[JSON_USER_RECORD_FIELD_COUNT];  /* Field of each member, document order */
+    uint32_t count;             /* Members in the document */
+} json_user_record_t;
+
+/* command */
+#define JSON_COMMAND_FIELD_COUNT             1u
+#define JSON_COMMAND_HAS_CMD                 (1u << 0)
+
+typedef struct
+{
+    uint32_t present;           /* JSON_COMMAND_HAS_* bits */
+    json_str_t cmd;
+    json_str_t text[JSON_COMMAND_FIELD_COUNT];  /* Value text per field */
+    uint8_t order[JSON_COMMAND_FIELD_COUNT];  /* Field of each member, document order */
+    uint32_t count;             /* Members in the document */
+} json_command_t;
+
+/* Any message */
+typedef struct
+{
+    json_msg_id_t id;
+    union
+    {
+        json_user_record_t user_record;
+        json_command_t command;
+    } u;
+} json_msg_t;
+
+/* Public API functions */
+int32_t json_user_record_parse(char const * const p_js, uint32_t const len,
+                               json_user_record_t * const p_out);
+int32_t json_user_record_write(json_user_record_t const * const p_msg,
+                               char * const p_buf, uint32_t const size);
+int32_t json_command_parse(char const * const p_js, uint32_t const len,
+                           json_command_t * const p_out);
+int32_t json_command_write(json_command_t const * const p_msg,
+                           char * const p_buf, uint32_t const size);
+json_msg_id_t json_msg_parse(char const * const p_js, uint32_t const len,
+                             json_msg_t * const p_out);
+int32_t json_msg_write(json_msg_t const * const p_msg, char * const p_buf,
+                       uint32_t const size);
+uint32_t json_msg_field_count(json_msg_t const * const p_msg);
+uint32_t json_msg_order(json_msg_t const * const p_msg,
+                        uint32_t const position);
+int32_t json_msg_field(json_msg_t const * const p_msg, uint32_t const index,
+                       json_field_view_t * const p_view);
+
+#endif /* JSONSCHEMA_GEN_H */
+
+/*** end of file ***/
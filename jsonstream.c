@@ -0,0 +1,378 @@
+/** @file jsonstream.c
+ *
+ * @brief Incremental JSON front end implementation.
+ *
+ * JSMN already keeps its position and open-token state in jsmn_parser_t
+ * and reports JSMN_ERROR_PART for truncated input; this module turns that
+ * into a streaming parser. Each new chunk resumes at parser.pos instead
+ * of rescanning from offset 0. A message is complete as soon as the root
+ * token has its end set. Bytes after it are kept for the next message.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "jsmn.h"
+#include "uart.h"
+#include "profile.h"
+#include "jsonstream.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*!
+ * @brief Check if a byte may be part of a JSON primitive (number/literal).
+ *
+ * A primitive at the very end of the buffer may still be growing; JSMN
+ * (non-strict) would close it at the buffer end, so such bytes are held
+ * back until a delimiter arrives.
+ */
+static int32_t
+json_stream_is_primitive_char (char const c)
+{
+    return (((c >= '0') && (c <= '9')) || ((c >= 'a') && (c <= 'z')) ||
+            ((c >= 'A') && (c <= 'Z')) || ('-' == c) || ('+' == c) ||
+            ('.' == c)) ? 1 : 0;
+}
+
+
+/*!
+ * @brief Drop the first count buffered bytes and restart the parser.
+ */
+static void
+json_stream_consume (json_stream_t * const p_stream, uint32_t const count)
+{
+    uint32_t remaining = p_stream->length - count;
+
+    if (0u != remaining)
+    {
+        (void)memmove(p_stream->buffer, &p_stream->buffer[count], remaining);
+    }
+
+    p_stream->length = remaining;
+    jsmn_init(&p_stream->parser);
+}
+
+
+/*!
+ * @brief Report and drop everything buffered (JSON_STREAM_ERR_* code).
+ */
+static void
+json_stream_discard (json_stream_t * const p_stream, int32_t const code)
+{
+    if (NULL != p_stream->on_message)
+    {
+        (void)p_stream->on_message(p_stream->p_ctx, p_stream->buffer,
+                                   p_stream->length, NULL, code);
+    }
+
+    json_stream_consume(p_stream, p_stream->length);
+}
+
+
+/*!
+ * @brief Parse as far as the buffered bytes allow, delivering messages.
+ *
+ * @return Number of messages delivered (including discarded ones).
+ */
+static int32_t
+json_stream_scan (json_stream_t * const p_stream)
+{
+    int32_t delivered = 0;
+
+    for (;;)
+    {
+        uint32_t skip = 0u;
+        uint32_t safe_len;
+        int32_t result;
+
+        /* Between messages: discard anything before the next root */
+        if (0u == p_stream->parser.toknext)
+        {
+            while ((skip < p_stream->length) &&
+                   ('{' != p_stream->buffer[skip]) &&
+                   ('[' != p_stream->buffer[skip]))
+            {
+                skip++;
+            }
+
+            if (0u != skip)
+            {
+                json_stream_consume(p_stream, skip);
+            }
+        }
+
+        if (0u == p_stream->length)
+        {
+            break;
+        }
+
+        safe_len = p_stream->length;
+        while ((safe_len > 0u) &&
+               json_stream_is_primitive_char(p_stream->buffer[safe_len - 1u]))
+        {
+            safe_len--;
+        }
+
+        PROFILE_START(parse_start);
+        result = jsmn_parse(&p_stream->parser, p_stream->buffer, safe_len,
+                            p_stream->tokens, JSON_STREAM_MAX_TOKENS);
+        PROFILE_STOP(PROFILE_JSMN_PARSE, parse_start);
+
+        if ((p_stream->parser.toknext >= 1u) && (JSMN_NONE != p_stream->tokens[0].end))
+        {
+            /* Root closed: tokens past its end belong to the next message */
+            uint32_t msg_len = (uint32_t)p_stream->tokens[0].end;
+            int32_t count = 1;
+
+            while (((uint32_t)count < p_stream->parser.toknext) &&
+                   ((uint32_t)p_stream->tokens[count].start < msg_len))
+            {
+                count++;
+            }
+
+            if ((NULL != p_stream->on_message) &&
+                (0 != p_stream->on_message(p_stream->p_ctx, p_stream->buffer,
+                                           msg_len, p_stream->tokens, count)))
+            {
+                /* Receiver is busy: keep the message and offer it again */
+                p_stream->b_held = TRUE;
+                break;
+            }
+
+            p_stream->b_held = FALSE;
+            json_stream_consume(p_stream, msg_len);
+            delivered++;
+            continue;
+        }
+
+        if ((result >= 0) || (JSMN_ERROR_PART == result))
+        {
+            /* Need more input */
+            break;
+        }
+
+        /* Invalid or too many tokens: report and resynchronise */
+        if (NULL != p_stream->on_message)
+        {
+            (void)p_stream->on_message(p_stream->p_ctx, p_stream->buffer,
+                                       p_stream->length, NULL, result);
+        }
+
+        json_stream_consume(p_stream, p_stream->length);
+        delivered++;
+    }
+
+    return delivered;
+}
+
+
+#if (UART_FRAMING == UART_FRAMING_SLIP)
+/*!
+ * @brief Scan a buffered frame; whatever it leaves over is an error.
+ *
+ * A frame holds whole messages, so a partial one at its end can never
+ * complete and is reported with JSON_STREAM_ERR_FRAME.
+ */
+static int32_t
+json_stream_scan_frame (json_stream_t * const p_stream)
+{
+    int32_t delivered = json_stream_scan(p_stream);
+
+    if ((FALSE == p_stream->b_held) && (0u != p_stream->length))
+    {
+        json_stream_discard(p_stream, JSON_STREAM_ERR_FRAME);
+        delivered++;
+    }
+
+    return delivered;
+}
+#endif
+
+
+/*!
+ * @brief Initialize a stream.
+ *
+ * @param[out] p_stream Pointer to stream state.
+ * @param[in] on_message Callback for completed or discarded messages.
+ * @param[in] p_ctx User pointer passed to the callback.
+ */
+void
+json_stream_init (json_stream_t * const p_stream,
+                  json_stream_cb_t const on_message, void * const p_ctx)
+{
+    p_stream->length = 0u;
+    p_stream->on_message = on_message;
+    p_stream->p_ctx = p_ctx;
+    p_stream->b_held = FALSE;
+    jsmn_init(&p_stream->parser);
+}
+
+
+/*!
+ * @brief Feed a chunk of bytes into the stream.
+ *
+ * Chunks may split the input anywhere, including inside strings and
+ * numbers. A message that outgrows the buffer is reported with
+ * JSON_STREAM_ERR_OVERFLOW and dropped. While the callback refuses a
+ * complete message, bytes that no longer fit are dropped; use
+ * json_stream_poll_uart() for lossless backpressure.
+ *
+ * @param[in,out] p_stream Pointer to stream state.
+ * @param[in] p_data Chunk data.
+ * @param[in] len Chunk length.
+ *
+ * @return Number of messages delivered, or -1 if arguments are NULL.
+ */
+int32_t
+json_stream_feed (json_stream_t * const p_stream,
+                  char const * const p_data, uint32_t const len)
+{
+    uint32_t offset = 0u;
+    int32_t delivered = 0;
+
+    if ((NULL == p_stream) || (NULL == p_data))
+    {
+        return -1;
+    }
+
+    while (offset < len)
+    {
+        uint32_t space = JSON_STREAM_BUFFER_SIZE - p_stream->length;
+        uint32_t chunk = len - offset;
+
+        if (0u == space)
+        {
+            if (p_stream->b_held)
+            {
+                delivered += json_stream_scan(p_stream);
+
+                if (p_stream->b_held)
+                {
+                    break;
+                }
+            }
+            else
+            {
+                json_stream_discard(p_stream, JSON_STREAM_ERR_OVERFLOW);
+                delivered++;
+            }
+            continue;
+        }
+
+        if (chunk > space)
+        {
+            chunk = space;
+        }
+
+        (void)memcpy(&p_stream->buffer[p_stream->length], &p_data[offset], chunk);
+        p_stream->length += chunk;
+        offset += chunk;
+
+        delivered += json_stream_scan(p_stream);
+    }
+
+    return delivered;
+}
+
+
+/*!
+ * @brief Pull whatever the UART RX ring holds into the stream.
+ *
+ * Reads straight into the stream buffer (no intermediate copy). Requires
+ * continuous reception started with uart_rx_start(). While the callback
+ * refuses a message nothing is read, so input waits in the RX ring.
+ *
+ * In UART_FRAMING_SLIP one whole frame is read at a time: messages end
+ * with the frame, not with bytes the next chunk may bring. A frame too
+ * big for the buffer is reported with JSON_STREAM_ERR_OVERFLOW.
+ *
+ * @param[in,out] p_stream Pointer to stream state.
+ *
+ * @return Number of messages delivered, or -1 if p_stream is NULL.
+ */
+int32_t
+json_stream_poll_uart (json_stream_t * const p_stream)
+{
+    int32_t delivered = 0;
+#if (UART_FRAMING == UART_FRAMING_SLIP)
+    int32_t frame;
+#else
+    uint32_t space;
+    uint32_t got;
+#endif
+
+    if (NULL == p_stream)
+    {
+        return -1;
+    }
+
+#if (UART_FRAMING == UART_FRAMING_SLIP)
+    if (p_stream->b_held)
+    {
+        delivered = json_stream_scan_frame(p_stream);
+
+        if (p_stream->b_held)
+        {
+            return delivered;
+        }
+    }
+
+    frame = uart_rx_read_frame(p_stream->buffer, JSON_STREAM_BUFFER_SIZE);
+
+    if (frame < 0)
+    {
+        json_stream_discard(p_stream, JSON_STREAM_ERR_OVERFLOW);
+        return delivered + 1;
+    }
+
+    if (0 == frame)
+    {
+        return delivered;
+    }
+
+    p_stream->length = (uint32_t)frame;
+
+    return delivered + json_stream_scan_frame(p_stream);
+#else
+    if (p_stream->b_held)
+    {
+        delivered = json_stream_scan(p_stream);
+
+        if (p_stream->b_held)
+        {
+            return delivered;
+        }
+    }
+
+    space = JSON_STREAM_BUFFER_SIZE - p_stream->length;
+
+    if (0u == space)
+    {
+        /* Full buffer with no complete message: it can never complete */
+        json_stream_discard(p_stream, JSON_STREAM_ERR_OVERFLOW);
+        return delivered + 1;
+    }
+
+    got = uart_rx_read(&p_stream->buffer[p_stream->length], space);
+    if (0u == got)
+    {
+        return delivered;
+    }
+
+    p_stream->length += got;
+
+    return delivered + json_stream_scan(p_stream);
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/*** end of file ***/
@@ -0,0 +1,68 @@
+/** @file jsonstream.h
+ *
+ * @brief Incremental JSON front end: feeds byte chunks into JSMN.
+ *
+ * Accumulates bytes as they arrive (e.g. from the UART RX ring) and
+ * resumes the JSMN parser across chunk boundaries, so parsing overlaps
+ * wire time. A callback fires once per completed top-level object/array.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#ifndef JSONSTREAM_H
+#define JSONSTREAM_H
+
+#include <stdint.h>
+#include "jsmn.h"
+#include "types.h"
+
+/* Largest single message (bytes) the stream can hold */
+#define JSON_STREAM_BUFFER_SIZE   256u
+
+/* Maximum tokens per message */
+#define JSON_STREAM_MAX_TOKENS    32u
+
+/* Stream-level error codes (reported alongside jsmn's negative codes) */
+#define JSON_STREAM_ERR_OVERFLOW  (-10)   /* Message larger than the buffer */
+#define JSON_STREAM_ERR_FRAME     (-11)   /* Frame ended inside a message */
+
+/*!
+ * @brief Message callback.
+ *
+ * @param[in] p_ctx User context given to json_stream_init().
+ * @param[in] p_js Message text (valid only during the callback).
+ * @param[in] len Message length in bytes.
+ * @param[in] p_tokens Parsed tokens, p_tokens[0] being the root.
+ * @param[in] num_tokens Token count, or a negative JSMN_ERROR_* /
+ *            JSON_STREAM_ERR_* code if the message was discarded.
+ *
+ * @return 0 if the message was taken, -2 to refuse a complete message
+ *         for now (it stays buffered and is offered again on the next
+ *         feed/poll). The result is ignored for discarded messages.
+ */
+typedef int32_t (*json_stream_cb_t)(void * p_ctx, char const * p_js, uint32_t len,
+                                    jsmntok_t const * p_tokens, int32_t num_tokens);
+
+/* Stream state */
+typedef struct
+{
+    char buffer[JSON_STREAM_BUFFER_SIZE];
+    uint32_t length;                    /* Bytes currently buffered */
+    jsmn_parser_t parser;               /* Resumable parser state */
+    jsmntok_t tokens[JSON_STREAM_MAX_TOKENS];
+    json_stream_cb_t on_message;
+    void * p_ctx;
+    bool_t b_held;                      /* Complete message refused by callback */
+} json_stream_t;
+
+/* Public API functions */
+void json_stream_init(json_stream_t * const p_stream,
+                      json_stream_cb_t const on_message, void * const p_ctx);
+int32_t json_stream_feed(json_stream_t * const p_stream,
+                         char const * const p_data, uint32_t const len);
+int32_t json_stream_poll_uart(json_stream_t * const p_stream);
+
+#endif /* JSONSTREAM_H */
+
+/*** end of file ***/
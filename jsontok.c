@@ -0,0 +1,353 @@
+/** @file jsontok.c
+ *
+ * @brief Typed token decoder implementation.
+ *
+ * All numeric decoders share json_tok_number(): sign, integer digits
+ * and, for fixed point, the fraction, accumulated as an unsigned
+ * magnitude. The overflow check compares against the limit split into
+ * tens and units (constants), so no digit needs a division, and the
+ * value is scaled by ten with (v << 3) + (v << 1).
+ *
+ * Exponents ("1e3") are valid JSON, but no telemetry encoder sends
+ * integers that way; they are reported as JSON_TOK_ERR_TYPE rather than
+ * paying for the scaling on every number.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include "types.h"
+#include "jsmn.h"
+#include "jsontok.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* UINT32_MAX and INT32_MAX (+1 when negative) as tens and units */
+#define JSON_TOK_U32_TENS        429496729u
+#define JSON_TOK_U32_UNITS       5u
+#define JSON_TOK_I32_TENS        214748364u
+#define JSON_TOK_I32_UNITS_POS   7u
+#define JSON_TOK_I32_UNITS_NEG   8u
+
+/* Decoded number: magnitude and sign */
+typedef struct
+{
+    uint32_t magnitude;
+    bool_t b_negative;
+} json_tok_num_t;
+
+
+/*!
+ * @brief Append a decimal digit: value = value * 10 + digit.
+ *
+ * @return FALSE if the result would pass tens * 10 + units.
+ */
+static inline bool_t
+json_tok_digit (uint32_t * const p_value, uint32_t const digit,
+                uint32_t const tens, uint32_t const units)
+{
+    uint32_t const value = *p_value;
+
+    if ((value > tens) || ((value == tens) && (digit > units)))
+    {
+        return FALSE;
+    }
+
+    *p_value = (value << 3) + (value << 1) + digit;
+
+    return TRUE;
+}
+
+
+/*!
+ * @brief Check a byte is a decimal digit and give its value.
+ */
+static inline bool_t
+json_tok_is_digit (char const c, uint32_t * const p_digit)
+{
+    uint32_t const digit = (uint32_t)(uint8_t)c - (uint32_t)'0';
+
+    *p_digit = digit;
+
+    return (digit <= 9u) ? TRUE : FALSE;
+}
+
+
+/*!
+ * @brief Decode a JSON number token in one pass.
+ *
+ * @param[in] decimals Fraction digits to keep (0 = integer only: a
+ *                     fraction is a type error).
+ * @param[in] b_signed FALSE to allow only values >= 0.
+ * @param[out] p_num   Magnitude scaled by 10^decimals, and sign.
+ *
+ * @return JSON_TOK_OK, JSON_TOK_ERR_TYPE or JSON_TOK_ERR_RANGE.
+ */
+static int32_t
+json_tok_number (char const * const p_js, jsmntok_t const * const p_tok,
+                 uint32_t const decimals, bool_t const b_signed,
+                 json_tok_num_t * const p_num)
+{
+    uint32_t pos;
+    uint32_t end;
+    uint32_t digit;
+    uint32_t tens = JSON_TOK_U32_TENS;
+    uint32_t units = JSON_TOK_U32_UNITS;
+    uint32_t kept = 0u;
+    bool_t b_range = TRUE;
+
+    if ((NULL == p_js) || (NULL == p_tok) ||
+        (JSMN_PRIMITIVE != p_tok->type) || (p_tok->end <= p_tok->start))
+    {
+        return JSON_TOK_ERR_TYPE;
+    }
+
+    pos = (uint32_t)p_tok->start;
+    end = (uint32_t)p_tok->end;
+    p_num->magnitude = 0u;
+    p_num->b_negative = FALSE;
+
+    if ('-' == p_js[pos])
+    {
+        p_num->b_negative = TRUE;
+        pos++;
+    }
+
+    if (b_signed)
+    {
+        tens = JSON_TOK_I32_TENS;
+        units = p_num->b_negative ? JSON_TOK_I32_UNITS_NEG :
+                                    JSON_TOK_I32_UNITS_POS;
+    }
+
+    /* Integer part: at least one digit, no leading zeros */
+    if ((pos >= end) || (FALSE == json_tok_is_digit(p_js[pos], &digit)))
+    {
+        return JSON_TOK_ERR_TYPE;
+    }
+
+    if ((0u == digit) && ((pos + 1u) < end) &&
+        json_tok_is_digit(p_js[pos + 1u], &digit))
+    {
+        return JSON_TOK_ERR_TYPE;
+    }
+
+    while ((pos < end) && json_tok_is_digit(p_js[pos], &digit))
+    {
+        /* Keep checking the syntax after an overflow */
+        if (b_range)
+        {
+            b_range = json_tok_digit(&p_num->magnitude, digit, tens, units);
+        }
+        pos++;
+    }
+
+    /* Fraction: digits past the kept ones are truncated */
+    if ((pos < end) && ('.' == p_js[pos]))
+    {
+        if (0u == decimals)
+        {
+            return JSON_TOK_ERR_TYPE;
+        }
+
+        pos++;
+
+        if ((pos >= end) || (FALSE == json_tok_is_digit(p_js[pos], &digit)))
+        {
+            return JSON_TOK_ERR_TYPE;
+        }
+
+        while ((pos < end) && json_tok_is_digit(p_js[pos], &digit))
+        {
+            if (b_range && (kept < decimals))
+            {
+                b_range = json_tok_digit(&p_num->magnitude, digit, tens, units);
+                kept++;
+            }
+            pos++;
+        }
+    }
+
+    if (pos != end)
+    {
+        /* Exponent, or anything else that is not a plain number */
+        return JSON_TOK_ERR_TYPE;
+    }
+
+    while (b_range && (kept < decimals))
+    {
+        b_range = json_tok_digit(&p_num->magnitude, 0u, tens, units);
+        kept++;
+    }
+
+    if ((FALSE == b_range) ||
+        ((FALSE == b_signed) && p_num->b_negative && (0u != p_num->magnitude)))
+    {
+        return JSON_TOK_ERR_RANGE;
+    }
+
+    return JSON_TOK_OK;
+}
+
+
+/*!
+ * @brief Decode an integer token as int32_t.
+ *
+ * @param[in] p_js  JSON text the token indexes.
+ * @param[in] p_tok Token to decode.
+ * @param[out] p_out Value; untouched on error.
+ *
+ * @return JSON_TOK_OK, JSON_TOK_ERR_TYPE if the token is not an integer
+ *         (a fraction or exponent included), JSON_TOK_ERR_RANGE if it is
+ *         outside INT32_MIN..INT32_MAX.
+ */
+int32_t
+json_tok_to_i32 (char const * const p_js, jsmntok_t const * const p_tok,
+                 int32_t * const p_out)
+{
+    json_tok_num_t num;
+    int32_t result;
+
+    if (NULL == p_out)
+    {
+        return JSON_TOK_ERR_TYPE;
+    }
+
+    result = json_tok_number(p_js, p_tok, 0u, TRUE, &num);
+
+    if (JSON_TOK_OK == result)
+    {
+        *p_out = num.b_negative ? (int32_t)(0u - num.magnitude) :
+                                  (int32_t)num.magnitude;
+    }
+
+    return result;
+}
+
+
+/*!
+ * @brief Decode an integer token as uint32_t.
+ *
+ * @return JSON_TOK_OK, JSON_TOK_ERR_TYPE as json_tok_to_i32(), or
+ *         JSON_TOK_ERR_RANGE if it is negative or above UINT32_MAX.
+ */
+int32_t
+json_tok_to_u32 (char const * const p_js, jsmntok_t const * const p_tok,
+                 uint32_t * const p_out)
+{
+    json_tok_num_t num;
+    int32_t result;
+
+    if (NULL == p_out)
+    {
+        return JSON_TOK_ERR_TYPE;
+    }
+
+    result = json_tok_number(p_js, p_tok, 0u, FALSE, &num);
+
+    if (JSON_TOK_OK == result)
+    {
+        *p_out = num.magnitude;
+    }
+
+    return result;
+}
+
+
+/*!
+ * @brief Decode a true / false token.
+ *
+ * @return JSON_TOK_OK, or JSON_TOK_ERR_TYPE for any other token.
+ */
+int32_t
+json_tok_to_bool (char const * const p_js, jsmntok_t const * const p_tok,
+                  bool_t * const p_out)
+{
+    static char const text_true[] = "true";
+    static char const text_false[] = "false";
+    char const * p_text;
+    uint32_t len;
+    uint32_t i;
+
+    if ((NULL == p_js) || (NULL == p_tok) || (NULL == p_out) ||
+        (JSMN_PRIMITIVE != p_tok->type))
+    {
+        return JSON_TOK_ERR_TYPE;
+    }
+
+    len = (uint32_t)(p_tok->end - p_tok->start);
+
+    if ((sizeof(text_true) - 1u) == len)
+    {
+        p_text = text_true;
+    }
+    else if ((sizeof(text_false) - 1u) == len)
+    {
+        p_text = text_false;
+    }
+    else
+    {
+        return JSON_TOK_ERR_TYPE;
+    }
+
+    for (i = 0u; i < len; i++)
+    {
+        if (p_js[(uint32_t)p_tok->start + i] != p_text[i])
+        {
+            return JSON_TOK_ERR_TYPE;
+        }
+    }
+
+    *p_out = (p_text == text_true) ? TRUE : FALSE;
+
+    return JSON_TOK_OK;
+}
+
+
+/*!
+ * @brief Decode a number token as fixed point: value * 10^decimals.
+ *
+ * "23.456" with 2 decimals gives 2345: fraction digits beyond decimals
+ * are truncated (towards zero), missing ones count as zeros, and an
+ * integer such as "7" gives 700.
+ *
+ * @param[in] decimals Fraction digits to keep, 1..JSON_TOK_MAX_DECIMALS.
+ * @param[out] p_out   Scaled value; untouched on error.
+ *
+ * @return JSON_TOK_OK, JSON_TOK_ERR_TYPE if the token is not a plain
+ *         number (or decimals is out of range), JSON_TOK_ERR_RANGE if
+ *         the scaled value does not fit int32_t.
+ */
+int32_t
+json_tok_to_fixed (char const * const p_js, jsmntok_t const * const p_tok,
+                   uint32_t const decimals, int32_t * const p_out)
+{
+    json_tok_num_t num;
+    int32_t result;
+
+    if ((NULL == p_out) || (0u == decimals) ||
+        (decimals > JSON_TOK_MAX_DECIMALS))
+    {
+        return JSON_TOK_ERR_TYPE;
+    }
+
+    result = json_tok_number(p_js, p_tok, decimals, TRUE, &num);
+
+    if (JSON_TOK_OK == result)
+    {
+        *p_out = num.b_negative ? (int32_t)(0u - num.magnitude) :
+                                  (int32_t)num.magnitude;
+    }
+
+    return result;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/*** end of file ***/
@@ -0,0 +1,42 @@
+/** @file jsontok.h
+ *
+ * @brief Typed decoders for jsmn primitive tokens.
+ *
+ * jsmn only marks where a value is; these read it. Each decoder checks
+ * the token is a JSMN_PRIMITIVE, checks the JSON syntax of the whole
+ * token, and converts it in the same single pass over the text.
+ * Overflow is detected as digits arrive, and nothing calls libc or the
+ * software division helpers: times ten is a shift and an add.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#ifndef JSONTOK_H
+#define JSONTOK_H
+
+#include <stdint.h>
+#include "types.h"
+#include "jsmn.h"
+
+/* Result codes */
+#define JSON_TOK_OK              0
+#define JSON_TOK_ERR_TYPE        (-1)   /* NULL, not a primitive of this kind */
+#define JSON_TOK_ERR_RANGE       (-2)   /* Well-formed, but does not fit */
+
+/* Most fraction digits json_tok_to_fixed() can keep */
+#define JSON_TOK_MAX_DECIMALS    9u
+
+/* Public API functions */
+int32_t json_tok_to_i32(char const * const p_js, jsmntok_t const * const p_tok,
+                        int32_t * const p_out);
+int32_t json_tok_to_u32(char const * const p_js, jsmntok_t const * const p_tok,
+                        uint32_t * const p_out);
+int32_t json_tok_to_bool(char const * const p_js, jsmntok_t const * const p_tok,
+                         bool_t * const p_out);
+int32_t json_tok_to_fixed(char const * const p_js, jsmntok_t const * const p_tok,
+                          uint32_t const decimals, int32_t * const p_out);
+
+#endif /* JSONTOK_H */
+
+/*** end of file ***/
@@ -0,0 +1,611 @@
+/** @file jsonwriter.c
+ *
+ * @brief Streaming JSON writer implementation.
+ *
+ * Output collects in the writer's chunk and goes to the sink each time
+ * the chunk fills, and once more from json_writer_finish(). The nesting
+ * is two 32-bit masks (array or object, member written yet) indexed by
+ * depth, so the whole state is the chunk plus a few words. The first
+ * error is latched: after it nothing more reaches the sink and
+ * json_writer_finish() reports it.
+ *
+ * Cortex-M0+ has no divide instruction, so integers are formatted by
+ * subtracting powers of ten - at most 9 subtractions per digit - instead
+ * of calling the library division for every digit.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include "types.h"
+#include "uart.h"
+#include "jsonwriter.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (JSON_WRITER_CHUNK_BYTES < 8u)
+#error "JSON_WRITER_CHUNK_BYTES must be at least 8"
+#endif
+
+/* Error codes latched in json_writer_t.error */
+#define JSON_WRITER_ERR_MISUSE   (-1)
+#define JSON_WRITER_ERR_FULL     (-2)
+
+#define JSON_WRITER_BIT(level)   (1u << (level))
+
+static char const g_hex_digits[16] = "0123456789abcdef";
+
+/* Powers of ten for the division-free digit loop, highest first */
+static uint32_t const g_pow10[9] =
+{
+    1000000000u, 100000000u, 10000000u, 1000000u, 100000u,
+    10000u, 1000u, 100u, 10u
+};
+
+
+/*!
+ * @brief Pass the collected chunk to the sink.
+ */
+static void
+json_writer_flush (json_writer_t * const p_writer)
+{
+    if ((0u != p_writer->fill) && (0 == p_writer->error))
+    {
+        if (0 != p_writer->p_sink(p_writer->p_ctx, p_writer->chunk,
+                                  p_writer->fill))
+        {
+            p_writer->error = JSON_WRITER_ERR_FULL;
+        }
+    }
+
+    p_writer->fill = 0u;
+}
+
+
+/*!
+ * @brief Append one byte, flushing the chunk when it fills.
+ */
+static inline void
+json_writer_put (json_writer_t * const p_writer, char const c)
+{
+    if (0 != p_writer->error)
+    {
+        return;
+    }
+
+    p_writer->chunk[p_writer->fill] = c;
+    p_writer->fill++;
+
+    if (JSON_WRITER_CHUNK_BYTES == p_writer->fill)
+    {
+        json_writer_flush(p_writer);
+    }
+}
+
+
+/*!
+ * @brief Append a string as a JSON string literal, escaped.
+ *
+ * Quote, backslash and control characters are escaped; every other byte
+ * (UTF-8 included) is copied as it is.
+ */
+static void
+json_writer_put_string (json_writer_t * const p_writer,
+                        char const * const p_str, uint32_t const len)
+{
+    uint32_t i;
+
+    json_writer_put(p_writer, '"');
+
+    for (i = 0u; i < len; i++)
+    {
+        uint8_t const byte = (uint8_t)p_str[i];
+
+        if (('"' == byte) || ('\\' == byte))
+        {
+            json_writer_put(p_writer, '\\');
+            json_writer_put(p_writer, (char)byte);
+        }
+        else if (byte < 0x20u)
+        {
+            json_writer_put(p_writer, '\\');
+
+            switch (byte)
+            {
+                case '\b': json_writer_put(p_writer, 'b'); break;
+                case '\f': json_writer_put(p_writer, 'f'); break;
+                case '\n': json_writer_put(p_writer, 'n'); break;
+                case '\r': json_writer_put(p_writer, 'r'); break;
+                case '\t': json_writer_put(p_writer, 't'); break;
+                default:
+                {
+                    json_writer_put(p_writer, 'u');
+                    json_writer_put(p_writer, '0');
+                    json_writer_put(p_writer, '0');
+                    json_writer_put(p_writer, g_hex_digits[byte >> 4]);
+                    json_writer_put(p_writer, g_hex_digits[byte & 0x0Fu]);
+                    break;
+                }
+            }
+        }
+        else
+        {
+            json_writer_put(p_writer, (char)byte);
+        }
+    }
+
+    json_writer_put(p_writer, '"');
+}
+
+
+/*!
+ * @brief Append a decimal number without dividing.
+ */
+static void
+json_writer_put_u32 (json_writer_t * const p_writer, uint32_t value)
+{
+    char text[10];
+    char const * p_end = json_writer_format_u32(text, value);
+    char const * p_text;
+
+    for (p_text = text; p_text < p_end; p_text++)
+    {
+        json_writer_put(p_writer, *p_text);
+    }
+}
+
+
+/*!
+ * @brief Latch a misuse error (unless an error is already latched).
+ */
+static void
+json_writer_misuse (json_writer_t * const p_writer)
+{
+    if (0 == p_writer->error)
+    {
+        p_writer->error = JSON_WRITER_ERR_MISUSE;
+    }
+}
+
+
+/*!
+ * @brief Check that a value may come next and write its separator.
+ *
+ * In an object a value must follow its key; in an array every value but
+ * the first is preceded by a comma.
+ *
+ * @return TRUE if the value may be written.
+ */
+static bool_t
+json_writer_value_start (json_writer_t * const p_writer)
+{
+    uint32_t level;
+
+    if (0u == p_writer->depth)
+    {
+        return TRUE;
+    }
+
+    level = p_writer->depth - 1u;
+
+    if (0u == (p_writer->array_mask & JSON_WRITER_BIT(level)))
+    {
+        if (FALSE == p_writer->b_after_key)
+        {
+            json_writer_misuse(p_writer);
+            return FALSE;
+        }
+
+        p_writer->b_after_key = FALSE;
+        return TRUE;
+    }
+
+    if (0u != (p_writer->member_mask & JSON_WRITER_BIT(level)))
+    {
+        json_writer_put(p_writer, ',');
+    }
+    p_writer->member_mask |= JSON_WRITER_BIT(level);
+
+    return TRUE;
+}
+
+
+/*!
+ * @brief Open an object or array.
+ */
+static void
+json_writer_open (json_writer_t * const p_writer, bool_t const b_array)
+{
+    uint32_t const level = p_writer->depth;
+
+    if (FALSE == json_writer_value_start(p_writer))
+    {
+        return;
+    }
+
+    if (level >= JSON_WRITER_MAX_DEPTH)
+    {
+        json_writer_misuse(p_writer);
+        return;
+    }
+
+    json_writer_put(p_writer, b_array ? '[' : '{');
+
+    if (b_array)
+    {
+        p_writer->array_mask |= JSON_WRITER_BIT(level);
+    }
+    else
+    {
+        p_writer->array_mask &= ~JSON_WRITER_BIT(level);
+    }
+    p_writer->member_mask &= ~JSON_WRITER_BIT(level);
+    p_writer->depth = level + 1u;
+}
+
+
+/*!
+ * @brief Close the innermost object or array, if it is of that kind.
+ */
+static void
+json_writer_close (json_writer_t * const p_writer, bool_t const b_array)
+{
+    uint32_t level;
+
+    if ((0u == p_writer->depth) || p_writer->b_after_key)
+    {
+        json_writer_misuse(p_writer);
+        return;
+    }
+
+    level = p_writer->depth - 1u;
+
+    if (b_array != ((0u != (p_writer->array_mask & JSON_WRITER_BIT(level))) ?
+                    TRUE : FALSE))
+    {
+        json_writer_misuse(p_writer);
+        return;
+    }
+
+    json_writer_put(p_writer, b_array ? ']' : '}');
+    p_writer->depth = level;
+}
+
+
+/*!
+ * @brief Format a decimal number into a plain buffer without dividing.
+ *
+ * Writes at most 10 characters and no terminator.
+ *
+ * @return The new write position.
+ */
+char *
+json_writer_format_u32 (char * p_out, uint32_t value)
+{
+    bool_t b_leading = TRUE;
+    uint32_t i;
+
+    for (i = 0u; i < (sizeof(g_pow10) / sizeof(g_pow10[0])); i++)
+    {
+        char digit = '0';
+
+        while (value >= g_pow10[i])
+        {
+            value -= g_pow10[i];
+            digit++;
+        }
+
+        if (('0' != digit) || (FALSE == b_leading))
+        {
+            *p_out = digit;
+            p_out++;
+            b_leading = FALSE;
+        }
+    }
+
+    *p_out = (char)('0' + value);
+    p_out++;
+
+    return p_out;
+}
+
+
+/*!
+ * @brief Copy a null-terminated string into a plain buffer, without the
+ *        terminator.
+ *
+ * @return The new write position.
+ */
+char *
+json_writer_format_str (char * p_out, char const * p_str)
+{
+    while ('\0' != *p_str)
+    {
+        *p_out = *p_str;
+        p_out++;
+        p_str++;
+    }
+
+    return p_out;
+}
+
+
+/*!
+ * @brief Start a document.
+ *
+ * @param[out] p_writer Writer state (usually on the caller's stack).
+ * @param[in] p_sink    Receives the output, one chunk per call.
+ * @param[in] p_ctx     Passed to the sink unchanged.
+ */
+void
+json_writer_init (json_writer_t * const p_writer,
+                  json_writer_sink_t const p_sink, void * const p_ctx)
+{
+    if (NULL == p_writer)
+    {
+        return;
+    }
+
+    p_writer->fill = 0u;
+    p_writer->depth = 0u;
+    p_writer->array_mask = 0u;
+    p_writer->member_mask = 0u;
+    p_writer->b_after_key = FALSE;
+    p_writer->error = (NULL == p_sink) ? JSON_WRITER_ERR_MISUSE : 0;
+    p_writer->p_sink = p_sink;
+    p_writer->p_ctx = p_ctx;
+}
+
+
+/*!
+ * @brief Open an object (as a value: top level, array element or after a key).
+ */
+void
+json_writer_begin_object (json_writer_t * const p_writer)
+{
+    json_writer_open(p_writer, FALSE);
+}
+
+
+/*!
+ * @brief Close the innermost object.
+ */
+void
+json_writer_end_object (json_writer_t * const p_writer)
+{
+    json_writer_close(p_writer, FALSE);
+}
+
+
+/*!
+ * @brief Open an array (as a value).
+ */
+void
+json_writer_begin_array (json_writer_t * const p_writer)
+{
+    json_writer_open(p_writer, TRUE);
+}
+
+
+/*!
+ * @brief Close the innermost array.
+ */
+void
+json_writer_end_array (json_writer_t * const p_writer)
+{
+    json_writer_close(p_writer, TRUE);
+}
+
+
+/*!
+ * @brief Write the key of the next object member.
+ *
+ * @param[in] p_key Null-terminated key, escaped as needed.
+ */
+void
+json_writer_key (json_writer_t * const p_writer, char const * const p_key)
+{
+    uint32_t level;
+    uint32_t len = 0u;
+
+    if ((0u == p_writer->depth) || p_writer->b_after_key || (NULL == p_key))
+    {
+        json_writer_misuse(p_writer);
+        return;
+    }
+
+    level = p_writer->depth - 1u;
+
+    if (0u != (p_writer->array_mask & JSON_WRITER_BIT(level)))
+    {
+        json_writer_misuse(p_writer);
+        return;
+    }
+
+    if (0u != (p_writer->member_mask & JSON_WRITER_BIT(level)))
+    {
+        json_writer_put(p_writer, ',');
+    }
+    p_writer->member_mask |= JSON_WRITER_BIT(level);
+
+    while ('\0' != p_key[len])
+    {
+        len++;
+    }
+
+    json_writer_put_string(p_writer, p_key, len);
+    json_writer_put(p_writer, ':');
+    p_writer->b_after_key = TRUE;
+}
+
+
+/*!
+ * @brief Write a string value.
+ *
+ * @param[in] p_str Text, not null-terminated (e.g. a slice of the input).
+ * @param[in] len   Bytes in p_str.
+ */
+void
+json_writer_string (json_writer_t * const p_writer,
+                    char const * const p_str, uint32_t const len)
+{
+    if ((NULL == p_str) && (0u != len))
+    {
+        json_writer_misuse(p_writer);
+        return;
+    }
+
+    if (json_writer_value_start(p_writer))
+    {
+        json_writer_put_string(p_writer, p_str, len);
+    }
+}
+
+
+/*!
+ * @brief Write a signed integer value.
+ */
+void
+json_writer_int32 (json_writer_t * const p_writer, int32_t const value)
+{
+    if (json_writer_value_start(p_writer))
+    {
+        if (value < 0)
+        {
+            json_writer_put(p_writer, '-');
+            json_writer_put_u32(p_writer, 0u - (uint32_t)value);
+        }
+        else
+        {
+            json_writer_put_u32(p_writer, (uint32_t)value);
+        }
+    }
+}
+
+
+/*!
+ * @brief Write an unsigned integer value (counters, sizes).
+ */
+void
+json_writer_uint32 (json_writer_t * const p_writer, uint32_t const value)
+{
+    if (json_writer_value_start(p_writer))
+    {
+        json_writer_put_u32(p_writer, value);
+    }
+}
+
+
+/*!
+ * @brief Write true or false.
+ */
+void
+json_writer_bool (json_writer_t * const p_writer, bool_t const value)
+{
+    char const * p_text = value ? "true" : "false";
+
+    if (json_writer_value_start(p_writer))
+    {
+        while ('\0' != *p_text)
+        {
+            json_writer_put(p_writer, *p_text);
+            p_text++;
+        }
+    }
+}
+
+
+/*!
+ * @brief Write null.
+ */
+void
+json_writer_null (json_writer_t * const p_writer)
+{
+    if (json_writer_value_start(p_writer))
+    {
+        json_writer_put(p_writer, 'n');
+        json_writer_put(p_writer, 'u');
+        json_writer_put(p_writer, 'l');
+        json_writer_put(p_writer, 'l');
+    }
+}
+
+
+/*!
+ * @brief End the document: line ending, last chunk to the sink.
+ *
+ * Like every other output line, the document ends with "\r\n".
+ *
+ * @return 0 on success, -1 if the writer was misused (a key without a
+ *         value, an unclosed or mismatched object/array, nesting deeper
+ *         than JSON_WRITER_MAX_DEPTH), -2 if the sink had no room. On
+ *         error the output stops where the error happened.
+ */
+int32_t
+json_writer_finish (json_writer_t * const p_writer)
+{
+    if ((0u != p_writer->depth) || p_writer->b_after_key)
+    {
+        json_writer_misuse(p_writer);
+    }
+
+    json_writer_put(p_writer, '\r');
+    json_writer_put(p_writer, '\n');
+    json_writer_flush(p_writer);
+
+    return p_writer->error;
+}
+
+
+/*!
+ * @brief Sink that queues each chunk on USART2 (uart_enqueue()).
+ *
+ * Chunks are copied into the TX FIFO, so the writer may live on the
+ * stack. In UART_FRAMING_SLIP the document joins the current frame.
+ */
+int32_t
+json_writer_uart_sink (void * p_ctx, char const * p_data, uint32_t len)
+{
+    (void)p_ctx;
+
+    return uart_enqueue(p_data, len);
+}
+
+
+/*!
+ * @brief Check that a document of up to max_len bytes will fit in TX.
+ *
+ * Each chunk is a separate uart_enqueue(), so a reply that runs out of
+ * room part way is cut short on the wire. Check first, and call again
+ * later if this returns FALSE.
+ *
+ * @param[in] max_len Longest the document can be, including "\r\n" and
+ *                    (framed) any SLIP escapes.
+ *
+ * @return TRUE if FIFO space and descriptors for the whole document are free.
+ */
+bool_t
+json_writer_uart_fits (uint32_t const max_len)
+{
+    uint32_t const chunks = (max_len + JSON_WRITER_CHUNK_BYTES - 1u) /
+                            JSON_WRITER_CHUNK_BYTES;
+    uint32_t bytes = max_len;
+
+#if (UART_FRAMING == UART_FRAMING_SLIP)
+    bytes += 1u;    /* END opening the frame */
+#endif
+
+    /* A chunk copy takes two descriptors if it wraps the FIFO */
+    return ((uart_tx_free() >= bytes) &&
+            (uart_tx_slots_free() >= (2u * chunks))) ? TRUE : FALSE;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/*** end of file ***/
@@ -0,0 +1,77 @@
+/** @file jsonwriter.h
+ *
+ * @brief Streaming JSON writer: the output half of the bridge.
+ *
+ * Builds a JSON document call by call - begin/end object and array,
+ * keys, escaped strings, integers, booleans - and hands it to a sink in
+ * chunks of JSON_WRITER_CHUNK_BYTES as it goes, so a reply of any length
+ * needs no buffer of its own size. Commas and colons are placed by the
+ * writer, and nesting is checked. Nothing goes through printf.
+ *
+ * json_writer_uart_sink() queues each chunk on USART2 with
+ * uart_enqueue(); any other sink (a DMA buffer, a test capture) fits
+ * the same hook.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#ifndef JSONWRITER_H
+#define JSONWRITER_H
+
+#include <stdint.h>
+#include "types.h"
+
+/* Bytes collected before each call to the sink (override with -D) */
+#ifndef JSON_WRITER_CHUNK_BYTES
+#define JSON_WRITER_CHUNK_BYTES  32u
+#endif
+
+/* Deepest object/array nesting (one bit per level in the masks below) */
+#define JSON_WRITER_MAX_DEPTH    32u
+
+/* Sink: takes one chunk, returns 0 or non-zero if it had no room */
+typedef int32_t (*json_writer_sink_t)(void * p_ctx, char const * p_data,
+                                      uint32_t len);
+
+/* Writer state: 64 bytes on the target with the default chunk */
+typedef struct
+{
+    char chunk[JSON_WRITER_CHUNK_BYTES];
+    uint32_t fill;              /* Bytes in chunk */
+    uint32_t depth;             /* Open objects/arrays */
+    uint32_t array_mask;        /* Bit n: level n is an array */
+    uint32_t member_mask;       /* Bit n: level n has a member already */
+    bool_t b_after_key;         /* A key waits for its value */
+    int32_t error;              /* 0, -1 misuse or -2 sink full (latched) */
+    json_writer_sink_t p_sink;
+    void * p_ctx;
+} json_writer_t;
+
+/* Public API functions */
+void json_writer_init(json_writer_t * const p_writer,
+                      json_writer_sink_t const p_sink, void * const p_ctx);
+void json_writer_begin_object(json_writer_t * const p_writer);
+void json_writer_end_object(json_writer_t * const p_writer);
+void json_writer_begin_array(json_writer_t * const p_writer);
+void json_writer_end_array(json_writer_t * const p_writer);
+void json_writer_key(json_writer_t * const p_writer, char const * const p_key);
+void json_writer_string(json_writer_t * const p_writer,
+                        char const * const p_str, uint32_t const len);
+void json_writer_int32(json_writer_t * const p_writer, int32_t const value);
+void json_writer_uint32(json_writer_t * const p_writer, uint32_t const value);
+void json_writer_bool(json_writer_t * const p_writer, bool_t const value);
+void json_writer_null(json_writer_t * const p_writer);
+int32_t json_writer_finish(json_writer_t * const p_writer);
+
+/* Plain-buffer formatting, shared with the profile and trace dumps */
+char * json_writer_format_u32(char * p_out, uint32_t value);
+char * json_writer_format_str(char * p_out, char const * p_str);
+
+/* USART2 sink */
+int32_t json_writer_uart_sink(void * p_ctx, char const * p_data, uint32_t len);
+bool_t json_writer_uart_fits(uint32_t const max_len);
+
+#endif /* JSONWRITER_H */
+
+/*** end of file ***/
@@ -2,8 +2,9 @@
  *
  * @brief Main application entry point for JSON-UART bridge.
  *
- * Initializes JSON processing subsystem and continuously processes
- * embedded JSON data for UART transmission.
+ * Initializes JSON processing subsystem and continuously answers JSON
+ * messages received on UART RX (or the embedded demo document with
+ * JSON_SOURCE_BUILTIN).
  *
  * @par
  * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
@@ -11,11 +12,13 @@
 
 #include <stdint.h>
 #include "jsonprocess.h"
+#include "sched.h"
 
 /*!
  * @brief Main application entry point.
  *
- * Initializes JSON processing and enters infinite processing loop.
+ * Initializes JSON processing, which installs its tasks, and hands over
+ * to the scheduler. The core sleeps whenever no task is ready.
  *
  * @return Never returns (embedded system main loop).
  */
@@ -24,10 +27,7 @@ main (void)
 {
     json_process_init();
     
-    for (;;)
-    {
-        (void)json_process();
-    }
+    sched_run();
     
     /* Never reached */
     return 0;
@@ -0,0 +1,221 @@
+/** @file profile.c
+ *
+ * @brief Cycle-count instrumentation implementation.
+ *
+ * Cycles come from delay_get_cycles() (SysTick based - Cortex-M0+ has
+ * no DWT cycle counter), so each reading costs a few dozen cycles; the
+ * empty START/STOP pair is recorded as the probe overhead line and can
+ * be subtracted from the other results.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include "uart.h"
+#include "delay.h"
+#include "jsonwriter.h"
+#include "profile.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef PROFILE_ENABLE
+
+/* Longest dump line: {"probe":"json_transmitting","n":...,"max":...} */
+#define PROFILE_LINE_SIZE_BYTES   112u
+
+/* Per-probe statistics */
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+} profile_stat_t;
+
+static profile_stat_t g_profile[PROFILE_PROBE_COUNT];
+static uint32_t g_profile_dump_next = 0u;     /* Dump resume point */
+static uint32_t g_profile_overhead = 0u;      /* Cycles of an empty probe */
+
+static char const * const g_profile_names[PROFILE_PROBE_COUNT] =
+{
+    "usart2_irq",
+    "jsmn_parse",
+    "json_idle",
+    "json_parsing",
+    "json_transmitting",
+    "json_waiting",
+    "json_complete"
+};
+
+
+/*!
+ * @brief Record one measurement.
+ *
+ * Each probe must only be recorded from one context (one ISR or the main
+ * loop), so no locking is needed.
+ */
+void
+profile_record (profile_probe_t const probe, uint32_t const cycles)
+{
+    profile_stat_t * p_stat;
+
+    if (probe >= PROFILE_PROBE_COUNT)
+    {
+        return;
+    }
+
+    p_stat = &g_profile[probe];
+
+    if ((0u == p_stat->count) || (cycles < p_stat->min))
+    {
+        p_stat->min = cycles;
+    }
+
+    if (cycles > p_stat->max)
+    {
+        p_stat->max = cycles;
+    }
+
+    p_stat->total += cycles;
+    p_stat->count++;
+}
+
+
+/*!
+ * @brief Clear all probes and measure the probe overhead.
+ */
+void
+profile_reset (void)
+{
+    uint32_t start;
+    uint32_t i;
+
+    for (i = 0u; i < PROFILE_PROBE_COUNT; i++)
+    {
+        g_profile[i].count = 0u;
+        g_profile[i].min = 0u;
+        g_profile[i].max = 0u;
+        g_profile[i].total = 0u;
+    }
+
+    start = delay_get_cycles();
+    g_profile_overhead = delay_get_cycles() - start;
+
+    g_profile_dump_next = 0u;
+}
+
+
+/*!
+ * @brief Longest measurement of one probe since the last reset, in cycles.
+ */
+uint32_t
+profile_max (profile_probe_t const probe)
+{
+    return (probe < PROFILE_PROBE_COUNT) ? g_profile[probe].max : 0u;
+}
+
+
+/*!
+ * @brief Queue the probe table on the UART, one JSON object per line.
+ *
+ * Resumable: if the TX queue fills up part way, call again later and the
+ * dump continues with the next probe.
+ *
+ * @return 0 when the whole table is queued, -2 if it must be called again.
+ */
+int32_t
+profile_dump (void)
+{
+    char line[PROFILE_LINE_SIZE_BYTES];
+
+    while (g_profile_dump_next <= PROFILE_PROBE_COUNT)
+    {
+        char * p_out = line;
+
+        if (PROFILE_PROBE_COUNT == g_profile_dump_next)
+        {
+            p_out = json_writer_format_str(p_out,
+                                           "{\"probe\":\"overhead\",\"cycles\":");
+            p_out = json_writer_format_u32(p_out, g_profile_overhead);
+        }
+        else
+        {
+            profile_stat_t stat = g_profile[g_profile_dump_next];
+            uint32_t avg = (0u == stat.count) ? 0u :
+                           (uint32_t)(stat.total / stat.count);
+
+            p_out = json_writer_format_str(p_out, "{\"probe\":\"");
+            p_out = json_writer_format_str(p_out,
+                                           g_profile_names[g_profile_dump_next]);
+            p_out = json_writer_format_str(p_out, "\",\"n\":");
+            p_out = json_writer_format_u32(p_out, stat.count);
+            p_out = json_writer_format_str(p_out, ",\"min\":");
+            p_out = json_writer_format_u32(p_out, stat.min);
+            p_out = json_writer_format_str(p_out, ",\"avg\":");
+            p_out = json_writer_format_u32(p_out, avg);
+            p_out = json_writer_format_str(p_out, ",\"max\":");
+            p_out = json_writer_format_u32(p_out, stat.max);
+        }
+
+        p_out = json_writer_format_str(p_out, "}\r\n");
+
+        if (0 != uart_enqueue(line, (uint32_t)(p_out - line)))
+        {
+            return -2;
+        }
+
+        g_profile_dump_next++;
+    }
+
+    g_profile_dump_next = 0u;
+
+    return 0;
+}
+
+#else /* !PROFILE_ENABLE */
+
+/*!
+ * @brief Nothing to clear without PROFILE_ENABLE.
+ */
+void
+profile_reset (void)
+{
+}
+
+
+/*!
+ * @brief Nothing is measured without PROFILE_ENABLE.
+ */
+uint32_t
+profile_max (profile_probe_t const probe)
+{
+    (void)probe;
+
+    return 0u;
+}
+
+
+/*!
+ * @brief Report that profiling is not built in.
+ *
+ * @return 0 once the notice is queued, -2 if it must be called again.
+ */
+int32_t
+profile_dump (void)
+{
+    static char const notice[] = "{\"probe\":null,\"error\":\"build with make profile\"}\r\n";
+
+    return (0 == uart_enqueue(notice, sizeof(notice) - 1u)) ? 0 : -2;
+}
+
+#endif /* PROFILE_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
+
+/*** end of file ***/
@@ -0,0 +1,53 @@
+/** @file profile.h
+ *
+ * @brief Cycle-count instrumentation for hot paths.
+ *
+ * Each probe keeps min/max/avg/count of the cycles spent between
+ * PROFILE_START() and PROFILE_STOP(). Probes compile to nothing unless
+ * the build defines PROFILE_ENABLE (see "make profile"). The table is
+ * dumped over UART with the {"cmd": "profile"} command.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdint.h>
+#include "delay.h"
+
+/* Probe identifiers (the JSON entries follow json_state_t order) */
+typedef enum
+{
+    PROFILE_USART2_IRQ = 0,
+    PROFILE_JSMN_PARSE,
+    PROFILE_JSON_IDLE,
+    PROFILE_JSON_PARSING,
+    PROFILE_JSON_TRANSMITTING,
+    PROFILE_JSON_WAITING,
+    PROFILE_JSON_COMPLETE,
+    PROFILE_PROBE_COUNT
+} profile_probe_t;
+
+#ifdef PROFILE_ENABLE
+/* Open a measurement - declares a local holding the start cycle */
+#define PROFILE_START(var)          uint32_t var = delay_get_cycles()
+
+/* Close a measurement and record it against a probe */
+#define PROFILE_STOP(probe, var)    profile_record((probe), delay_get_cycles() - (var))
+
+void profile_record(profile_probe_t const probe, uint32_t const cycles);
+#else
+#define PROFILE_START(var)
+#define PROFILE_STOP(probe, var)
+#endif
+
+/* Public API functions (available in every build) */
+void profile_reset(void);
+uint32_t profile_max(profile_probe_t const probe);
+int32_t profile_dump(void);
+
+#endif /* PROFILE_H */
+
+/*** end of file ***/
@@ -0,0 +1,106 @@
+/** @file ratelimit.c
+ *
+ * @brief Token-bucket rate limiter implementation.
+ *
+ * Refill is computed from the SysTick millisecond counter via
+ * delay_start()/delay_elapsed(), so no timer or interrupt of its own is
+ * needed. Credit is tracked in milli-units: one millisecond at R units/s
+ * adds exactly R milli-units, which keeps the hot path division-free.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include "delay.h"
+#include "ratelimit.h"
+
+/* Milli-units per unit of credit */
+#define RATELIMIT_MILLI           1000u
+
+/* Largest burst whose milli-unit capacity fits in 32 bits */
+#define RATELIMIT_MAX_BURST       4000000u
+
+
+/*!
+ * @brief Add credit for the time elapsed since the last refill.
+ */
+static void
+ratelimit_refill (ratelimit_t * const p_rl)
+{
+    uint32_t now;
+    uint64_t credit;
+
+    if (!delay_elapsed(p_rl->last_tick, 1u))
+    {
+        return;
+    }
+
+    now = delay_start();
+    credit = (uint64_t)p_rl->credit_milli +
+             ((uint64_t)(now - p_rl->last_tick) * p_rl->rate_per_sec);
+
+    p_rl->credit_milli = (credit > p_rl->capacity_milli) ?
+                         p_rl->capacity_milli : (uint32_t)credit;
+    p_rl->last_tick = now;
+}
+
+
+/*!
+ * @brief Initialize a token bucket, starting full.
+ *
+ * @param[out] p_rl Pointer to limiter state.
+ * @param[in] rate_per_sec Refill rate in units per second.
+ * @param[in] burst Bucket depth in units.
+ *
+ * @return 0 on success, -1 on invalid arguments.
+ */
+int32_t
+ratelimit_init (ratelimit_t * const p_rl, uint32_t const rate_per_sec,
+                uint32_t const burst)
+{
+    if ((NULL == p_rl) || (0u == burst) || (burst > RATELIMIT_MAX_BURST))
+    {
+        return -1;
+    }
+
+    p_rl->rate_per_sec = rate_per_sec;
+    p_rl->burst = burst;
+    p_rl->capacity_milli = burst * RATELIMIT_MILLI;
+    p_rl->credit_milli = p_rl->capacity_milli;
+    p_rl->last_tick = delay_start();
+
+    return 0;
+}
+
+
+/*!
+ * @brief Spend credit if available (non-blocking).
+ *
+ * @param[in,out] p_rl Pointer to limiter state.
+ * @param[in] cost Units required.
+ *
+ * @return 1 if the credit was spent, 0 if the caller must retry later.
+ */
+uint8_t
+ratelimit_consume (ratelimit_t * const p_rl, uint32_t const cost)
+{
+    uint32_t need;
+
+    ratelimit_refill(p_rl);
+
+    /* Oversize requests wait for a full bucket instead of starving */
+    need = (cost > p_rl->burst) ?
+           p_rl->capacity_milli : (cost * RATELIMIT_MILLI);
+
+    if (p_rl->credit_milli < need)
+    {
+        return 0u;
+    }
+
+    p_rl->credit_milli -= need;
+    return 1u;
+}
+
+/*** end of file ***/
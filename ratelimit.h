@@ -0,0 +1,54 @@
+/** @file ratelimit.h
+ *
+ * @brief Token-bucket rate limiter on top of the non-blocking delay API.
+ *
+ * Credit refills at a fixed rate per second up to a burst limit and is
+ * spent by callers before they act, giving a non-blocking yes/no answer.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#ifndef RATELIMIT_H
+#define RATELIMIT_H
+
+#include <stdint.h>
+
+/* Token-bucket state (credit kept in 1/1000 units to avoid division) */
+typedef struct
+{
+    uint32_t rate_per_sec;     /* Units added per second */
+    uint32_t burst;            /* Bucket depth in units */
+    uint32_t capacity_milli;   /* Bucket depth (burst) in milli-units */
+    uint32_t credit_milli;     /* Current credit in milli-units */
+    uint32_t last_tick;        /* Tick of last refill (delay_start()) */
+} ratelimit_t;
+
+/*!
+ * @brief Initialize a token bucket, starting full.
+ *
+ * @param[out] p_rl Pointer to limiter state.
+ * @param[in] rate_per_sec Refill rate in units per second (0 = never refill).
+ * @param[in] burst Bucket depth in units (max 4,000,000).
+ *
+ * @return 0 on success, -1 if p_rl is NULL or burst is out of range.
+ */
+int32_t ratelimit_init(ratelimit_t * const p_rl, uint32_t const rate_per_sec,
+                       uint32_t const burst);
+
+/*!
+ * @brief Spend credit if available (non-blocking).
+ *
+ * A cost larger than the burst is admitted once the bucket is full,
+ * so oversize requests are slowed down rather than starved forever.
+ *
+ * @param[in,out] p_rl Pointer to limiter state.
+ * @param[in] cost Units required.
+ *
+ * @return 1 if the credit was spent, 0 if the caller must retry later.
+ */
+uint8_t ratelimit_consume(ratelimit_t * const p_rl, uint32_t const cost);
+
+#endif /* RATELIMIT_H */
+
+/*** end of file ***/
@@ -0,0 +1,185 @@
+/** @file sched.c
+ *
+ * @brief Cooperative task scheduler implementation.
+ *
+ * Ready flags are one byte per task. An ISR only ever stores 1 and the
+ * scheduler stores 0 before it runs the task, so neither side needs a
+ * read-modify-write and a signal that arrives while the task runs is
+ * never lost - it just runs the task once more.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include "sched.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef HOST_BUILD
+/* Inline functions for interrupt control and sleep */
+static inline void __enable_irq(void) {
+    __asm volatile ("cpsie i" : : : "memory");
+}
+
+static inline void __disable_irq(void) {
+    __asm volatile ("cpsid i" : : : "memory");
+}
+
+static inline void __WFI(void) {
+    __asm volatile ("wfi" : : : "memory");
+}
+#else
+/* Host build: no interrupts to wait for */
+static inline void __enable_irq(void) {
+}
+
+static inline void __disable_irq(void) {
+}
+
+static inline void __WFI(void) {
+}
+#endif
+
+static volatile uint8_t g_sched_ready[SCHED_TASK_COUNT];
+static sched_fn_t g_sched_fn[SCHED_TASK_COUNT];
+
+
+/*!
+ * @brief Forget all tasks and pending signals.
+ */
+void
+sched_init (void)
+{
+    uint32_t i;
+
+    for (i = 0u; i < (uint32_t)SCHED_TASK_COUNT; i++)
+    {
+        g_sched_ready[i] = 0u;
+        g_sched_fn[i] = NULL;
+    }
+}
+
+
+/*!
+ * @brief Install the body of a task (NULL removes it).
+ *
+ * @return 0 on success, -1 if task is out of range.
+ */
+int32_t
+sched_task_set (sched_task_t const task, sched_fn_t const p_fn)
+{
+    if ((uint32_t)task >= (uint32_t)SCHED_TASK_COUNT)
+    {
+        return -1;
+    }
+
+    g_sched_fn[task] = p_fn;
+
+    return 0;
+}
+
+
+/*!
+ * @brief Mark a task ready.
+ *
+ * @note One byte store; safe to call from any interrupt.
+ */
+void
+sched_signal (sched_task_t const task)
+{
+    if ((uint32_t)task < (uint32_t)SCHED_TASK_COUNT)
+    {
+        g_sched_ready[task] = 1u;
+    }
+}
+
+
+/*!
+ * @brief Run the highest-priority ready task once.
+ *
+ * The signal is consumed even if no body is installed.
+ *
+ * @return TRUE if a signal was consumed, FALSE if nothing was ready.
+ */
+bool_t
+sched_run_once (void)
+{
+    uint32_t i;
+
+    for (i = 0u; i < (uint32_t)SCHED_TASK_COUNT; i++)
+    {
+        if (0u != g_sched_ready[i])
+        {
+            g_sched_ready[i] = 0u;
+
+            if ((NULL != g_sched_fn[i]) && g_sched_fn[i]())
+            {
+                g_sched_ready[i] = 1u;
+            }
+
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+
+/*!
+ * @brief Sleep until an interrupt if no task is ready.
+ *
+ * Interrupts are masked while the flags are checked: a signal raised
+ * after the check leaves its interrupt pending, which ends WFI at once,
+ * and the handler runs as soon as they are unmasked again.
+ */
+void
+sched_idle (void)
+{
+    uint32_t i;
+    bool_t b_ready = FALSE;
+
+    __disable_irq();
+
+    for (i = 0u; i < (uint32_t)SCHED_TASK_COUNT; i++)
+    {
+        if (0u != g_sched_ready[i])
+        {
+            b_ready = TRUE;
+        }
+    }
+
+    if (FALSE == b_ready)
+    {
+        __WFI();
+    }
+
+    __enable_irq();
+}
+
+
+/*!
+ * @brief Run tasks forever, sleeping whenever none is ready.
+ *
+ * @return Never returns.
+ */
+void
+sched_run (void)
+{
+    for (;;)
+    {
+        if (FALSE == sched_run_once())
+        {
+            sched_idle();
+        }
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/*** end of file ***/
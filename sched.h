@@ -0,0 +1,49 @@
+/** @file sched.h
+ *
+ * @brief Cooperative run-to-completion task scheduler with WFI idle.
+ *
+ * A fixed set of tasks, each readied by a flag that interrupt handlers
+ * (or other tasks) set with sched_signal(). sched_run() always runs the
+ * highest-priority ready task next, one call at a time, so no task
+ * preempts another and none needs a stack of its own. With nothing
+ * ready the core sleeps in WFI until the next interrupt.
+ *
+ * A task returns TRUE if it has more work and wants to run again, or
+ * FALSE to wait for its next signal. Keeping every call short bounds the
+ * wake-up latency of the other tasks to the longest single call.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#ifndef SCHED_H
+#define SCHED_H
+
+#include <stdint.h>
+#include "types.h"
+
+/* Tasks, highest priority first */
+typedef enum
+{
+    SCHED_TASK_RX = 0,          /* Received bytes to pull into the parser */
+    SCHED_TASK_TX,              /* TX slices retired, output buffers free */
+    SCHED_TASK_PARSE,           /* Message processing can make progress */
+    SCHED_TASK_PORT,            /* Extra serial ports (uart_port.c): RX or TX done */
+    SCHED_TASK_HOUSEKEEPING,    /* Millisecond tick: periodic background work */
+    SCHED_TASK_COUNT
+} sched_task_t;
+
+/* Task body: TRUE to run again, FALSE to wait for the next signal */
+typedef bool_t (*sched_fn_t)(void);
+
+/* Public API functions */
+void sched_init(void);
+int32_t sched_task_set(sched_task_t const task, sched_fn_t const p_fn);
+void sched_signal(sched_task_t const task);
+bool_t sched_run_once(void);
+void sched_idle(void);
+void sched_run(void);
+
+#endif /* SCHED_H */
+
+/*** end of file ***/
@@ -0,0 +1,197 @@
+/** @file slip.h
+ *
+ * @brief SLIP (RFC 1055) framing with a CRC-16 trailer.
+ *
+ * A frame is END, the escaped payload, the escaped CRC and END again:
+ *
+ *   0xC0 | payload | CRC high | CRC low | 0xC0
+ *
+ * Inside a frame END (0xC0) is sent as ESC ESC_END (0xDB 0xDC) and ESC
+ * (0xDB) as ESC ESC_ESC (0xDB 0xDD), so END only ever marks a frame
+ * boundary - whatever the payload holds, newlines and binary included.
+ *
+ * The CRC is CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF, no final
+ * xor; "123456789" gives 0x29B1) over the unescaped payload, sent big
+ * endian. Run over payload and CRC together it leaves 0, so a receiver
+ * updates it byte by byte as data arrives and checks a frame at END with
+ * one compare.
+ *
+ * The decoder is header-only so uart.c can run it straight from the RX
+ * interrupt and host_port.c can share it.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#ifndef SLIP_H
+#define SLIP_H
+
+#include <stdint.h>
+#include "types.h"
+
+/* Special bytes */
+#define SLIP_END                 0xC0u
+#define SLIP_ESC                 0xDBu
+#define SLIP_ESC_END             0xDCu
+#define SLIP_ESC_ESC             0xDDu
+
+/* CRC-16/CCITT-FALSE */
+#define SLIP_CRC_INIT            0xFFFFu
+#define SLIP_CRC_SIZE            2u
+
+/* slip_rx_byte() results */
+typedef enum
+{
+    SLIP_RX_NONE = 0,     /* Byte consumed, nothing to report */
+    SLIP_RX_DATA,         /* One payload (or CRC) byte decoded */
+    SLIP_RX_FRAME,        /* END closed a good frame of frame_len bytes */
+    SLIP_RX_BAD           /* END closed a corrupt or malformed frame */
+} slip_rx_event_t;
+
+/* Receive-side decoder state */
+typedef struct
+{
+    uint32_t len;         /* Bytes decoded in the current frame */
+    uint32_t frame_len;   /* Payload length of the last good frame */
+    uint16_t crc;
+    bool_t b_escape;      /* Last byte was ESC */
+    bool_t b_bad;         /* Current frame is already lost */
+} slip_rx_t;
+
+
+/*!
+ * @brief Add one byte to a CRC-16/CCITT-FALSE (table-free, MSB first).
+ */
+static inline uint16_t
+slip_crc_update (uint16_t const crc, uint8_t const byte)
+{
+    uint32_t x = ((uint32_t)crc >> 8) ^ byte;
+
+    x ^= x >> 4;
+
+    return (uint16_t)(((uint32_t)crc << 8) ^ (x << 12) ^ (x << 5) ^ x);
+}
+
+
+/*!
+ * @brief Check if a byte has to be escaped inside a frame.
+ */
+static inline bool_t
+slip_is_special (uint8_t const byte)
+{
+    return ((SLIP_END == byte) || (SLIP_ESC == byte)) ? TRUE : FALSE;
+}
+
+
+/*!
+ * @brief Second byte of the escape sequence for END or ESC.
+ */
+static inline uint8_t
+slip_escape_code (uint8_t const byte)
+{
+    return (SLIP_END == byte) ? (uint8_t)SLIP_ESC_END : (uint8_t)SLIP_ESC_ESC;
+}
+
+
+/*!
+ * @brief Start a decoder (or forget the frame in progress).
+ */
+static inline void
+slip_rx_reset (slip_rx_t * const p_rx)
+{
+    p_rx->len = 0u;
+    p_rx->crc = SLIP_CRC_INIT;
+    p_rx->b_escape = FALSE;
+    p_rx->b_bad = FALSE;
+}
+
+
+/*!
+ * @brief Mark the current frame as lost (dropped or corrupted bytes).
+ *
+ * Decoding carries on, but the next END reports SLIP_RX_BAD.
+ */
+static inline void
+slip_rx_fail (slip_rx_t * const p_rx)
+{
+    p_rx->b_bad = TRUE;
+}
+
+
+/*!
+ * @brief Feed one received byte to the decoder.
+ *
+ * On SLIP_RX_DATA the decoded byte is in *p_byte; it is payload until
+ * the frame ends, when the last SLIP_CRC_SIZE bytes turn out to be the
+ * CRC. On SLIP_RX_FRAME, frame_len holds the payload length. Back-to-back
+ * END bytes (idle fill, or the leading END of a frame) are ignored.
+ *
+ * @note Constant time per byte; safe to call from an interrupt.
+ */
+static inline slip_rx_event_t
+slip_rx_byte (slip_rx_t * const p_rx, uint8_t * const p_byte)
+{
+    uint8_t byte = *p_byte;
+    slip_rx_event_t event;
+
+    if (SLIP_END == byte)
+    {
+        if ((0u == p_rx->len) && (FALSE == p_rx->b_bad))
+        {
+            event = SLIP_RX_NONE;
+        }
+        else if ((FALSE == p_rx->b_bad) && (FALSE == p_rx->b_escape) &&
+                 (p_rx->len > SLIP_CRC_SIZE) && (0u == p_rx->crc))
+        {
+            p_rx->frame_len = p_rx->len - SLIP_CRC_SIZE;
+            event = SLIP_RX_FRAME;
+        }
+        else
+        {
+            event = SLIP_RX_BAD;
+        }
+
+        slip_rx_reset(p_rx);
+        return event;
+    }
+
+    if (SLIP_ESC == byte)
+    {
+        if (p_rx->b_escape)
+        {
+            p_rx->b_bad = TRUE;
+        }
+
+        p_rx->b_escape = TRUE;
+        return SLIP_RX_NONE;
+    }
+
+    if (p_rx->b_escape)
+    {
+        p_rx->b_escape = FALSE;
+
+        if (SLIP_ESC_END == byte)
+        {
+            byte = (uint8_t)SLIP_END;
+        }
+        else if (SLIP_ESC_ESC == byte)
+        {
+            byte = (uint8_t)SLIP_ESC;
+        }
+        else
+        {
+            /* Not a valid escape: the frame is damaged */
+            p_rx->b_bad = TRUE;
+        }
+    }
+
+    p_rx->crc = slip_crc_update(p_rx->crc, byte);
+    p_rx->len++;
+    *p_byte = byte;
+
+    return SLIP_RX_DATA;
+}
+
+#endif /* SLIP_H */
+
+/*** end of file ***/
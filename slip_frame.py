@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+"""SLIP framing for the bridge's UART_FRAMING_SLIP build (see slip.h).
+
+A frame is END, the payload, its CRC-16/CCITT-FALSE (big endian) and END
+again, with END (0xC0) and ESC (0xDB) inside escaped as 0xDB 0xDC and
+0xDB 0xDD.
+
+    slip_frame.py encode [file]   frame the input for sending
+    slip_frame.py decode [file]   unframe received data
+
+encode makes one frame of every input line (without its line ending), or
+of the whole input with --whole, so a message may span lines. decode
+writes the payloads of good frames back-to-back to stdout - text lines
+as they are, CBOR ready for cbor_decode.py - and counts rejected frames
+on stderr. Files may be serial devices, e.g.
+
+    slip_frame.py encode msgs.txt > /dev/ttyACM0
+    slip_frame.py decode /dev/ttyACM0 | cbor_decode.py
+"""
+
+import sys
+
+END = 0xC0
+ESC = 0xDB
+ESC_END = 0xDC
+ESC_ESC = 0xDD
+
+
+def crc16(data, crc=0xFFFF):
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def escape(data):
+    out = bytearray()
+    for byte in data:
+        if byte == END:
+            out += bytes([ESC, ESC_END])
+        elif byte == ESC:
+            out += bytes([ESC, ESC_ESC])
+        else:
+            out.append(byte)
+    return bytes(out)
+
+
+def frame(payload):
+    crc = crc16(payload)
+    return bytes([END]) + escape(payload + bytes([crc >> 8, crc & 0xFF])) + \
+        bytes([END])
+
+
+def encode(stream, out, whole):
+    data = stream.read()
+    payloads = [data] if whole else data.splitlines()
+    for payload in payloads:
+        if payload:
+            out.write(frame(payload))
+    out.flush()
+
+
+def decode(stream, out):
+    data = bytearray()
+    bad = False
+    escaped = False
+    rejected = 0
+
+    while True:
+        chunk = stream.read(1)
+        if not chunk:
+            break
+        byte = chunk[0]
+
+        if byte == END:
+            if data or bad:
+                if not bad and not escaped and len(data) > 2 and \
+                        crc16(data) == 0:
+                    out.write(bytes(data[:-2]))
+                    out.flush()
+                else:
+                    rejected += 1
+            data = bytearray()
+            bad = escaped = False
+        elif escaped:
+            escaped = False
+            if byte == ESC_END:
+                data.append(END)
+            elif byte == ESC_ESC:
+                data.append(ESC)
+            else:
+                bad = True
+        elif byte == ESC:
+            escaped = True
+        else:
+            data.append(byte)
+
+    if rejected:
+        sys.stderr.write("slip_frame: %d frame(s) rejected\n" % rejected)
+
+
+def main():
+    args = [a for a in sys.argv[1:] if a != "--whole"]
+    whole = len(args) != len(sys.argv) - 1
+    if not args or args[0] not in ("encode", "decode") or len(args) > 2:
+        sys.exit(__doc__)
+    stream = open(args[1], "rb", buffering=0) if len(args) > 1 else \
+        sys.stdin.buffer
+
+    if args[0] == "encode":
+        encode(stream, sys.stdout.buffer, whole)
+    else:
+        decode(stream, sys.stdout.buffer)
+
+
+if __name__ == "__main__":
+    main()
@@ -13,25 +13,72 @@ extern uint32_t _top_of_stack;
 extern int main(void);
 void Reset_Handler(void);
 void Default_Handler(void);
+extern void USART1_IRQHandler(void);  /* uart_port.c */
 extern void USART2_IRQHandler(void);
+extern void USART3_4_LPUART1_IRQHandler(void);  /* uart_port.c (shared) */
+extern void DMA1_Channel1_IRQHandler(void);  /* USART2 TX DMA complete */
+extern void DMA1_Channel2_3_IRQHandler(void);  /* USART2 RX DMA (UART_RX_MODE_DMA) */
 extern void SysTick_Handler(void);  /* NEW: For non-blocking delays */
 
+/* Word copy, four words per LDM/STM pair, then single words.
+ * Naked: no prologue, so the loops are the same at any -O level.
+ * GCC hands Thumb-1 inline asm to gas in divided syntax, so each
+ * block selects unified syntax itself.
+ * r0 = dst, r1 = src, r2 = end of dst; all word aligned. */
+__attribute__((naked))
+static void startup_copy(uint32_t *dst, uint32_t const *src, uint32_t *end) {
+    __asm volatile (
+        "    .syntax unified\n"
+        "    push  {r4, r5, r6}\n"
+        "1:  subs  r3, r2, r0\n"
+        "    cmp   r3, #16\n"
+        "    blo   2f\n"
+        "    ldmia r1!, {r3, r4, r5, r6}\n"
+        "    stmia r0!, {r3, r4, r5, r6}\n"
+        "    b     1b\n"
+        "2:  cmp   r0, r2\n"
+        "    bhs   3f\n"
+        "    ldmia r1!, {r3}\n"
+        "    stmia r0!, {r3}\n"
+        "    b     2b\n"
+        "3:  pop   {r4, r5, r6}\n"
+        "    bx    lr\n"
+    );
+}
+
+/* Word fill with zero, four words per STM, then single words.
+ * r0 = dst, r1 = end; both word aligned. */
+__attribute__((naked))
+static void startup_zero(uint32_t *dst, uint32_t *end) {
+    __asm volatile (
+        "    .syntax unified\n"
+        "    push  {r4, r5, r6}\n"
+        "    movs  r2, #0\n"
+        "    movs  r3, #0\n"
+        "    movs  r4, #0\n"
+        "    movs  r5, #0\n"
+        "1:  subs  r6, r1, r0\n"
+        "    cmp   r6, #16\n"
+        "    blo   2f\n"
+        "    stmia r0!, {r2, r3, r4, r5}\n"
+        "    b     1b\n"
+        "2:  cmp   r0, r1\n"
+        "    bhs   3f\n"
+        "    stmia r0!, {r2}\n"
+        "    b     2b\n"
+        "3:  pop   {r4, r5, r6}\n"
+        "    bx    lr\n"
+    );
+}
+
 /* Reset Handler */
 void Reset_Handler(void) {
-    uint32_t *src, *dst;
-
     /* Copy .data section from FLASH to RAM */
-    src = &_sidata;
-    dst = &_sdata;
-    while (dst < &_edata) {
-        *dst++ = *src++;
-    }
+    startup_copy(&_sdata, &_sidata, &_edata);
 
-    /* Clear .bss section in RAM */
-    dst = &_sbss;
-    while (dst < &_ebss) {
-        *dst++ = 0;
-    }
+    /* Clear .bss section in RAM; .noinit (the rings and token arena)
+     * is left as it is */
+    startup_zero(&_sbss, &_ebss);
 
     /* Call main */
     main();
@@ -71,8 +118,8 @@ const uint32_t g_pfnVectors[] = {
     (uint32_t)&Default_Handler,  // 6. EXTI2_3
     (uint32_t)&Default_Handler,  // 7. EXTI4_15
     0,                           // 8. Reserved
-    (uint32_t)&Default_Handler,  // 9. DMA_Channel1
-    (uint32_t)&Default_Handler,  // 10. DMA_Channel2_3
+    (uint32_t)&DMA1_Channel1_IRQHandler, // 9. DMA_Channel1 (USART2 TX)
+    (uint32_t)&DMA1_Channel2_3_IRQHandler, // 10. DMA_Channel2_3 (USART2 RX)
     (uint32_t)&Default_Handler,  // 11. DMA_Channel4_5_6_7
     (uint32_t)&Default_Handler,  // 12. ADC_COMP
     (uint32_t)&Default_Handler,  // 13. TIM1_BRK_UP_TRG_COM
@@ -89,9 +136,9 @@ const uint32_t g_pfnVectors[] = {
     (uint32_t)&Default_Handler,  // 24. I2C2
     (uint32_t)&Default_Handler,  // 25. SPI1
     (uint32_t)&Default_Handler,  // 26. SPI2
-    (uint32_t)&Default_Handler,  // 27. USART1
+    (uint32_t)&USART1_IRQHandler,// 27. USART1
     (uint32_t)&USART2_IRQHandler,// 28. USART2
-    (uint32_t)&Default_Handler,  // 29. USART3_4_LPUART1
+    (uint32_t)&USART3_4_LPUART1_IRQHandler, // 29. USART3_4_LPUART1
     (uint32_t)&Default_Handler,  // 30. CEC
     (uint32_t)&Default_Handler   // 31. AES_RNG
 };
@@ -0,0 +1,228 @@
+/** @file timer.c
+ *
+ * @brief Hashed timing wheel implementation.
+ *
+ * Each slot is a doubly linked list threaded through the timers. Every
+ * timer keeps the address of the link that points at it, so it can be
+ * unlinked in O(1) from whichever list holds it - a wheel slot or the
+ * list of the slot being expired - without knowing which.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include "timer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TIMER_WHEEL_MASK         (TIMER_WHEEL_SLOTS - 1u)
+
+#ifndef HOST_BUILD
+/* Mask interrupts, returning the previous PRIMASK (nests inside ISRs) */
+static inline uint32_t timer_lock(void) {
+    uint32_t primask;
+    __asm volatile ("mrs %0, primask\n\tcpsid i" : "=r" (primask) : : "memory");
+    return primask;
+}
+
+static inline void timer_unlock(uint32_t primask) {
+    __asm volatile ("msr primask, %0" : : "r" (primask) : "memory");
+}
+#else
+/* Host build: timer_tick() runs in the caller's context */
+static inline uint32_t timer_lock(void) {
+    return 0u;
+}
+
+static inline void timer_unlock(uint32_t primask) {
+    (void)primask;
+}
+#endif
+
+static timer_entry_t * g_p_timer_slot[TIMER_WHEEL_SLOTS];
+static timer_entry_t * g_p_timer_due = NULL;    /* Slot being expired */
+static uint32_t g_timer_cursor = 0u;            /* Slot of the last tick */
+
+
+/*!
+ * @brief Push a timer onto the front of a list.
+ */
+static inline void
+timer_link (timer_entry_t ** const pp_head, timer_entry_t * const p_timer)
+{
+    p_timer->p_next = *pp_head;
+
+    if (NULL != p_timer->p_next)
+    {
+        p_timer->p_next->pp_prev = &p_timer->p_next;
+    }
+
+    *pp_head = p_timer;
+    p_timer->pp_prev = pp_head;
+}
+
+
+/*!
+ * @brief Take a timer out of whatever list holds it (no-op if none).
+ */
+static inline void
+timer_unlink (timer_entry_t * const p_timer)
+{
+    if (NULL != p_timer->pp_prev)
+    {
+        *p_timer->pp_prev = p_timer->p_next;
+
+        if (NULL != p_timer->p_next)
+        {
+            p_timer->p_next->pp_prev = p_timer->pp_prev;
+        }
+
+        p_timer->p_next = NULL;
+        p_timer->pp_prev = NULL;
+    }
+}
+
+
+/*!
+ * @brief Start (or restart) a one-shot timer.
+ *
+ * The callback runs on the delay_ms-th tick from now, i.e. after
+ * delay_ms - 1 to delay_ms milliseconds - the same rounding as
+ * delay_elapsed(). Restarting a running timer moves it.
+ *
+ * @param[in] p_timer  Timer storage (zeroed or previously used).
+ * @param[in] delay_ms Ticks until expiry (at least 1).
+ * @param[in] p_cb     Called from SysTick_Handler on expiry.
+ * @param[in] p_ctx    Passed to p_cb.
+ *
+ * @return 0 on success, -1 on NULL arguments or a zero delay.
+ *
+ * @note O(1); safe to call from interrupts and expiry callbacks.
+ */
+int32_t
+timer_start (timer_entry_t * const p_timer, uint32_t const delay_ms,
+             timer_cb_t const p_cb, void * const p_ctx)
+{
+    uint32_t primask;
+
+    if ((NULL == p_timer) || (NULL == p_cb) || (0u == delay_ms))
+    {
+        return -1;
+    }
+
+    primask = timer_lock();
+
+    timer_unlink(p_timer);
+    p_timer->p_cb = p_cb;
+    p_timer->p_ctx = p_ctx;
+    p_timer->turns = (delay_ms - 1u) / TIMER_WHEEL_SLOTS;
+    timer_link(&g_p_timer_slot[(g_timer_cursor + delay_ms) & TIMER_WHEEL_MASK],
+               p_timer);
+
+    timer_unlock(primask);
+
+    return 0;
+}
+
+
+/*!
+ * @brief Stop a timer; its callback will not run (no-op if not running).
+ *
+ * @note O(1); safe to call from interrupts and expiry callbacks.
+ */
+void
+timer_stop (timer_entry_t * const p_timer)
+{
+    uint32_t primask;
+
+    if (NULL == p_timer)
+    {
+        return;
+    }
+
+    primask = timer_lock();
+    timer_unlink(p_timer);
+    timer_unlock(primask);
+}
+
+
+/*!
+ * @brief Check if a timer is running.
+ *
+ * @return TRUE between timer_start() and expiry or timer_stop().
+ */
+bool_t
+timer_active (timer_entry_t const * const p_timer)
+{
+    return ((NULL != p_timer) && (NULL != p_timer->pp_prev)) ? TRUE : FALSE;
+}
+
+
+/*!
+ * @brief Advance the wheel by one tick and run the expired callbacks.
+ *
+ * The current slot is moved to a list of its own first. Timers a
+ * callback starts therefore never land in the list being walked, and a
+ * timer restarted for a whole number of turns waits for them.
+ *
+ * @note Call from SysTick_Handler once per millisecond.
+ */
+void
+timer_tick (void)
+{
+    uint32_t primask;
+    uint32_t cursor;
+    timer_entry_t * p_timer;
+
+    primask = timer_lock();
+
+    cursor = (g_timer_cursor + 1u) & TIMER_WHEEL_MASK;
+    g_timer_cursor = cursor;
+
+    g_p_timer_due = g_p_timer_slot[cursor];
+    g_p_timer_slot[cursor] = NULL;
+
+    if (NULL != g_p_timer_due)
+    {
+        g_p_timer_due->pp_prev = &g_p_timer_due;
+    }
+
+    timer_unlock(primask);
+
+    for (;;)
+    {
+        primask = timer_lock();
+        p_timer = g_p_timer_due;
+
+        if (NULL == p_timer)
+        {
+            timer_unlock(primask);
+            break;
+        }
+
+        timer_unlink(p_timer);
+
+        if (p_timer->turns > 0u)
+        {
+            /* Due on a later turn: back into the same slot */
+            p_timer->turns--;
+            timer_link(&g_p_timer_slot[cursor], p_timer);
+            timer_unlock(primask);
+        }
+        else
+        {
+            timer_unlock(primask);
+            p_timer->p_cb(p_timer->p_ctx);
+        }
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/*** end of file ***/
@@ -0,0 +1,56 @@
+/** @file timer.h
+ *
+ * @brief Software timers on a hashed timing wheel (1 ms resolution).
+ *
+ * Any number of one-shot timers share one wheel of TIMER_WHEEL_SLOTS
+ * lists, advanced by timer_tick() from SysTick_Handler. A timer due in
+ * n ticks sits in slot (now + n) % TIMER_WHEEL_SLOTS with the number of
+ * whole turns still to wait, so starting and stopping are O(1) and a
+ * tick only visits the timers hashed to the current slot.
+ *
+ * Timers live in caller memory (no allocation) and must start out
+ * zeroed, as static storage is; the wheel itself needs no init. Expiry
+ * callbacks run in the SysTick interrupt: keep them short - set a flag,
+ * sched_signal(), or restart the timer for periodic use.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <stdint.h>
+#include "types.h"
+
+/* Wheel size (must be a power of two); timeouts up to this many ms cost
+ * one slot visit, longer ones one more per turn */
+#define TIMER_WHEEL_SLOTS        64u
+
+#if ((TIMER_WHEEL_SLOTS & (TIMER_WHEEL_SLOTS - 1u)) != 0u)
+#error "TIMER_WHEEL_SLOTS must be a power of two"
+#endif
+
+/* Expiry callback, called from the SysTick interrupt */
+typedef void (*timer_cb_t)(void * p_ctx);
+
+/* One software timer (contents private to timer.c) */
+typedef struct timer_entry
+{
+    struct timer_entry * p_next;
+    struct timer_entry ** pp_prev;    /* Link pointing at this entry */
+    uint32_t turns;                   /* Whole wheel turns still to wait */
+    timer_cb_t p_cb;
+    void * p_ctx;
+} timer_entry_t;
+
+/* Public API functions */
+int32_t timer_start(timer_entry_t * const p_timer, uint32_t const delay_ms,
+                    timer_cb_t const p_cb, void * const p_ctx);
+void timer_stop(timer_entry_t * const p_timer);
+bool_t timer_active(timer_entry_t const * const p_timer);
+void timer_tick(void);
+
+#endif /* TIMER_H */
+
+/*** end of file ***/
@@ -0,0 +1,183 @@
+/** @file tokarena.c
+ *
+ * @brief Token arena implementation.
+ *
+ * A ring of tokens with an allocation head and a count of tokens held.
+ * Blocks are released oldest-first, so the tail is implied by head and
+ * used, and a release is a single subtraction. When the arena empties
+ * the head goes back to index 0, so a block of the full capacity always
+ * fits into an empty arena.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include "jsmn.h"
+#include "tokarena.h"
+
+
+/*!
+ * @brief Attach storage to an arena and empty it.
+ *
+ * @return 0 on success, -1 on invalid arguments.
+ */
+int32_t
+tok_arena_init (tok_arena_t * const p_arena, jsmntok_t * const p_storage,
+                uint32_t const capacity)
+{
+    if ((NULL == p_arena) || (NULL == p_storage) || (0u == capacity))
+    {
+        return -1;
+    }
+
+    p_arena->p_tokens = p_storage;
+    p_arena->capacity = capacity;
+    tok_arena_reset(p_arena);
+
+    return 0;
+}
+
+
+/*!
+ * @brief Release every block at once.
+ */
+void
+tok_arena_reset (tok_arena_t * const p_arena)
+{
+    p_arena->head = 0u;
+    p_arena->used = 0u;
+}
+
+
+/*!
+ * @brief Allocate a contiguous block of tokens.
+ *
+ * @return Pointer to the block, or NULL if there is no room yet.
+ */
+jsmntok_t *
+tok_arena_alloc (tok_arena_t * const p_arena, uint32_t const count)
+{
+    uint32_t start = p_arena->head;
+    uint32_t pad = 0u;
+
+    if ((0u == count) || (count > p_arena->capacity))
+    {
+        return NULL;
+    }
+
+    /* Skip the end of the storage rather than split the block */
+    if ((start + count) > p_arena->capacity)
+    {
+        pad = p_arena->capacity - start;
+        start = 0u;
+    }
+
+    if ((p_arena->used + pad + count) > p_arena->capacity)
+    {
+        return NULL;
+    }
+
+    p_arena->used += pad + count;
+    p_arena->head = start + count;
+
+    if (p_arena->head == p_arena->capacity)
+    {
+        p_arena->head = 0u;
+    }
+
+    return &p_arena->p_tokens[start];
+}
+
+
+/*!
+ * @brief Mark the end of the most recent allocation.
+ */
+uint32_t
+tok_arena_mark (tok_arena_t const * const p_arena)
+{
+    return p_arena->head;
+}
+
+
+/*!
+ * @brief Tokens not held by any block.
+ */
+uint32_t
+tok_arena_free (tok_arena_t const * const p_arena)
+{
+    return p_arena->capacity - p_arena->used;
+}
+
+
+/*!
+ * @brief Release the oldest blocks up to and including a mark.
+ */
+void
+tok_arena_release (tok_arena_t * const p_arena, uint32_t const mark)
+{
+    /* Tokens allocated after the mark stay held */
+    uint32_t const newer = (p_arena->head >= mark) ?
+                           (p_arena->head - mark) :
+                           (p_arena->head + p_arena->capacity - mark);
+
+    p_arena->used = newer;
+
+    if (0u == p_arena->used)
+    {
+        p_arena->head = 0u;
+    }
+}
+
+
+/*!
+ * @brief Parse a complete document into an exactly sized block.
+ *
+ * @return Token count, or a negative jsmn error code.
+ */
+int32_t
+tok_arena_parse (tok_arena_t * const p_arena, char const * const p_js,
+                 uint32_t const len, jsmntok_t ** const pp_tokens)
+{
+    jsmn_parser_t parser;
+    jsmntok_t * p_block;
+    uint32_t const head = p_arena->head;
+    uint32_t const used = p_arena->used;
+    int32_t count;
+
+    *pp_tokens = NULL;
+
+    /* Pass 1: count */
+    jsmn_init(&parser);
+    count = jsmn_parse(&parser, p_js, len, NULL, 0u);
+
+    if (count <= 0)
+    {
+        return count;
+    }
+
+    p_block = tok_arena_alloc(p_arena, (uint32_t)count);
+
+    if (NULL == p_block)
+    {
+        return JSMN_ERROR_NOMEM;
+    }
+
+    /* Pass 2: fill exactly count tokens */
+    jsmn_init(&parser);
+    count = jsmn_parse(&parser, p_js, len, p_block, (uint32_t)count);
+
+    if (count < 0)
+    {
+        /* Counted but malformed (the count pass checks no nesting):
+         * undo the allocation, it is the newest block */
+        p_arena->head = head;
+        p_arena->used = used;
+    }
+
+    *pp_tokens = (count > 0) ? p_block : NULL;
+    return count;
+}
+
+/*** end of file ***/
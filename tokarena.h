@@ -0,0 +1,99 @@
+/** @file tokarena.h
+ *
+ * @brief Token arena: one static jsmntok_t region carved per message.
+ *
+ * Blocks are handed out in exact sizes (see tok_arena_parse() for the
+ * count-then-fill parse) and given back oldest-first, like the UART TX
+ * FIFO: the owner keeps tok_arena_mark() taken right after its
+ * allocation and passes it to tok_arena_release() when done. Several
+ * messages can be in flight; releasing or resetting is O(1).
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#ifndef TOKARENA_H
+#define TOKARENA_H
+
+#include <stdint.h>
+#include "jsmn.h"
+
+/* Arena state (storage is supplied by the owner) */
+typedef struct
+{
+    jsmntok_t * p_tokens;      /* Backing storage */
+    uint32_t capacity;         /* Tokens in p_tokens */
+    uint32_t head;             /* Next free index */
+    uint32_t used;             /* Tokens held, including wrap padding */
+} tok_arena_t;
+
+/*!
+ * @brief Attach storage to an arena and empty it.
+ *
+ * @param[out] p_arena Pointer to arena state.
+ * @param[in] p_storage Token storage (usually a static array).
+ * @param[in] capacity Number of tokens in p_storage.
+ *
+ * @return 0 on success, -1 if a pointer is NULL or capacity is 0.
+ */
+int32_t tok_arena_init(tok_arena_t * const p_arena, jsmntok_t * const p_storage,
+                       uint32_t const capacity);
+
+/*!
+ * @brief Release every block at once.
+ */
+void tok_arena_reset(tok_arena_t * const p_arena);
+
+/*!
+ * @brief Allocate a contiguous block of tokens.
+ *
+ * A block never wraps: if it does not fit before the end of the storage
+ * the remainder is skipped and released together with the block.
+ *
+ * @param[in,out] p_arena Pointer to arena state.
+ * @param[in] count Tokens required (> 0).
+ *
+ * @return Pointer to the block, or NULL if there is no room yet.
+ */
+jsmntok_t * tok_arena_alloc(tok_arena_t * const p_arena, uint32_t const count);
+
+/*!
+ * @brief Mark the end of the most recent allocation.
+ */
+uint32_t tok_arena_mark(tok_arena_t const * const p_arena);
+
+/*!
+ * @brief Tokens not held by any block (wrap padding counts as held).
+ *
+ * A block of this size may still not fit in one piece; use it as a fill
+ * level, not as a promise.
+ */
+uint32_t tok_arena_free(tok_arena_t const * const p_arena);
+
+/*!
+ * @brief Release the oldest blocks up to and including a mark.
+ *
+ * Marks must be released in the order they were taken.
+ */
+void tok_arena_release(tok_arena_t * const p_arena, uint32_t const mark);
+
+/*!
+ * @brief Parse a complete document into an exactly sized block.
+ *
+ * Runs jsmn_parse() once without tokens to count them, allocates that
+ * many from the arena, then parses again into the block.
+ *
+ * @param[in,out] p_arena Pointer to arena state.
+ * @param[in] p_js JSON text.
+ * @param[in] len Length of p_js.
+ * @param[out] pp_tokens Receives the block (NULL on error).
+ *
+ * @return Token count, or a negative jsmn error code (JSMN_ERROR_NOMEM
+ *         if the arena has no room for the document).
+ */
+int32_t tok_arena_parse(tok_arena_t * const p_arena, char const * const p_js,
+                        uint32_t const len, jsmntok_t ** const pp_tokens);
+
+#endif /* TOKARENA_H */
+
+/*** end of file ***/
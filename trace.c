@@ -0,0 +1,368 @@
+/** @file trace.c
+ *
+ * @brief Binary event trace implementation.
+ *
+ * Two single-producer / single-consumer rings: one written by interrupt
+ * handlers, one by the main loop, both read by trace_dump() in the main
+ * loop. The handler ring needs no lock because every handler runs at
+ * the reset priority, so none preempts another; the writer is picked
+ * from IPSR at run time. A full ring drops the new record and counts
+ * it, so the oldest records - the lead-up to a burst - are kept.
+ *
+ * Timestamps come from delay_get_cycles() (Cortex-M0+ has no DWT cycle
+ * counter), which is most of the cost of a record.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include "uart.h"
+#include "delay.h"
+#include "jsonwriter.h"
+#include "trace.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef TRACE_ENABLE
+
+#define TRACE_RING_MASK          (TRACE_RING_RECORDS - 1u)
+
+/* Longest dump line: {"t":4294967295,"ctx":"main","ev":"json_state",...} */
+#define TRACE_LINE_SIZE_BYTES    80u
+
+/* Rings, by writer */
+typedef enum
+{
+    TRACE_RING_HANDLER = 0,
+    TRACE_RING_MAIN,
+    TRACE_RING_COUNT
+} trace_ring_id_t;
+
+/* One record: 8 bytes */
+typedef struct
+{
+    uint32_t cycles;            /* delay_get_cycles() when recorded */
+    uint16_t event;             /* trace_event_t */
+    uint16_t arg;
+} trace_rec_t;
+
+typedef struct
+{
+    trace_rec_t rec[TRACE_RING_RECORDS];
+    volatile uint32_t head;     /* Free-running, written by the producer */
+    volatile uint32_t tail;     /* Free-running, written by trace_dump() */
+    volatile uint32_t dropped;  /* Records lost to a full ring */
+    uint32_t dump_end;          /* Head when the running dump started */
+    uint32_t dropped_seen;      /* dropped as of the last dump */
+} trace_ring_t;
+
+static trace_ring_t g_trace_ring[TRACE_RING_COUNT];
+static volatile uint32_t g_trace_mask = TRACE_MASK_DEFAULT;
+static bool_t g_b_trace_dumping = FALSE;
+
+static char const * const g_trace_names[TRACE_EV_COUNT] =
+{
+    "usart2_irq",
+    "uart_error",
+    "rx_drop",
+    "rx_hold",
+    "tick_late",
+    "json_state"
+};
+
+static char const * const g_trace_ring_names[TRACE_RING_COUNT] =
+{
+    "isr",
+    "main"
+};
+
+
+#ifndef HOST_BUILD
+/*!
+ * @brief Check whether the core is running an exception handler.
+ */
+static inline bool_t
+trace_in_handler (void)
+{
+    uint32_t ipsr;
+
+    __asm volatile ("mrs %0, ipsr" : "=r" (ipsr));
+
+    return (0u != ipsr) ? TRUE : FALSE;
+}
+#else
+/* Host build: everything runs in the main loop */
+static inline bool_t
+trace_in_handler (void)
+{
+    return FALSE;
+}
+#endif
+
+
+/*!
+ * @brief Record one event.
+ *
+ * @param[in] event Event id; ignored unless enabled in the mask.
+ * @param[in] arg   Event argument, bits 15..0 are kept.
+ *
+ * @note Safe from any handler at the reset priority and the main loop.
+ */
+void
+trace_record (trace_event_t const event, uint32_t const arg)
+{
+    trace_ring_t * p_ring;
+    trace_rec_t * p_rec;
+    uint32_t head;
+
+    if ((event >= TRACE_EV_COUNT) || (0u == (g_trace_mask & TRACE_MASK(event))))
+    {
+        return;
+    }
+
+    p_ring = &g_trace_ring[trace_in_handler() ? TRACE_RING_HANDLER :
+                                                TRACE_RING_MAIN];
+    head = p_ring->head;
+
+    if ((head - p_ring->tail) >= TRACE_RING_RECORDS)
+    {
+        p_ring->dropped++;
+        return;
+    }
+
+    p_rec = &p_ring->rec[head & TRACE_RING_MASK];
+    p_rec->cycles = delay_get_cycles();
+    p_rec->event = (uint16_t)event;
+    p_rec->arg = (uint16_t)arg;
+
+    /* Store the record before publishing the new head */
+    __asm volatile ("" : : : "memory");
+    p_ring->head = head + 1u;
+}
+
+
+/*!
+ * @brief Pick the ring holding the oldest record still to dump.
+ *
+ * @return Ring index, or TRACE_RING_COUNT when the dump is complete.
+ */
+static uint32_t
+trace_dump_next (void)
+{
+    uint32_t best = TRACE_RING_COUNT;
+    uint32_t i;
+
+    for (i = 0u; i < TRACE_RING_COUNT; i++)
+    {
+        trace_ring_t const * p_ring = &g_trace_ring[i];
+
+        if (p_ring->tail == p_ring->dump_end)
+        {
+            continue;
+        }
+
+        /* Wrap-safe: the older record has the smaller signed distance */
+        if ((TRACE_RING_COUNT == best) ||
+            ((int32_t)(p_ring->rec[p_ring->tail & TRACE_RING_MASK].cycles -
+                       g_trace_ring[best].rec[g_trace_ring[best].tail &
+                                              TRACE_RING_MASK].cycles) < 0))
+        {
+            best = i;
+        }
+    }
+
+    return best;
+}
+
+
+/*!
+ * @brief Clear both rings and enable the default events.
+ *
+ * @note Call before any handler records (at init), or records in flight
+ *       may be lost.
+ */
+void
+trace_reset (void)
+{
+    uint32_t i;
+
+    for (i = 0u; i < TRACE_RING_COUNT; i++)
+    {
+        g_trace_ring[i].head = 0u;
+        g_trace_ring[i].tail = 0u;
+        g_trace_ring[i].dropped = 0u;
+        g_trace_ring[i].dump_end = 0u;
+        g_trace_ring[i].dropped_seen = 0u;
+    }
+
+    g_trace_mask = TRACE_MASK_DEFAULT;
+    g_b_trace_dumping = FALSE;
+}
+
+
+/*!
+ * @brief Select the events to record.
+ *
+ * @param[in] mask TRACE_MASK() bits of the events to keep.
+ */
+void
+trace_set_mask (uint32_t const mask)
+{
+    g_trace_mask = mask;
+}
+
+
+/*!
+ * @brief Count the records waiting to be dumped.
+ */
+uint32_t
+trace_pending (void)
+{
+    uint32_t count = 0u;
+    uint32_t i;
+
+    for (i = 0u; i < TRACE_RING_COUNT; i++)
+    {
+        count += g_trace_ring[i].head - g_trace_ring[i].tail;
+    }
+
+    return count;
+}
+
+
+/*!
+ * @brief Queue the trace on the UART, one JSON object per record.
+ *
+ * Records from both rings come out merged in time order and are removed
+ * as they are queued. Only records present when the dump starts are
+ * sent, so a dump always ends, however busy the link. The last line
+ * reports the records dropped since the previous dump. Resumable: if
+ * the TX queue fills up part way, call again later.
+ *
+ * @return 0 when the whole trace is queued, -2 if it must be called again.
+ */
+int32_t
+trace_dump (void)
+{
+    char line[TRACE_LINE_SIZE_BYTES];
+    char * p_out;
+    uint32_t seen[TRACE_RING_COUNT];
+    uint32_t dropped = 0u;
+    uint32_t ring;
+    uint32_t i;
+
+    if (FALSE == g_b_trace_dumping)
+    {
+        for (i = 0u; i < TRACE_RING_COUNT; i++)
+        {
+            g_trace_ring[i].dump_end = g_trace_ring[i].head;
+        }
+        g_b_trace_dumping = TRUE;
+    }
+
+    for (ring = trace_dump_next(); ring < TRACE_RING_COUNT;
+         ring = trace_dump_next())
+    {
+        trace_ring_t * p_ring = &g_trace_ring[ring];
+        trace_rec_t const rec = p_ring->rec[p_ring->tail & TRACE_RING_MASK];
+
+        p_out = json_writer_format_str(line, "{\"t\":");
+        p_out = json_writer_format_u32(p_out, rec.cycles);
+        p_out = json_writer_format_str(p_out, ",\"ctx\":\"");
+        p_out = json_writer_format_str(p_out, g_trace_ring_names[ring]);
+        p_out = json_writer_format_str(p_out, "\",\"ev\":\"");
+        p_out = json_writer_format_str(p_out, g_trace_names[rec.event]);
+        p_out = json_writer_format_str(p_out, "\",\"arg\":");
+        p_out = json_writer_format_u32(p_out, rec.arg);
+        p_out = json_writer_format_str(p_out, "}\r\n");
+
+        if (0 != uart_enqueue(line, (uint32_t)(p_out - line)))
+        {
+            return -2;
+        }
+
+        /* Copied out: hand the slot back to the producer */
+        __asm volatile ("" : : : "memory");
+        p_ring->tail++;
+    }
+
+    for (i = 0u; i < TRACE_RING_COUNT; i++)
+    {
+        seen[i] = g_trace_ring[i].dropped;
+        dropped += seen[i] - g_trace_ring[i].dropped_seen;
+    }
+
+    p_out = json_writer_format_str(line, "{\"trace\":\"end\",\"dropped\":");
+    p_out = json_writer_format_u32(p_out, dropped);
+    p_out = json_writer_format_str(p_out, "}\r\n");
+
+    if (0 != uart_enqueue(line, (uint32_t)(p_out - line)))
+    {
+        return -2;
+    }
+
+    for (i = 0u; i < TRACE_RING_COUNT; i++)
+    {
+        g_trace_ring[i].dropped_seen = seen[i];
+    }
+
+    g_b_trace_dumping = FALSE;
+
+    return 0;
+}
+
+#else /* !TRACE_ENABLE */
+
+/*!
+ * @brief Nothing to clear without TRACE_ENABLE.
+ */
+void
+trace_reset (void)
+{
+}
+
+
+/*!
+ * @brief Nothing to select without TRACE_ENABLE.
+ */
+void
+trace_set_mask (uint32_t const mask)
+{
+    (void)mask;
+}
+
+
+/*!
+ * @brief Nothing is recorded without TRACE_ENABLE.
+ */
+uint32_t
+trace_pending (void)
+{
+    return 0u;
+}
+
+
+/*!
+ * @brief Report that tracing is not built in.
+ *
+ * @return 0 once the notice is queued, -2 if it must be called again.
+ */
+int32_t
+trace_dump (void)
+{
+    static char const notice[] = "{\"trace\":null,\"error\":\"build with make trace\"}\r\n";
+
+    return (0 == uart_enqueue(notice, sizeof(notice) - 1u)) ? 0 : -2;
+}
+
+#endif /* TRACE_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
+
+/*** end of file ***/
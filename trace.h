@@ -0,0 +1,77 @@
+/** @file trace.h
+ *
+ * @brief Binary event trace for interrupt and main-loop timing.
+ *
+ * TRACE() stores a compact record - a cycle timestamp, an event id and a
+ * 16-bit argument - in a fixed ring, from interrupt handlers and the
+ * main loop alike, without masking interrupts. Records are only
+ * formatted when the trace is dumped over UART with {"cmd": "trace"},
+ * one JSON object per line in time order, so tracing costs a few dozen
+ * cycles per event and no output while the bridge runs.
+ *
+ * Records compile to nothing unless the build defines TRACE_ENABLE (see
+ * "make trace").
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include "types.h"
+
+/* Records kept per ring, one ring for handlers and one for the main loop
+ * (must be a power of two; override with -DTRACE_RING_RECORDS=...) */
+#ifndef TRACE_RING_RECORDS
+#define TRACE_RING_RECORDS       64u
+#endif
+
+#if ((TRACE_RING_RECORDS & (TRACE_RING_RECORDS - 1u)) != 0u)
+#error "TRACE_RING_RECORDS must be a power of two"
+#endif
+
+/* SysTick entry later than this many cycles after the counter reload is
+ * recorded as TRACE_EV_TICK_LATE */
+#ifndef TRACE_TICK_LATE_CYCLES
+#define TRACE_TICK_LATE_CYCLES   256u
+#endif
+
+/* Events (the dump names follow this order) */
+typedef enum
+{
+    TRACE_EV_USART2_IRQ = 0,    /* arg: USART_ISR bits 15..0 (off by default) */
+    TRACE_EV_UART_ERROR,        /* arg: uart_error_t the handler recorded */
+    TRACE_EV_RX_DROP,           /* arg: bytes or frames this handler dropped */
+    TRACE_EV_RX_HOLD,           /* arg: 1 = sender held, 0 = released */
+    TRACE_EV_TICK_LATE,         /* arg: SysTick entry latency, cycles */
+    TRACE_EV_JSON_STATE,        /* arg: (from << 8) | to, json_state_t */
+    TRACE_EV_COUNT
+} trace_event_t;
+
+/* Bit per event for trace_set_mask() */
+#define TRACE_MASK(event)        (1u << (uint32_t)(event))
+
+/* Events recorded after trace_reset(): all but the per-interrupt one */
+#define TRACE_MASK_DEFAULT       (((1u << (uint32_t)TRACE_EV_COUNT) - 1u) & \
+                                  ~TRACE_MASK(TRACE_EV_USART2_IRQ))
+
+#ifdef TRACE_ENABLE
+/* Record an event (any context) */
+#define TRACE(event, arg)        trace_record((event), (uint32_t)(arg))
+
+void trace_record(trace_event_t const event, uint32_t const arg);
+#else
+#define TRACE(event, arg)
+#endif
+
+/* Public API functions (available in every build) */
+void trace_reset(void);
+void trace_set_mask(uint32_t const mask);
+uint32_t trace_pending(void);
+int32_t trace_dump(void);
+
+#endif /* TRACE_H */
+
+/*** end of file ***/
@@ -40,6 +40,15 @@
     #endif
 #endif
 
+/* Buffers that are always written before they are read: .noinit is not
+ * zeroed by Reset_Handler, so large rings cost nothing at reset. Their
+ * head/tail/state variables stay in .bss or are set by the init code. */
+#if defined(__GNUC__) && !defined(HOST_BUILD)
+    #define NOINIT  __attribute__((section(".noinit")))
+#else
+    #define NOINIT
+#endif
+
 #endif /* TYPES_H */
 
 /*** end of file ***/
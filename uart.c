@@ -14,6 +14,11 @@
 #include <string.h>
 #include "uart.h"
 #include "types.h"  /* For bool_t type */
+#include "profile.h"
+#include "trace.h"
+#include "slip.h"
+#include "clock.h"
+#include "sched.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -29,12 +34,43 @@ extern "C" {
 #define USART_CR1_RE_BIT           2u
 #define USART_CR1_TXEIE_BIT        7u
 #define USART_CR1_RXNEIE_BIT       5u
+#define USART_CR1_IDLEIE_BIT       4u
+#define USART_CR1_PEIE_BIT         8u
+#define USART_CR1_CMIE_BIT         14u
+#define USART_CR2_ADDM7_BIT        4u
+#define USART_CR2_ADD_SHIFT        24u
+#define USART_ISR_CMF_BIT          17u
+#define USART_ISR_IDLE_BIT         4u
 #define USART_ISR_TXE_BIT          7u
 #define USART_ISR_RXNE_BIT         5u
 #define USART_ISR_ORE_BIT          3u
 #define USART_ISR_FE_BIT           2u
 #define USART_ISR_NF_BIT           1u
 #define USART_ISR_PE_BIT           0u
+#define USART_CR3_DMAT_BIT         7u
+#define USART_CR3_DMAR_BIT         6u
+#define USART_CR3_EIE_BIT          0u
+#define USART_CR3_RTSE_BIT         8u
+#define USART_CR3_CTSE_BIT         9u
+
+/* DMA channel configuration constants (RM0444 DMA_CCRx / DMAMUX_CxCR) */
+#define RCC_AHBENR_DMA1_BIT        0u
+#define DMA_CCR_EN_BIT             0u
+#define DMA_CCR_TCIE_BIT           1u
+#define DMA_CCR_HTIE_BIT           2u
+#define DMA_CCR_TEIE_BIT           3u
+#define DMA_CCR_DIR_BIT            4u
+#define DMA_CCR_CIRC_BIT           5u
+#define DMA_CCR_MINC_BIT           7u
+#define DMA_ISR_TCIF1_BIT          1u
+#define DMA_ISR_TEIF1_BIT          3u
+#define DMA_IFCR_CGIF1_BIT         0u
+#define DMA_ISR_TCIF2_BIT          5u
+#define DMA_ISR_HTIF2_BIT          6u
+#define DMA_ISR_TEIF2_BIT          7u
+#define DMA_IFCR_CGIF2_BIT         4u
+#define DMAMUX_REQ_USART2_RX       52u
+#define DMAMUX_REQ_USART2_TX       53u
 
 /* Pin configuration constants */
 #define PA2_PIN_NUM                2u
@@ -43,16 +79,17 @@ extern "C" {
 #define AFR_BITS_PER_PIN           4u
 #define PA2_AFR_SHIFT              8u
 #define PA3_AFR_SHIFT              12u
+#define PA0_PIN_NUM                0u     /* USART2_CTS */
+#define PA1_PIN_NUM                1u     /* USART2_RTS */
+#define PA0_AFR_SHIFT              0u
+#define PA1_AFR_SHIFT              4u
 
-/* Baud rate calculation for 16MHz clock, 9600 baud */
-#define BAUD_RATE_9600_AT_16MHZ    1667u
-
-/* SysTick configuration for 1ms tick */
-#define SYSTICK_CTRL_ENABLE_BIT    0u
-#define SYSTICK_CTRL_CLKSRC_BIT    2u
-#define SYSTICK_CTRL_COUNTFLAG_BIT 16u
-#define SYSTICK_MS_DIVISOR         1000u
-#define SYSTEM_CORE_CLOCK 16000000UL // Default 16 MHz HSI clock
+/* Baud rate generator: BRR holds USARTDIV (16x oversampling) or, with
+ * OVER8, USARTDIV[15:4] and USARTDIV[3:1] in BRR[2:0] (8x oversampling) */
+#define USART_CR1_OVER8_BIT        15u
+#define USART_ISR_TC_BIT           6u
+#define UART_BRR_MIN               16u
+#define UART_BRR_MAX               0xFFFFu
 
 /* Global state variables for UART state machine */
 volatile char const * g_p_tx_buffer;
@@ -64,6 +101,110 @@ volatile uint32_t g_rx_index = 0u;
 volatile uart_state_t g_tx_state = UART_STATE_IDLE;
 volatile uart_state_t g_rx_state = UART_STATE_IDLE;
 volatile uart_error_t g_error = UART_ERROR_NONE;
+uint32_t g_baud = 0u;                       /* Rate programmed into BRR */
+
+/*
+ * TX queue (single producer / single consumer).
+ * The TX engine (ISR or DMA completion) walks a ring of (pointer, length)
+ * descriptors. uart_enqueue_slices() points descriptors straight at caller
+ * memory; uart_enqueue() first copies into the byte FIFO and queues
+ * descriptors over the copy, which are released again when they retire.
+ * The producer owns the heads, the TX engine owns the tails. Queued
+ * messages go out back-to-back with no idle gap between them. While a
+ * batch is open (uart_tx_batch_begin()) the engine is not started, does
+ * not chain into descriptors queued since the batch opened, and
+ * successive copies extend the last descriptor instead of adding one.
+ */
+#define UART_TX_FIFO_MASK          (UART_TX_FIFO_SIZE_BYTES - 1u)
+#define UART_TX_DESC_MASK          (UART_TX_DESC_COUNT - 1u)
+
+typedef struct
+{
+    char const * p_data;
+    uint32_t len;
+    uint32_t fifo_release;      /* FIFO bytes freed when this retires */
+} uart_tx_desc_t;
+
+NOINIT char g_tx_fifo_storage[UART_TX_FIFO_SIZE_BYTES];
+volatile uint32_t g_tx_fifo_head = 0u;
+volatile uint32_t g_tx_fifo_tail = 0u;
+uart_tx_desc_t g_tx_desc[UART_TX_DESC_COUNT];
+volatile uint32_t g_tx_desc_head = 0u;
+volatile uint32_t g_tx_desc_tail = 0u;      /* Free-running count of retired slices */
+volatile bool_t g_b_tx_from_desc = FALSE;
+volatile bool_t g_b_tx_batch = FALSE;       /* Kick deferred to uart_tx_batch_flush() */
+volatile uint32_t g_tx_batch_first = 0u;    /* First descriptor of the open batch */
+
+/*
+ * Statistics (uart_get_stats()). Each counter has a single writer - the
+ * TX engine, the USART2 ISR or the main-loop reader/producer - so none
+ * needs a lock. TX bytes are counted by the TX engine as each segment
+ * finishes, uart_transmit_buffer() strings included. Peaks are sampled
+ * where their writer already looks at the fill level: the FIFO after
+ * each enqueue, the RX ring on each read.
+ */
+volatile uint32_t g_stat_tx_bytes = 0u;
+uint32_t g_stat_rx_bytes = 0u;
+uint32_t g_stat_rx_frames = 0u;
+volatile uint32_t g_stat_errors[UART_ERROR_COUNT];
+uint32_t g_stat_rx_peak = 0u;
+uint32_t g_stat_tx_peak = 0u;
+uint32_t g_stat_tx_desc_peak = 0u;
+
+/*
+ * Continuous RX ring (single producer / single consumer).
+ * The ISR is the only writer of g_rx_ring_head and the main loop the only
+ * writer of g_rx_ring_tail. Both are free-running and masked on access, so
+ * head - tail is always the fill level and no critical section is needed.
+ */
+#define UART_RX_RING_MASK          (UART_RX_RING_SIZE_BYTES - 1u)
+
+NOINIT char g_rx_ring_storage[UART_RX_RING_SIZE_BYTES];
+volatile uint32_t g_rx_ring_head = 0u;
+volatile uint32_t g_rx_ring_tail = 0u;
+volatile uint32_t g_rx_ring_dropped = 0u;
+volatile bool_t g_b_rx_ring_active = FALSE;
+
+/*
+ * Receive flow control (UART_FLOW_RTS_CTS).
+ * With CR3.RTSE the USART deasserts RTS by itself while RDR holds an
+ * unread byte, so pausing reception is just not reading RDR: RXNEIE off
+ * (or DMAR off in UART_RX_MODE_DMA). The ISR holds when the ring is full
+ * and the reader releases once UART_RX_RESUME_FREE bytes are free again;
+ * uart_rx_hold() adds the application's own hold. Either one pauses.
+ */
+volatile bool_t g_b_rx_hold_ring = FALSE;
+volatile bool_t g_b_rx_hold_app = FALSE;
+
+#if (UART_FRAMING == UART_FRAMING_SLIP)
+/*
+ * SLIP framing (see slip.h).
+ * TX: the first byte queued after uart_frame_end() opens a frame with
+ * END; every queued byte is escaped and added to the running CRC until
+ * uart_frame_end() appends the CRC and the closing END.
+ * RX: the ISR decodes straight into the ring past g_rx_ring_head without
+ * publishing. A good frame moves the head to its end (the CRC bytes are
+ * dropped) and queues that end position; a corrupt one is dropped in
+ * O(1) by rewinding the write position to the head.
+ */
+#define UART_RX_FRAME_MASK         (UART_RX_FRAME_QUEUE - 1u)
+
+static char const g_slip_end[1] = { (char)SLIP_END };
+static char const g_slip_esc_end[2] = { (char)SLIP_ESC, (char)SLIP_ESC_END };
+static char const g_slip_esc_esc[2] = { (char)SLIP_ESC, (char)SLIP_ESC_ESC };
+
+uint16_t g_tx_frame_crc = SLIP_CRC_INIT;
+bool_t g_b_tx_frame_open = FALSE;
+
+slip_rx_t g_rx_slip;
+uint32_t g_rx_frame_pos = 0u;              /* ISR write position (unpublished) */
+uint32_t g_rx_frame_end[UART_RX_FRAME_QUEUE];
+volatile uint32_t g_rx_frame_head = 0u;
+volatile uint32_t g_rx_frame_tail = 0u;
+volatile uint32_t g_rx_frames_good = 0u;
+volatile uint32_t g_rx_frames_bad = 0u;      /* CRC, escape or line errors */
+volatile uint32_t g_rx_frames_dropped = 0u;  /* Good, but no room to keep */
+#endif
 
 /* Defining UART Registers used  */
 /*
@@ -74,6 +215,8 @@ If in the case where the JSON payload needs to be transmitte to a different Rx v
 RM0444 specification can be referred and set the USART instances along with their register values accordingly 
 
 USART_CR1 --> At an Offset of 0x00
+USART_CR2 --> At an Offset of 0x04
+USART_CR3 --> At an Offset of 0x08
 USART_BRR --> At an Offset of 0x0C
 USART_ISR --> At an Offset of 0x1C
 USART_ICR --> At an Offset of 0x20
@@ -84,6 +227,8 @@ USART_TDR --> At an Offset of 0x28
 volatile uint32_t * USART2 = (uint32_t *) 0x40004400; 
 
 volatile uint32_t * USART_CR1 = (uint32_t *) 0x40004400;
+volatile uint32_t * USART_CR2 = (uint32_t *) 0x40004404;
+volatile uint32_t * USART_CR3 = (uint32_t *) 0x40004408;
 volatile uint32_t * USART_BRR = (uint32_t *) 0x4000440C;
 volatile uint32_t * USART_ISR = (uint32_t *) 0x4000441C;
 volatile uint32_t * USART_ICR = (uint32_t *) 0x40004420;
@@ -100,6 +245,7 @@ RCC_APBENR1 --> At an Offset of 0x3C
 volatile uint32_t * RCC = (uint32_t *) 0x40021000;
 
 volatile uint32_t * RCC_IOPENR = (uint32_t *) 0x40021034;
+volatile uint32_t * RCC_AHBENR = (uint32_t *) 0x40021038;
 volatile uint32_t * RCC_APBENR1 = (uint32_t *) 0x4002103C;
 
 /* Defining GPIO Registers used  */
@@ -115,6 +261,43 @@ volatile uint32_t * GPIOA = (uint32_t *) 0x50000000;
 volatile uint32_t * GPIOx_MODER = (uint32_t *) 0x50000000;
 volatile uint32_t * GPIOx_AFRL = (uint32_t *) 0x50000020;
 
+/* Defining DMA Registers used  */
+/*
+
+USART2 TX is served by DMA1 channel 1, routed through DMAMUX channel 0
+(DMAMUX channel n feeds DMA channel n + 1). Request line 53 is USART2_TX.
+In UART_RX_MODE_DMA, USART2 RX (request 52) uses channel 2 / DMAMUX
+channel 1.
+
+DMA1_ISR    --> At an Offset of 0x00
+DMA1_IFCR   --> At an Offset of 0x04
+DMA1_CCR1   --> At an Offset of 0x08
+DMA1_CNDTR1 --> At an Offset of 0x0C
+DMA1_CPAR1  --> At an Offset of 0x10
+DMA1_CMAR1  --> At an Offset of 0x14
+DMA1_CCR2   --> At an Offset of 0x1C
+DMA1_CNDTR2 --> At an Offset of 0x20
+DMA1_CPAR2  --> At an Offset of 0x24
+DMA1_CMAR2  --> At an Offset of 0x28
+DMAMUX_C0CR --> At an Offset of 0x00 from DMAMUX base
+DMAMUX_C1CR --> At an Offset of 0x04 from DMAMUX base
+
+*/
+volatile uint32_t * DMA1 = (uint32_t *) 0x40020000;
+
+volatile uint32_t * DMA1_ISR = (uint32_t *) 0x40020000;
+volatile uint32_t * DMA1_IFCR = (uint32_t *) 0x40020004;
+volatile uint32_t * DMA1_CCR1 = (uint32_t *) 0x40020008;
+volatile uint32_t * DMA1_CNDTR1 = (uint32_t *) 0x4002000C;
+volatile uint32_t * DMA1_CPAR1 = (uint32_t *) 0x40020010;
+volatile uint32_t * DMA1_CMAR1 = (uint32_t *) 0x40020014;
+volatile uint32_t * DMA1_CCR2 = (uint32_t *) 0x4002001C;
+volatile uint32_t * DMA1_CNDTR2 = (uint32_t *) 0x40020020;
+volatile uint32_t * DMA1_CPAR2 = (uint32_t *) 0x40020024;
+volatile uint32_t * DMA1_CMAR2 = (uint32_t *) 0x40020028;
+volatile uint32_t * DMAMUX_C0CR = (uint32_t *) 0x40020800;
+volatile uint32_t * DMAMUX_C1CR = (uint32_t *) 0x40020804;
+
 /* Defining SysTick Registers used  */
 /*
 
@@ -130,6 +313,8 @@ volatile uint32_t * SYST_RVR = (uint32_t *) 0xE000E014;
 
 /* Interrupt Enable Number */
 #define USART2_IRQn 28u
+#define DMA1_Channel1_IRQn 9u
+#define DMA1_Channel2_3_IRQn 10u
 
 /* Inline functions for interrupt control */
 static inline void __enable_irq(void) {
@@ -145,12 +330,168 @@ static inline void NVIC_EnableIRQ(uint32_t IRQn) {
     NVIC_ISER0[IRQn >> 5] = (1u << (IRQn & 0x1F));
 }
 
+#if (UART_FLOW_CONTROL == UART_FLOW_RTS_CTS)
+/*!
+ * @brief Pause or resume continuous reception for the current holds.
+ *
+ * @note Call with interrupts masked: the ISRs write CR1 and CR3 too.
+ */
+static inline void uart_rx_flow_apply(void)
+{
+    bool_t const b_hold = (g_b_rx_hold_ring || g_b_rx_hold_app) ? TRUE : FALSE;
+
+    if ((FALSE == g_b_rx_ring_active) || (UART_STATE_RX_BUSY != g_rx_state))
+    {
+        return;
+    }
+
+#if (UART_RX_MODE == UART_RX_MODE_DMA)
+    if (b_hold)
+    {
+        *USART_CR3 &= ~(1u << USART_CR3_DMAR_BIT);
+    }
+    else
+    {
+        *USART_CR3 |= (1u << USART_CR3_DMAR_BIT);
+    }
+#else
+    if (b_hold)
+    {
+        *USART_CR1 &= ~(1u << USART_CR1_RXNEIE_BIT);
+    }
+    else
+    {
+        *USART_CR1 |= (1u << USART_CR1_RXNEIE_BIT);
+    }
+#endif
+}
+
+/*!
+ * @brief Let the sender go again once the reader has made room.
+ */
+static inline void uart_rx_flow_release(void)
+{
+#if (UART_FRAMING == UART_FRAMING_SLIP)
+    uint32_t const fill = g_rx_frame_pos - g_rx_ring_tail;
+#else
+    uint32_t const fill = g_rx_ring_head - g_rx_ring_tail;
+#endif
+
+    if (g_b_rx_hold_ring &&
+        (fill <= (UART_RX_RING_SIZE_BYTES - UART_RX_RESUME_FREE)))
+    {
+        __disable_irq();
+        g_b_rx_hold_ring = FALSE;
+        uart_rx_flow_apply();
+        __enable_irq();
+    }
+}
+#endif
+
+#if (UART_TX_MODE == UART_TX_MODE_DMA)
+/*!
+ * @brief Hand the current TX buffer to DMA1 channel 1.
+ *
+ * The channel streams g_tx_length bytes into USART_TDR on TXE requests
+ * and raises a single transfer-complete interrupt at the end.
+ */
+static inline void uart_dma_start_tx(void)
+{
+    *DMA1_CCR1 &= ~(1u << DMA_CCR_EN_BIT);
+    *DMA1_IFCR = (1u << DMA_IFCR_CGIF1_BIT);
+
+    *DMA1_CPAR1 = (uint32_t)(uintptr_t)USART_TDR;
+    *DMA1_CMAR1 = (uint32_t)(uintptr_t)g_p_tx_buffer;
+    *DMA1_CNDTR1 = g_tx_length;
+
+    /* Memory-to-peripheral, byte wide, memory increment, TC + TE interrupts */
+    *DMA1_CCR1 = (1u << DMA_CCR_MINC_BIT) |
+                 (1u << DMA_CCR_DIR_BIT) |
+                 (1u << DMA_CCR_TEIE_BIT) |
+                 (1u << DMA_CCR_TCIE_BIT);
+    *DMA1_CCR1 |= (1u << DMA_CCR_EN_BIT);
+}
+#endif
+
+/*!
+ * @brief Retire the current TX segment and load the next queued one.
+ *
+ * Retires the finished descriptor (releasing any FIFO bytes behind it)
+ * or counts the finished uart_transmit_buffer() string, then points the
+ * TX engine at the next queued slice. Leaves g_p_tx_buffer NULL when the
+ * queue is empty or the rest belongs to the open batch.
+ */
+static inline void uart_tx_load_next(void)
+{
+    uint32_t tail = g_tx_desc_tail;
+    uart_tx_desc_t const * p_desc;
+
+    if (g_b_tx_from_desc)
+    {
+        g_stat_tx_bytes += g_tx_desc[tail & UART_TX_DESC_MASK].len;
+        g_tx_fifo_tail += g_tx_desc[tail & UART_TX_DESC_MASK].fifo_release;
+        tail++;
+        g_tx_desc_tail = tail;
+        g_b_tx_from_desc = FALSE;
+        sched_signal(SCHED_TASK_TX);
+    }
+    else if (NULL != g_p_tx_buffer)
+    {
+        g_stat_tx_bytes += g_tx_length;
+    }
+
+    /* An open batch is held back whole until uart_tx_batch_flush() */
+    if ((g_tx_desc_head == tail) ||
+        (g_b_tx_batch && ((int32_t)(tail - g_tx_batch_first) >= 0)))
+    {
+        g_p_tx_buffer = NULL;
+        return;
+    }
+
+    p_desc = &g_tx_desc[tail & UART_TX_DESC_MASK];
+    g_p_tx_buffer = p_desc->p_data;
+    g_tx_length = p_desc->len;
+    g_tx_index = 0u;
+    g_b_tx_from_desc = TRUE;
+}
+
+/*!
+ * @brief Start the TX engine on the queue if it is idle.
+ *
+ * Does nothing while a batch is open; uart_tx_batch_flush() kicks.
+ *
+ * @note Caller must hold interrupts disabled.
+ */
+static inline void uart_tx_kick(void)
+{
+    if ((UART_STATE_IDLE == g_tx_state) && (FALSE == g_b_tx_batch))
+    {
+        g_tx_state = UART_STATE_TX_BUSY;
+        uart_tx_load_next();
+
+#if (UART_TX_MODE == UART_TX_MODE_DMA)
+        uart_dma_start_tx();
+#else
+        *USART_CR1 |= (1u << USART_CR1_TXEIE_BIT);
+#endif
+    }
+}
+
 /*!
  * @brief Process UART transmit interrupt.
- * @note Execution time: ~25-30 cycles.
+ *
+ * Continues straight into the next queued segment when the current one
+ * finishes, so back-to-back messages leave no idle gap on the line.
+ *
+ * @note Execution time: ~25-30 cycles (~45 on a segment boundary).
  */
 static inline void uart_process_tx(void)
 {
+    if ((NULL == g_p_tx_buffer) || (g_tx_index >= g_tx_length))
+    {
+        uart_tx_load_next();
+    }
+
     if ((NULL != g_p_tx_buffer) && (g_tx_index < g_tx_length))
     {
         *USART_TDR = (uint32_t)g_p_tx_buffer[g_tx_index];
@@ -162,6 +503,7 @@ static inline void uart_process_tx(void)
         *USART_CR1 &= ~(1u << USART_CR1_TXEIE_BIT);
         g_p_tx_buffer = NULL;
         g_tx_state = UART_STATE_IDLE;
+        sched_signal(SCHED_TASK_TX);
     }
 }
 
@@ -228,6 +570,7 @@ static inline uart_error_t uart_process_rx(void)
     {
         *USART_CR1 &= ~(1u << USART_CR1_RXNEIE_BIT);
         g_rx_state = UART_STATE_IDLE;
+        sched_signal(SCHED_TASK_RX);
         return UART_ERROR_NONE;
     }
     
@@ -243,153 +586,1488 @@ static inline uart_error_t uart_process_rx(void)
         g_p_rx_buffer[g_rx_index] = '\0';
         g_rx_state = UART_STATE_IDLE;
         *USART_CR1 &= ~(1u << USART_CR1_RXNEIE_BIT);
+        sched_signal(SCHED_TASK_RX);
     }
     
     return UART_ERROR_NONE;
 }
 
 /*!
- * @brief Initialize UART2 peripheral with 9600 baud, 8N1 configuration.
+ * @brief Record a receive error in g_error and count it (USART2 ISR).
+ */
+static inline void
+uart_rx_error_note (uart_error_t const error)
+{
+    g_error = error;
+    g_stat_errors[error]++;
+}
+
+/*!
+ * @brief Process UART receive interrupt in continuous ring mode.
  *
- * Configures GPIO pins PA2 (TX) and PA3 (RX) for UART alternate function,
- * enables peripheral clocks, and sets up UART2 for interrupt-driven operation.
+ * Never disables reception: hardware errors are cleared and recorded in
+ * g_error, corrupted bytes (framing/parity/noise) are discarded, and a
+ * full ring drops the newest byte and counts it in g_rx_ring_dropped.
  *
- * @return 0 on success, -1 if peripheral pointers are NULL.
+ * @note Execution time: ~25-35 cycles.
  */
-int32_t
-uart_init (void)
+static inline void uart_process_rx_ring(void)
 {
-    /* Verify peripheral base addresses are valid */
-    if ((NULL == GPIOA) || (NULL == RCC) || (NULL == USART2))
+    uint32_t isr = *USART_ISR;
+    uint32_t head = g_rx_ring_head;
+    char byte;
+
+#if (UART_FLOW_CONTROL == UART_FLOW_RTS_CTS)
+    if ((head - g_rx_ring_tail) >= UART_RX_RING_SIZE_BYTES)
     {
-        return -1;
+        /* Leave the byte in RDR: RTS stays deasserted until there is room */
+        g_b_rx_hold_ring = TRUE;
+        *USART_CR1 &= ~(1u << USART_CR1_RXNEIE_BIT);
+        return;
     }
-    
-    /* Enable peripheral clocks */
-    *RCC_APBENR1 |= (1u << RCC_APBENR1_USART2_BIT);
-    *RCC_IOPENR |= (1u << RCC_IOPENR_GPIOA_BIT);
+#endif
 
-    /* Configure PA2 (TX) and PA3 (RX) as alternate function mode */
-    *GPIOx_MODER &= ~(0x3u << (BITS_PER_PIN * PA2_PIN_NUM));
-    *GPIOx_MODER &= ~(0x3u << (BITS_PER_PIN * PA3_PIN_NUM));
-    *GPIOx_MODER |= (GPIO_MODER_AF_MODE << (BITS_PER_PIN * PA2_PIN_NUM));
-    *GPIOx_MODER |= (GPIO_MODER_AF_MODE << (BITS_PER_PIN * PA3_PIN_NUM));
+    byte = (char)*USART_RDR;
 
-    /* Set alternate function AF1 for USART2 on PA2 */
-    *GPIOx_AFRL &= ~(0xFu << PA2_AFR_SHIFT);
-    *GPIOx_AFRL |= (GPIO_AFR_AF1 << PA2_AFR_SHIFT);
+    if ((isr & ((1u << USART_ISR_ORE_BIT) | (1u << USART_ISR_FE_BIT) |
+                (1u << USART_ISR_NF_BIT) | (1u << USART_ISR_PE_BIT))) != 0u)
+    {
+        *USART_ICR = (isr & ((1u << USART_ISR_ORE_BIT) | (1u << USART_ISR_FE_BIT) |
+                             (1u << USART_ISR_NF_BIT) | (1u << USART_ISR_PE_BIT)));
 
-    /* Set alternate function AF1 for USART2 on PA3 */
-    *GPIOx_AFRL &= ~(0xFu << PA3_AFR_SHIFT);
-    *GPIOx_AFRL |= (GPIO_AFR_AF1 << PA3_AFR_SHIFT);
+        if ((isr & (1u << USART_ISR_ORE_BIT)) == 0u)
+        {
+            /* Byte in RDR is corrupted - drop it */
+            uart_rx_error_note(((isr & (1u << USART_ISR_FE_BIT)) != 0u) ? UART_ERROR_FRAMING :
+                               ((isr & (1u << USART_ISR_PE_BIT)) != 0u) ? UART_ERROR_PARITY :
+                                                                          UART_ERROR_NOISE);
+            return;
+        }
 
-    /* Configure baud rate for 9600 @ 16MHz system clock */
-    *USART_BRR = BAUD_RATE_9600_AT_16MHZ;
-    
-    /* Enable USART, transmitter, and receiver */
-    *USART_CR1 |= ((1u << USART_CR1_UE_BIT) | 
-                    (1u << USART_CR1_TE_BIT) | 
-                    (1u << USART_CR1_RE_BIT));
-        
-    return 0;
+        /* Overrun: earlier bytes were lost but RDR still holds a valid one */
+        uart_rx_error_note(UART_ERROR_OVERRUN);
+    }
+
+    if ((head - g_rx_ring_tail) >= UART_RX_RING_SIZE_BYTES)
+    {
+        g_rx_ring_dropped++;
+        return;
+    }
+
+    g_rx_ring_storage[head & UART_RX_RING_MASK] = byte;
+
+    /* Store the byte before publishing the new head */
+    __asm volatile ("" : : : "memory");
+    g_rx_ring_head = head + 1u;
+    sched_signal(SCHED_TASK_RX);
 }
 
+#if (UART_FRAMING == UART_FRAMING_SLIP)
 /*!
- * @brief Transmit a null-terminated string via UART2.
+ * @brief Close a received SLIP frame.
  *
- * Initiates interrupt-driven transmission. The ISR handles byte-by-byte
- * transmission until the entire string is sent.
+ * A good frame is published in one step - head moves to the end of its
+ * payload and the end position is queued for uart_rx_read_frame(). Any
+ * other frame is dropped by rewinding the write position.
+ */
+static inline void
+uart_rx_frame_close (slip_rx_event_t const event)
+{
+    uint32_t const head = g_rx_ring_head;
+    uint32_t const end = head + g_rx_slip.frame_len;
+    uint32_t const queued = g_rx_frame_head;
+
+    if (SLIP_RX_FRAME == event)
+    {
+        if ((queued - g_rx_frame_tail) >= UART_RX_FRAME_QUEUE)
+        {
+            g_rx_frames_dropped++;
+        }
+        else
+        {
+            g_rx_frame_end[queued & UART_RX_FRAME_MASK] = end;
+            g_rx_frames_good++;
+
+            /* Store the payload and its end before publishing either */
+            __asm volatile ("" : : : "memory");
+            g_rx_ring_head = end;
+            g_rx_frame_head = queued + 1u;
+            sched_signal(SCHED_TASK_RX);
+        }
+    }
+    else if (SLIP_RX_BAD == event)
+    {
+        g_rx_frames_bad++;
+    }
+    else
+    {
+        /* Idle END between frames */
+    }
+
+    g_rx_frame_pos = g_rx_ring_head;
+}
+
+/*!
+ * @brief Process UART receive interrupt in framed (SLIP) ring mode.
  *
- * @param[in] p_str Pointer to null-terminated string to transmit.
+ * Decodes one byte into the frame being received. Line errors and a
+ * full ring cost the whole frame, which is then rejected at its END.
  *
- * @return 0 on success, -1 if p_str is NULL, -2 if transmitter busy.
+ * @note Execution time: ~50-70 cycles (CRC update included).
  */
-int32_t
-uart_transmit_buffer (char const * const p_str)
+static inline void
+uart_process_rx_frame (void)
 {
-    if (NULL == p_str)
+    uint32_t isr = *USART_ISR;
+    uint8_t byte;
+    slip_rx_event_t event;
+
+#if (UART_FLOW_CONTROL == UART_FLOW_RTS_CTS)
+    /* Hold while reading frames can make room; a frame bigger than the
+     * whole ring still has to be dropped below */
+    if (((g_rx_frame_pos - g_rx_ring_tail) >= UART_RX_RING_SIZE_BYTES) &&
+        (g_rx_ring_head != g_rx_ring_tail))
     {
-        return -1;
+        g_b_rx_hold_ring = TRUE;
+        *USART_CR1 &= ~(1u << USART_CR1_RXNEIE_BIT);
+        return;
     }
+#endif
 
-    /* Critical section: check and update TX state atomically */
-    __disable_irq();
-        
-    if (UART_STATE_IDLE != g_tx_state)
+    byte = (uint8_t)*USART_RDR;
+
+    if ((isr & ((1u << USART_ISR_ORE_BIT) | (1u << USART_ISR_FE_BIT) |
+                (1u << USART_ISR_NF_BIT) | (1u << USART_ISR_PE_BIT))) != 0u)
     {
-        __enable_irq();
-        return -2;
+        *USART_ICR = (isr & ((1u << USART_ISR_ORE_BIT) | (1u << USART_ISR_FE_BIT) |
+                             (1u << USART_ISR_NF_BIT) | (1u << USART_ISR_PE_BIT)));
+
+        slip_rx_fail(&g_rx_slip);
+
+        if ((isr & (1u << USART_ISR_ORE_BIT)) == 0u)
+        {
+            /* Byte in RDR is corrupted - drop it (and its frame) */
+            uart_rx_error_note(((isr & (1u << USART_ISR_FE_BIT)) != 0u) ? UART_ERROR_FRAMING :
+                               ((isr & (1u << USART_ISR_PE_BIT)) != 0u) ? UART_ERROR_PARITY :
+                                                                          UART_ERROR_NOISE);
+            return;
+        }
+
+        /* Overrun: the frame lost bytes, but an END in RDR still counts */
+        uart_rx_error_note(UART_ERROR_OVERRUN);
     }
 
-    g_tx_state = UART_STATE_TX_BUSY;
-    __enable_irq();
+    event = slip_rx_byte(&g_rx_slip, &byte);
 
-    /* Initialize transmission parameters */
-    g_p_tx_buffer = p_str;
-    g_tx_length = (uint32_t)strlen(p_str);
-    g_tx_index = 0u;
-    
-    /* Enable TXE interrupt to start transmission */
-    *USART_CR1 |= (1u << USART_CR1_TXEIE_BIT);
-    
-    return 0;
+    if (SLIP_RX_DATA == event)
+    {
+        if ((g_rx_frame_pos - g_rx_ring_tail) >= UART_RX_RING_SIZE_BYTES)
+        {
+            g_rx_ring_dropped++;
+            slip_rx_fail(&g_rx_slip);
+        }
+        else
+        {
+            g_rx_ring_storage[g_rx_frame_pos & UART_RX_RING_MASK] = (char)byte;
+            g_rx_frame_pos++;
+        }
+    }
+    else if (SLIP_RX_NONE != event)
+    {
+        uart_rx_frame_close(event);
+    }
+    else
+    {
+        /* ESC or idle END: nothing stored */
+    }
 }
+#endif
+
+#if (UART_RX_MODE == UART_RX_MODE_DMA)
+/*
+ * DMA reception (UART_RX_MODE_DMA).
+ * DMA1 channel 2 moves every byte from RDR into memory, so there is no
+ * per-byte interrupt. The USART interrupts once per frame instead: on
+ * character match (ADD = UART_RX_MATCH_CHAR) and on idle line.
+ *   Ring mode: the channel runs circular over g_rx_ring_storage and each
+ *   frame event publishes the DMA write position as the new head. The
+ *   half and full transfer interrupts do the same during long bursts, so
+ *   the head never falls a whole lap behind.
+ *   Line mode (uart_receive_buffer()): a single transfer into
+ *   g_p_rx_buffer. A frame event that finds '\n' or '\r' as the last byte
+ *   ends the line like uart_process_rx() does; a full buffer ends it too.
+ * The match interrupt can run before DMA has stored the matched byte;
+ * the idle interrupt that follows every burst catches that byte up.
+ */
+#define UART_RX_DMA_ERROR_FLAGS    ((1u << USART_ISR_ORE_BIT) | (1u << USART_ISR_FE_BIT) | \
+                                    (1u << USART_ISR_NF_BIT) | (1u << USART_ISR_PE_BIT))
+#define UART_RX_DMA_FRAME_FLAGS    ((1u << USART_ISR_IDLE_BIT) | (1u << USART_ISR_CMF_BIT))
 
 /*!
- * @brief Enable interrupt-driven UART reception.
- *
- * Prepares the receiver state machine and enables RXNE interrupt.
- * Reception continues until newline or buffer overflow.
+ * @brief Start DMA1 channel 2 on RDR and arm the frame interrupts.
  *
- * @return 0 on success, -1 if receiver already busy.
+ * @param[out] p_dst Destination memory.
+ * @param[in] len Transfer length in bytes.
+ * @param[in] b_circular TRUE for the ring (wraps, half-transfer IRQ).
  */
-int32_t
-uart_receive_buffer (void)
+static void
+uart_rx_dma_start (char * const p_dst, uint32_t const len,
+                   bool_t const b_circular)
 {
-    /* Critical section: check and update RX state atomically */
-    __disable_irq();
-        
-    if (UART_STATE_IDLE != g_rx_state)
-    {
-        __enable_irq();
-        return -1;
-    }
-    
-    g_rx_state = UART_STATE_RX_BUSY;
-    __enable_irq();
+    *DMA1_CCR2 &= ~(1u << DMA_CCR_EN_BIT);
+    *DMA1_IFCR = (1u << DMA_IFCR_CGIF2_BIT);
 
-    /* Enable RXNE interrupt to start reception */
-    *USART_CR1 |= (1u << USART_CR1_RXNEIE_BIT);
-    
-    return 0;
+    *DMA1_CPAR2 = (uint32_t)(uintptr_t)USART_RDR;
+    *DMA1_CMAR2 = (uint32_t)(uintptr_t)p_dst;
+    *DMA1_CNDTR2 = len;
+
+    /* Peripheral-to-memory, byte wide, memory increment, TC + TE interrupts */
+    *DMA1_CCR2 = (1u << DMA_CCR_MINC_BIT) |
+                 (1u << DMA_CCR_TEIE_BIT) |
+                 (1u << DMA_CCR_TCIE_BIT) |
+                 (b_circular ? ((1u << DMA_CCR_CIRC_BIT) |
+                                (1u << DMA_CCR_HTIE_BIT)) : 0u);
+    *DMA1_CCR2 |= (1u << DMA_CCR_EN_BIT);
+
+    /* Drop stale events, then let RXNE raise DMA requests */
+    *USART_ICR = (UART_RX_DMA_ERROR_FLAGS | UART_RX_DMA_FRAME_FLAGS);
+    *USART_CR3 |= ((1u << USART_CR3_DMAR_BIT) | (1u << USART_CR3_EIE_BIT));
+    *USART_CR1 |= ((1u << USART_CR1_IDLEIE_BIT) | (1u << USART_CR1_CMIE_BIT) |
+                   (1u << USART_CR1_PEIE_BIT));
 }
 
 /*!
- * @brief USART2 interrupt service routine.
+ * @brief Stop DMA reception and its interrupts.
+ */
+static void
+uart_rx_dma_stop (void)
+{
+    *USART_CR1 &= ~((1u << USART_CR1_IDLEIE_BIT) | (1u << USART_CR1_CMIE_BIT) |
+                    (1u << USART_CR1_PEIE_BIT));
+    *USART_CR3 &= ~((1u << USART_CR3_DMAR_BIT) | (1u << USART_CR3_EIE_BIT));
+    *DMA1_CCR2 &= ~(1u << DMA_CCR_EN_BIT);
+}
+
+/*!
+ * @brief Publish the bytes DMA has written into the ring.
  *
- * Handles both TX and RX interrupts with error detection.
- * TX: Sends next byte or disables interrupt when complete.
- * RX: Receives bytes until newline or error, with overflow protection.
+ * DMA cannot drop the newest byte when the ring is full, it overwrites
+ * the oldest unread ones instead; those are counted in g_rx_ring_dropped
+ * and skipped by uart_rx_read().
+ *
+ * @note Execution time: ~20 cycles, once per frame or half ring.
  */
-void
-USART2_IRQHandler (void)
+static inline void
+uart_rx_dma_sync (void)
 {
-    bool_t b_has_error = FALSE;  /* Changed to bool_t for Keil */
+    uint32_t head = g_rx_ring_head;
+    uint32_t const pos = (UART_RX_RING_SIZE_BYTES - *DMA1_CNDTR2) & UART_RX_RING_MASK;
+    uint32_t const old_fill = head - g_rx_ring_tail;
+    uint32_t fill;
 
-    /* Handle transmit interrupt - TXE flag set */
-    if (((*USART_ISR & (1u << USART_ISR_TXE_BIT)) != 0u) && 
-        (UART_STATE_TX_BUSY == g_tx_state))
+    head += (pos - head) & UART_RX_RING_MASK;
+    fill = head - g_rx_ring_tail;
+
+    if (fill > UART_RX_RING_SIZE_BYTES)
     {
-        uart_process_tx();
+        /* Count only bytes lost since the last update */
+        g_rx_ring_dropped += fill - ((old_fill > UART_RX_RING_SIZE_BYTES) ?
+                                     old_fill : UART_RX_RING_SIZE_BYTES);
     }
 
-    /* Handle receive interrupt - RXNE flag set */
-    if (((*USART_ISR & (1u << USART_ISR_RXNE_BIT)) != 0u) && 
-        (UART_STATE_RX_BUSY == g_rx_state))
+    /* DMA stored the bytes before CNDTR moved: publish the new head */
+    __asm volatile ("" : : : "memory");
+    g_rx_ring_head = head;
+    sched_signal(SCHED_TASK_RX);
+
+#if (UART_FLOW_CONTROL == UART_FLOW_RTS_CTS)
+    /* Up to half a ring arrives before the next update: hold if that
+     * would lap the reader */
+    if (fill > (UART_RX_RING_SIZE_BYTES / 2u))
     {
-        g_error = uart_process_rx();
+        g_b_rx_hold_ring = TRUE;
+        *USART_CR3 &= ~(1u << USART_CR3_DMAR_BIT);
     }
-
+#endif
+}
+
+/*!
+ * @brief End the DMA line reception if the line is complete.
+ *
+ * @param[in] b_full TRUE if the buffer is full (transfer complete).
+ */
+static inline void
+uart_rx_dma_line_check (bool_t const b_full)
+{
+    uint32_t const count = (RX_BUFFER_SIZE_BYTES - 1u) - *DMA1_CNDTR2;
+
+    g_rx_index = count;
+
+    if (b_full ||
+        ((count > 0u) && (('\n' == g_p_rx_buffer[count - 1u]) ||
+                          ('\r' == g_p_rx_buffer[count - 1u]))))
+    {
+        uart_rx_dma_stop();
+        g_p_rx_buffer[count] = '\0';
+        g_rx_state = UART_STATE_IDLE;
+        sched_signal(SCHED_TASK_RX);
+    }
+}
+
+/*!
+ * @brief Error code for the USART_ISR error flags (as uart_handle_rx_error()).
+ */
+static inline uart_error_t
+uart_rx_dma_error (uint32_t const isr)
+{
+    return ((isr & (1u << USART_ISR_ORE_BIT)) != 0u) ? UART_ERROR_OVERRUN :
+           ((isr & (1u << USART_ISR_FE_BIT)) != 0u)  ? UART_ERROR_FRAMING :
+           ((isr & (1u << USART_ISR_PE_BIT)) != 0u)  ? UART_ERROR_PARITY :
+                                                       UART_ERROR_NOISE;
+}
+
+/*!
+ * @brief Process the USART frame and error interrupts in DMA RX mode.
+ *
+ * Line mode stops on a hardware error with g_rx_state = ERROR, exactly
+ * as the per-byte path does. The ring keeps receiving and records the
+ * error in g_error; DMA has already stored the byte.
+ */
+static inline void
+uart_process_rx_dma (void)
+{
+    uint32_t const isr = *USART_ISR;
+
+    if ((isr & UART_RX_DMA_ERROR_FLAGS) != 0u)
+    {
+        *USART_ICR = (isr & UART_RX_DMA_ERROR_FLAGS);
+        uart_rx_error_note(uart_rx_dma_error(isr));
+
+        if (FALSE == g_b_rx_ring_active)
+        {
+            uart_rx_dma_stop();
+            g_rx_state = UART_STATE_ERROR;
+            return;
+        }
+    }
+
+    if ((isr & UART_RX_DMA_FRAME_FLAGS) != 0u)
+    {
+        *USART_ICR = (isr & UART_RX_DMA_FRAME_FLAGS);
+
+        if (g_b_rx_ring_active)
+        {
+            uart_rx_dma_sync();
+        }
+        else
+        {
+            uart_rx_dma_line_check(FALSE);
+        }
+    }
+}
+#endif
+
+/*!
+ * @brief Check a generated rate against the requested one.
+ *
+ * @return TRUE if they differ by at most UART_BAUD_TOLERANCE_PCT.
+ */
+static bool_t
+uart_baud_close (uint32_t const actual, uint32_t const baud)
+{
+    uint32_t const error = (actual > baud) ? (actual - baud) : (baud - actual);
+
+    return ((error * 100u) <= (baud * UART_BAUD_TOLERANCE_PCT)) ? TRUE : FALSE;
+}
+
+
+/*!
+ * @brief Compute BRR and the oversampling mode for a baud rate.
+ *
+ * Uses 16x oversampling when USARTDIV = PCLK / baud is at least 16 and
+ * close enough after rounding. Otherwise it falls back to 8x (OVER8),
+ * which has twice the divisor resolution and doubles the highest rate
+ * to PCLK / 8, at the cost of some noise immunity.
+ *
+ * @param[in]  baud       Requested rate in bit/s.
+ * @param[out] p_brr      Value for USART_BRR.
+ * @param[out] p_b_over8  TRUE if CR1.OVER8 must be set.
+ *
+ * @return 0 on success, -1 if the rate is out of range for the current
+ *         clock or would be off by more than UART_BAUD_TOLERANCE_PCT.
+ */
+static int32_t
+uart_baud_divisor (uint32_t const baud, uint32_t * const p_brr,
+                   bool_t * const p_b_over8)
+{
+    uint32_t const pclk = clock_get_hz();
+    uint32_t div;
+
+    if ((0u == baud) || (baud > (pclk / 8u)))
+    {
+        return -1;
+    }
+
+    div = (pclk + (baud / 2u)) / baud;
+
+    if (div > UART_BRR_MAX)
+    {
+        return -1;
+    }
+
+    if ((div >= UART_BRR_MIN) && uart_baud_close(pclk / div, baud))
+    {
+        *p_brr = div;
+        *p_b_over8 = FALSE;
+        return 0;
+    }
+
+    /* Divisor in eighths of a bit: DIV[3:0] is shifted right by one */
+    div = ((2u * pclk) + (baud / 2u)) / baud;
+
+    if ((div < UART_BRR_MIN) || (div > UART_BRR_MAX) ||
+        (FALSE == uart_baud_close((2u * pclk) / div, baud)))
+    {
+        return -1;
+    }
+
+    *p_brr = (div & ~0xFu) | ((div & 0xFu) >> 1);
+    *p_b_over8 = TRUE;
+
+    return 0;
+}
+
+
+/*!
+ * @brief Write BRR and OVER8 (the USART must be disabled).
+ */
+static void
+uart_baud_apply (uint32_t const baud, uint32_t const brr,
+                 bool_t const b_over8)
+{
+    if (b_over8)
+    {
+        *USART_CR1 |= (1u << USART_CR1_OVER8_BIT);
+    }
+    else
+    {
+        *USART_CR1 &= ~(1u << USART_CR1_OVER8_BIT);
+    }
+
+    *USART_BRR = brr;
+    g_baud = baud;
+}
+
+/*!
+ * @brief Initialize UART2 peripheral with UART_BAUD_RATE, 8N1 configuration.
+ *
+ * Configures GPIO pins PA2 (TX) and PA3 (RX) for UART alternate function,
+ * enables peripheral clocks, and sets up UART2 for interrupt-driven operation.
+ * The baud rate divisor is derived from clock_get_hz().
+ *
+ * @return 0 on success, -1 if peripheral pointers are NULL or
+ *         UART_BAUD_RATE cannot be made from the current clock.
+ */
+int32_t
+uart_init (void)
+{
+    uint32_t brr = 0u;
+    bool_t b_over8 = FALSE;
+
+    /* Verify peripheral base addresses are valid */
+    if ((NULL == GPIOA) || (NULL == RCC) || (NULL == USART2))
+    {
+        return -1;
+    }
+
+    if (0 != uart_baud_divisor(UART_BAUD_RATE, &brr, &b_over8))
+    {
+        return -1;
+    }
+    
+    /* Enable peripheral clocks */
+    *RCC_APBENR1 |= (1u << RCC_APBENR1_USART2_BIT);
+    *RCC_IOPENR |= (1u << RCC_IOPENR_GPIOA_BIT);
+
+    /* Configure PA2 (TX) and PA3 (RX) as alternate function mode */
+    *GPIOx_MODER &= ~(0x3u << (BITS_PER_PIN * PA2_PIN_NUM));
+    *GPIOx_MODER &= ~(0x3u << (BITS_PER_PIN * PA3_PIN_NUM));
+    *GPIOx_MODER |= (GPIO_MODER_AF_MODE << (BITS_PER_PIN * PA2_PIN_NUM));
+    *GPIOx_MODER |= (GPIO_MODER_AF_MODE << (BITS_PER_PIN * PA3_PIN_NUM));
+
+    /* Set alternate function AF1 for USART2 on PA2 */
+    *GPIOx_AFRL &= ~(0xFu << PA2_AFR_SHIFT);
+    *GPIOx_AFRL |= (GPIO_AFR_AF1 << PA2_AFR_SHIFT);
+
+    /* Set alternate function AF1 for USART2 on PA3 */
+    *GPIOx_AFRL &= ~(0xFu << PA3_AFR_SHIFT);
+    *GPIOx_AFRL |= (GPIO_AFR_AF1 << PA3_AFR_SHIFT);
+
+#if (UART_FLOW_CONTROL == UART_FLOW_RTS_CTS)
+    /* PA0 (CTS) and PA1 (RTS) on AF1, hardware flow control on */
+    *GPIOx_MODER &= ~(0x3u << (BITS_PER_PIN * PA0_PIN_NUM));
+    *GPIOx_MODER &= ~(0x3u << (BITS_PER_PIN * PA1_PIN_NUM));
+    *GPIOx_MODER |= (GPIO_MODER_AF_MODE << (BITS_PER_PIN * PA0_PIN_NUM));
+    *GPIOx_MODER |= (GPIO_MODER_AF_MODE << (BITS_PER_PIN * PA1_PIN_NUM));
+    *GPIOx_AFRL &= ~((0xFu << PA0_AFR_SHIFT) | (0xFu << PA1_AFR_SHIFT));
+    *GPIOx_AFRL |= ((GPIO_AFR_AF1 << PA0_AFR_SHIFT) | (GPIO_AFR_AF1 << PA1_AFR_SHIFT));
+    *USART_CR3 |= ((1u << USART_CR3_RTSE_BIT) | (1u << USART_CR3_CTSE_BIT));
+#endif
+
+    /* Configure baud rate for the current PCLK */
+    uart_baud_apply(UART_BAUD_RATE, brr, b_over8);
+
+#if (UART_TX_MODE == UART_TX_MODE_DMA)
+    /* Route USART2_TX requests to DMA1 channel 1 */
+    *RCC_AHBENR |= (1u << RCC_AHBENR_DMA1_BIT);
+    *DMAMUX_C0CR = DMAMUX_REQ_USART2_TX;
+    *USART_CR3 |= (1u << USART_CR3_DMAT_BIT);
+    NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+#endif
+
+#if (UART_RX_MODE == UART_RX_MODE_DMA)
+    /* Route USART2_RX requests to DMA1 channel 2; the match character can
+     * only be set while the USART is disabled */
+    *RCC_AHBENR |= (1u << RCC_AHBENR_DMA1_BIT);
+    *DMAMUX_C1CR = DMAMUX_REQ_USART2_RX;
+    *USART_CR2 = (*USART_CR2 & ~(0xFFu << USART_CR2_ADD_SHIFT)) |
+                 ((uint32_t)(uint8_t)UART_RX_MATCH_CHAR << USART_CR2_ADD_SHIFT) |
+                 (1u << USART_CR2_ADDM7_BIT);
+    NVIC_EnableIRQ(DMA1_Channel2_3_IRQn);
+#endif
+    
+    /* Enable USART, transmitter, and receiver */
+    *USART_CR1 |= ((1u << USART_CR1_UE_BIT) | 
+                    (1u << USART_CR1_TE_BIT) | 
+                    (1u << USART_CR1_RE_BIT));
+        
+    return 0;
+}
+
+
+/*!
+ * @brief Change the baud rate at run time.
+ *
+ * Also the way to follow a core clock change: call it again with the
+ * same rate after clock_set_sysclk(). The USART is disabled for the few
+ * cycles BRR takes to write, so a byte arriving just then may be lost;
+ * the peer has to switch rates at an agreed point anyway.
+ *
+ * @param[in] baud New rate in bit/s.
+ *
+ * @return 0 on success, -1 if the rate cannot be made from the current
+ *         clock (the old rate stays), -2 if transmission is in progress.
+ */
+int32_t
+uart_set_baud (uint32_t const baud)
+{
+    uint32_t brr = 0u;
+    bool_t b_over8 = FALSE;
+
+    if (0 != uart_baud_divisor(baud, &brr, &b_over8))
+    {
+        return -1;
+    }
+
+    /* Wait for the queue to drain and the last stop bit to leave */
+    if ((UART_STATE_IDLE != g_tx_state) ||
+        (g_tx_desc_head != g_tx_desc_tail) ||
+        (0u == (*USART_ISR & (1u << USART_ISR_TC_BIT))))
+    {
+        return -2;
+    }
+
+    *USART_CR1 &= ~(1u << USART_CR1_UE_BIT);
+    uart_baud_apply(baud, brr, b_over8);
+    *USART_CR1 |= (1u << USART_CR1_UE_BIT);
+
+    return 0;
+}
+
+
+/*!
+ * @brief Get the baud rate currently programmed.
+ *
+ * @return Rate in bit/s (0 before uart_init()).
+ */
+uint32_t
+uart_get_baud (void)
+{
+    return g_baud;
+}
+
+/*!
+ * @brief Transmit a null-terminated string via UART2.
+ *
+ * Initiates interrupt-driven transmission. In UART_TX_MODE_IRQ the ISR
+ * handles byte-by-byte transmission until the entire string is sent; in
+ * UART_TX_MODE_DMA the whole buffer is handed to DMA and g_tx_state
+ * returns to IDLE from the transfer-complete interrupt. The buffer must
+ * stay valid until then.
+ *
+ * @param[in] p_str Pointer to null-terminated string to transmit.
+ *
+ * @return 0 on success, -1 if p_str is NULL, -2 if transmitter busy.
+ */
+int32_t
+uart_transmit_buffer (char const * const p_str)
+{
+    if (NULL == p_str)
+    {
+        return -1;
+    }
+
+    /* Critical section: check and update TX state atomically */
+    __disable_irq();
+        
+    if (UART_STATE_IDLE != g_tx_state)
+    {
+        __enable_irq();
+        return -2;
+    }
+
+    g_tx_state = UART_STATE_TX_BUSY;
+    __enable_irq();
+
+    /* Initialize transmission parameters */
+    g_p_tx_buffer = p_str;
+    g_tx_length = (uint32_t)strlen(p_str);
+    g_tx_index = 0u;
+
+#if (UART_TX_MODE == UART_TX_MODE_DMA)
+    if (0u == g_tx_length)
+    {
+        /* Nothing to hand to DMA - complete immediately */
+        g_p_tx_buffer = NULL;
+        g_tx_state = UART_STATE_IDLE;
+        return 0;
+    }
+
+    uart_dma_start_tx();
+#else
+    /* Enable TXE interrupt to start transmission */
+    *USART_CR1 |= (1u << USART_CR1_TXEIE_BIT);
+#endif
+    
+    return 0;
+}
+
+/*!
+ * @brief Update the TX FIFO and descriptor peaks after queueing (main loop).
+ */
+static inline void
+uart_tx_peak_note (void)
+{
+    uint32_t const fill = g_tx_fifo_head - g_tx_fifo_tail;
+    uint32_t const descs = g_tx_desc_head - g_tx_desc_tail;
+
+    if (fill > g_stat_tx_peak)
+    {
+        g_stat_tx_peak = fill;
+    }
+
+    if (descs > g_stat_tx_desc_peak)
+    {
+        g_stat_tx_desc_peak = descs;
+    }
+}
+
+/*!
+ * @brief Try to append a FIFO copy to the last queued descriptor.
+ *
+ * Only while a batch is open, and only into a descriptor the TX engine
+ * cannot load under us: any one when the engine is idle, otherwise one
+ * queued since the batch opened (held back until the flush). The copy
+ * must start where that descriptor's FIFO bytes end.
+ *
+ * @return TRUE if the descriptor now also covers len bytes at offset.
+ */
+static inline bool_t
+uart_fifo_coalesce (uint32_t const desc, uint32_t const offset,
+                    uint32_t const len)
+{
+    uart_tx_desc_t * p_last;
+
+    if ((FALSE == g_b_tx_batch) || (desc == g_tx_desc_tail))
+    {
+        return FALSE;
+    }
+
+    if ((UART_STATE_IDLE != g_tx_state) &&
+        ((int32_t)((desc - 1u) - g_tx_batch_first) < 0))
+    {
+        return FALSE;
+    }
+
+    p_last = &g_tx_desc[(desc - 1u) & UART_TX_DESC_MASK];
+
+    if ((p_last->fifo_release != p_last->len) ||
+        (&p_last->p_data[p_last->len] != &g_tx_fifo_storage[offset]))
+    {
+        return FALSE;
+    }
+
+    p_last->len += len;
+    p_last->fifo_release += len;
+
+    return TRUE;
+}
+
+/*!
+ * @brief Copy slices into the TX FIFO and queue descriptors over them.
+ *
+ * The slices become one contiguous run (two if it wraps). With b_frame
+ * set the bytes are SLIP-escaped on the way in and added to the frame
+ * CRC, opening the frame with END first if needed; otherwise they are
+ * copied as they are. All slices are queued or none.
+ *
+ * @return 0 on success, -2 if the queue is full.
+ */
+static int32_t
+uart_fifo_enqueue (uart_slice_t const * const p_slices, uint32_t const count,
+                   bool_t const b_frame)
+{
+    uint32_t head = g_tx_fifo_head;
+    uint32_t desc = g_tx_desc_head;
+    uint32_t offset = head & UART_TX_FIFO_MASK;
+    uint32_t out_len = 0u;
+    uint32_t run;
+    uint32_t pos;
+    uint32_t i;
+    uint32_t j;
+
+    for (i = 0u; i < count; i++)
+    {
+        out_len += p_slices[i].len;
+    }
+
+    if (0u == out_len)
+    {
+        return 0;
+    }
+
+#if (UART_FRAMING == UART_FRAMING_SLIP)
+    if (b_frame)
+    {
+        out_len += g_b_tx_frame_open ? 0u : 1u;
+
+        for (i = 0u; i < count; i++)
+        {
+            for (j = 0u; j < p_slices[i].len; j++)
+            {
+                out_len += slip_is_special((uint8_t)p_slices[i].p_data[j]) ?
+                           1u : 0u;
+            }
+        }
+    }
+#else
+    (void)b_frame;
+#endif
+
+    /* Worst case the copy wraps and needs two descriptors */
+    if ((out_len > (UART_TX_FIFO_SIZE_BYTES - (head - g_tx_fifo_tail))) ||
+        (2u > (UART_TX_DESC_COUNT - (desc - g_tx_desc_tail))))
+    {
+        return -2;
+    }
+
+    pos = head;
+
+#if (UART_FRAMING == UART_FRAMING_SLIP)
+    if (b_frame)
+    {
+        if (FALSE == g_b_tx_frame_open)
+        {
+            g_tx_fifo_storage[pos & UART_TX_FIFO_MASK] = (char)SLIP_END;
+            pos++;
+            g_tx_frame_crc = SLIP_CRC_INIT;
+            g_b_tx_frame_open = TRUE;
+        }
+
+        for (i = 0u; i < count; i++)
+        {
+            for (j = 0u; j < p_slices[i].len; j++)
+            {
+                uint8_t const byte = (uint8_t)p_slices[i].p_data[j];
+
+                g_tx_frame_crc = slip_crc_update(g_tx_frame_crc, byte);
+
+                if (slip_is_special(byte))
+                {
+                    g_tx_fifo_storage[pos & UART_TX_FIFO_MASK] = (char)SLIP_ESC;
+                    pos++;
+                    g_tx_fifo_storage[pos & UART_TX_FIFO_MASK] =
+                        (char)slip_escape_code(byte);
+                }
+                else
+                {
+                    g_tx_fifo_storage[pos & UART_TX_FIFO_MASK] = (char)byte;
+                }
+                pos++;
+            }
+        }
+    }
+    else
+#endif
+    {
+        for (i = 0u; i < count; i++)
+        {
+            for (j = 0u; j < p_slices[i].len; j++)
+            {
+                g_tx_fifo_storage[pos & UART_TX_FIFO_MASK] = p_slices[i].p_data[j];
+                pos++;
+            }
+        }
+    }
+
+    run = UART_TX_FIFO_SIZE_BYTES - offset;
+    if (run > out_len)
+    {
+        run = out_len;
+    }
+
+    /* In a batch, grow the previous copy instead of adding a segment */
+    if (FALSE == uart_fifo_coalesce(desc, offset, run))
+    {
+        g_tx_desc[desc & UART_TX_DESC_MASK].p_data = &g_tx_fifo_storage[offset];
+        g_tx_desc[desc & UART_TX_DESC_MASK].len = run;
+        g_tx_desc[desc & UART_TX_DESC_MASK].fifo_release = run;
+        desc++;
+    }
+
+    if (run < out_len)
+    {
+        g_tx_desc[desc & UART_TX_DESC_MASK].p_data = &g_tx_fifo_storage[0];
+        g_tx_desc[desc & UART_TX_DESC_MASK].len = out_len - run;
+        g_tx_desc[desc & UART_TX_DESC_MASK].fifo_release = out_len - run;
+        desc++;
+    }
+
+    /* Store bytes and descriptors before publishing the new heads */
+    __asm volatile ("" : : : "memory");
+    g_tx_fifo_head = head + out_len;
+    g_tx_desc_head = desc;
+    uart_tx_peak_note();
+
+    /* Critical section: kick the TX engine if it is idle */
+    __disable_irq();
+    uart_tx_kick();
+    __enable_irq();
+
+    return 0;
+}
+
+/*!
+ * @brief Queue data for transmission via UART2 (non-blocking).
+ *
+ * Copies the data into the TX FIFO and returns immediately; the caller's
+ * buffer may be reused as soon as this returns. Messages are queued
+ * whole or not at all, and queued messages are sent back-to-back. In
+ * UART_FRAMING_SLIP the data becomes part of the current frame.
+ *
+ * @param[in] p_data Pointer to data to transmit.
+ * @param[in] len Number of bytes to transmit.
+ *
+ * @return 0 on success, -1 if p_data is NULL, -2 if the queue is full.
+ */
+int32_t
+uart_enqueue (char const * const p_data, uint32_t const len)
+{
+    uart_slice_t slice;
+
+    if (NULL == p_data)
+    {
+        return -1;
+    }
+
+    if (0u == len)
+    {
+        return 0;
+    }
+
+    slice.p_data = p_data;
+    slice.len = len;
+
+    return uart_fifo_enqueue(&slice, 1u,
+                             (UART_FRAMING == UART_FRAMING_SLIP) ? TRUE : FALSE);
+}
+
+/*!
+ * @brief Queue a list of slices by copying them into the TX FIFO.
+ *
+ * The copying counterpart of uart_enqueue_slices(): the slices are
+ * joined into one contiguous run, so they take at most two descriptors
+ * however many there are, and their memory may be reused as soon as this
+ * returns. All slices are queued or none. In UART_FRAMING_SLIP the data
+ * becomes part of the current frame.
+ *
+ * @param[in] p_slices Array of slices (NULL data is only valid with len 0).
+ * @param[in] count Number of slices in the array.
+ *
+ * @return 0 on success, -1 if p_slices or a non-empty slice is NULL, -2
+ *         if the queue is full.
+ */
+int32_t
+uart_enqueue_copy (uart_slice_t const * const p_slices, uint32_t const count)
+{
+    uint32_t i;
+
+    if (NULL == p_slices)
+    {
+        return -1;
+    }
+
+    for (i = 0u; i < count; i++)
+    {
+        if ((NULL == p_slices[i].p_data) && (0u != p_slices[i].len))
+        {
+            return -1;
+        }
+    }
+
+    return uart_fifo_enqueue(p_slices, count,
+                             (UART_FRAMING == UART_FRAMING_SLIP) ? TRUE : FALSE);
+}
+
+#if (UART_FRAMING == UART_FRAMING_SLIP)
+/*!
+ * @brief Count the descriptors a slice needs once SLIP-escaped.
+ *
+ * Every special byte becomes a constant two-byte escape slice, and each
+ * run of plain bytes between them stays one slice of caller memory.
+ */
+static uint32_t
+uart_slip_slice_count (char const * const p_data, uint32_t const len)
+{
+    uint32_t count = 0u;
+    uint32_t run = 0u;
+    uint32_t i;
+
+    for (i = 0u; i < len; i++)
+    {
+        if (slip_is_special((uint8_t)p_data[i]))
+        {
+            count += (0u != run) ? 2u : 1u;
+            run = 0u;
+        }
+        else
+        {
+            run++;
+        }
+    }
+
+    return count + ((0u != run) ? 1u : 0u);
+}
+
+/*!
+ * @brief Queue one slice SLIP-escaped, without copying.
+ *
+ * @return Next free descriptor index.
+ */
+static uint32_t
+uart_slip_slice_queue (char const * const p_data, uint32_t const len,
+                       uint32_t desc)
+{
+    uint32_t start = 0u;
+    uint32_t i;
+
+    for (i = 0u; i < len; i++)
+    {
+        uint8_t const byte = (uint8_t)p_data[i];
+
+        g_tx_frame_crc = slip_crc_update(g_tx_frame_crc, byte);
+
+        if (slip_is_special(byte))
+        {
+            if (i != start)
+            {
+                g_tx_desc[desc & UART_TX_DESC_MASK].p_data = &p_data[start];
+                g_tx_desc[desc & UART_TX_DESC_MASK].len = i - start;
+                g_tx_desc[desc & UART_TX_DESC_MASK].fifo_release = 0u;
+                desc++;
+            }
+
+            g_tx_desc[desc & UART_TX_DESC_MASK].p_data =
+                (SLIP_END == byte) ? g_slip_esc_end : g_slip_esc_esc;
+            g_tx_desc[desc & UART_TX_DESC_MASK].len = 2u;
+            g_tx_desc[desc & UART_TX_DESC_MASK].fifo_release = 0u;
+            desc++;
+            start = i + 1u;
+        }
+    }
+
+    if (len != start)
+    {
+        g_tx_desc[desc & UART_TX_DESC_MASK].p_data = &p_data[start];
+        g_tx_desc[desc & UART_TX_DESC_MASK].len = len - start;
+        g_tx_desc[desc & UART_TX_DESC_MASK].fifo_release = 0u;
+        desc++;
+    }
+
+    return desc;
+}
+#endif
+
+/*!
+ * @brief Queue a list of slices for transmission without copying.
+ *
+ * The slices are sent back-to-back, in order, straight from the memory
+ * they point at (DMA can read flash and RAM alike). That memory must stay
+ * unchanged until the slices retire - take a uart_tx_mark() after
+ * queueing and poll uart_tx_done() before reusing it. All slices are
+ * queued or none; zero-length slices are skipped.
+ *
+ * In UART_FRAMING_SLIP the slices join the current frame. Escaping stays
+ * zero-copy: a slice is split around each END/ESC byte, which goes out
+ * as a constant escape pair, so one slice may take several descriptors.
+ *
+ * @param[in] p_slices Array of slices.
+ * @param[in] count Number of slices in the array.
+ *
+ * @return 0 on success, -1 if p_slices is NULL (or, framed, if the
+ *         escaped slices could never fit the ring), -2 if the queue is
+ *         full.
+ */
+int32_t
+uart_enqueue_slices (uart_slice_t const * const p_slices, uint32_t const count)
+{
+    uint32_t desc = g_tx_desc_head;
+    uint32_t needed = count;
+    uint32_t i;
+
+    if (NULL == p_slices)
+    {
+        return -1;
+    }
+
+#if (UART_FRAMING == UART_FRAMING_SLIP)
+    needed = g_b_tx_frame_open ? 0u : 1u;
+
+    for (i = 0u; i < count; i++)
+    {
+        if (NULL != p_slices[i].p_data)
+        {
+            needed += uart_slip_slice_count(p_slices[i].p_data,
+                                            p_slices[i].len);
+        }
+    }
+
+    if (needed > UART_TX_DESC_COUNT)
+    {
+        return -1;
+    }
+#endif
+
+    if (needed > (UART_TX_DESC_COUNT - (desc - g_tx_desc_tail)))
+    {
+        return -2;
+    }
+
+    for (i = 0u; i < count; i++)
+    {
+        if ((NULL != p_slices[i].p_data) && (0u != p_slices[i].len))
+        {
+#if (UART_FRAMING == UART_FRAMING_SLIP)
+            if (FALSE == g_b_tx_frame_open)
+            {
+                g_tx_desc[desc & UART_TX_DESC_MASK].p_data = g_slip_end;
+                g_tx_desc[desc & UART_TX_DESC_MASK].len = 1u;
+                g_tx_desc[desc & UART_TX_DESC_MASK].fifo_release = 0u;
+                desc++;
+                g_tx_frame_crc = SLIP_CRC_INIT;
+                g_b_tx_frame_open = TRUE;
+            }
+
+            desc = uart_slip_slice_queue(p_slices[i].p_data, p_slices[i].len,
+                                         desc);
+#else
+            g_tx_desc[desc & UART_TX_DESC_MASK].p_data = p_slices[i].p_data;
+            g_tx_desc[desc & UART_TX_DESC_MASK].len = p_slices[i].len;
+            g_tx_desc[desc & UART_TX_DESC_MASK].fifo_release = 0u;
+            desc++;
+#endif
+        }
+    }
+
+    if (desc == g_tx_desc_head)
+    {
+        return 0;
+    }
+
+    /* Store descriptors before publishing the new head */
+    __asm volatile ("" : : : "memory");
+    g_tx_desc_head = desc;
+    uart_tx_peak_note();
+
+    /* Critical section: kick the TX engine if it is idle */
+    __disable_irq();
+    uart_tx_kick();
+    __enable_irq();
+
+    return 0;
+}
+
+/*!
+ * @brief Close the current SLIP frame: CRC and END.
+ *
+ * Everything queued since the last call forms one frame. The trailer is
+ * computed here, so it goes through the FIFO rather than as slices. Does
+ * nothing when no frame is open, or without UART_FRAMING_SLIP.
+ *
+ * @return 0 on success (or nothing to close), -2 if the queue is full
+ *         (retry later).
+ */
+int32_t
+uart_frame_end (void)
+{
+#if (UART_FRAMING == UART_FRAMING_SLIP)
+    char trailer[(2u * SLIP_CRC_SIZE) + 1u];
+    uart_slice_t slice;
+    uint32_t len = 0u;
+    uint32_t i;
+    int32_t result;
+
+    if (FALSE == g_b_tx_frame_open)
+    {
+        return 0;
+    }
+
+    for (i = 0u; i < SLIP_CRC_SIZE; i++)
+    {
+        uint8_t const byte = (uint8_t)(g_tx_frame_crc >> (8u * (1u - i)));
+
+        if (slip_is_special(byte))
+        {
+            trailer[len] = (char)SLIP_ESC;
+            len++;
+            trailer[len] = (char)slip_escape_code(byte);
+        }
+        else
+        {
+            trailer[len] = (char)byte;
+        }
+        len++;
+    }
+
+    trailer[len] = (char)SLIP_END;
+    len++;
+
+    slice.p_data = trailer;
+    slice.len = len;
+    result = uart_fifo_enqueue(&slice, 1u, FALSE);
+
+    if (0 == result)
+    {
+        g_b_tx_frame_open = FALSE;
+    }
+
+    return result;
+#else
+    return 0;
+#endif
+}
+
+/*!
+ * @brief Get free space in the TX queue.
+ *
+ * @return Number of bytes uart_enqueue() can currently accept.
+ */
+uint32_t
+uart_tx_free (void)
+{
+    uint32_t bytes = UART_TX_FIFO_SIZE_BYTES - (g_tx_fifo_head - g_tx_fifo_tail);
+
+    /* A copy may need two descriptors; without them nothing fits */
+    return (2u > uart_tx_slots_free()) ? 0u : bytes;
+}
+
+/*!
+ * @brief Get free descriptor slots in the TX queue.
+ *
+ * @return Number of slices uart_enqueue_slices() can currently accept.
+ */
+uint32_t
+uart_tx_slots_free (void)
+{
+    return (UART_TX_DESC_COUNT - (g_tx_desc_head - g_tx_desc_tail));
+}
+
+/*!
+ * @brief Take a completion mark covering everything queued so far.
+ *
+ * @return Mark to pass to uart_tx_done().
+ */
+uint32_t
+uart_tx_mark (void)
+{
+    return g_tx_desc_head;
+}
+
+/*!
+ * @brief Check whether everything queued before a mark has been sent.
+ *
+ * Once this returns TRUE the TX engine no longer reads any slice queued
+ * before the mark, so its memory may be reused.
+ *
+ * @param[in] mark Value returned by uart_tx_mark().
+ *
+ * @return TRUE if all slices up to the mark have retired.
+ */
+bool_t
+uart_tx_done (uint32_t const mark)
+{
+    /* Free-running counters: wrap-safe signed distance */
+    return ((int32_t)(g_tx_desc_tail - mark) >= 0) ? TRUE : FALSE;
+}
+
+/*!
+ * @brief Open a TX batch: hold queued data back until the flush.
+ *
+ * Everything queued until uart_tx_batch_flush() waits in the queue, and
+ * consecutive uart_enqueue()/uart_enqueue_copy() copies merge into the
+ * same descriptor, so the batch leaves as one DMA transfer (or one TXE
+ * run) instead of a segment per call. A transfer already in progress
+ * carries on to the end of what was queued before the batch opened,
+ * then the TX engine stops and waits for the flush. The queue does not
+ * grow: flush before waiting for space.
+ */
+void
+uart_tx_batch_begin (void)
+{
+    if (FALSE == g_b_tx_batch)
+    {
+        /* Boundary first: the TX ISR reads it once it sees the flag */
+        g_tx_batch_first = g_tx_desc_head;
+        g_b_tx_batch = TRUE;
+    }
+}
+
+/*!
+ * @brief Close the TX batch and start sending it (no-op if none is open).
+ */
+void
+uart_tx_batch_flush (void)
+{
+    /* Critical section: kick the TX engine if it is idle */
+    __disable_irq();
+    g_b_tx_batch = FALSE;
+    uart_tx_kick();
+    __enable_irq();
+}
+
+/*!
+ * @brief Enable interrupt-driven UART reception.
+ *
+ * Prepares the receiver state machine and enables RXNE interrupt.
+ * Reception continues until newline or buffer overflow.
+ *
+ * @return 0 on success, -1 if receiver already busy.
+ */
+int32_t
+uart_receive_buffer (void)
+{
+    /* Critical section: check and update RX state atomically */
+    __disable_irq();
+        
+    if (UART_STATE_IDLE != g_rx_state)
+    {
+        __enable_irq();
+        return -1;
+    }
+    
+    g_rx_state = UART_STATE_RX_BUSY;
+    __enable_irq();
+
+#if (UART_RX_MODE == UART_RX_MODE_DMA)
+    /* DMA continues the line at g_rx_index; a full buffer ends it */
+    if (g_rx_index >= (RX_BUFFER_SIZE_BYTES - 1u))
+    {
+        g_rx_state = UART_STATE_IDLE;
+        return 0;
+    }
+
+    uart_rx_dma_start(&g_p_rx_buffer[g_rx_index],
+                      (RX_BUFFER_SIZE_BYTES - 1u) - g_rx_index, FALSE);
+#else
+    /* Enable RXNE interrupt to start reception */
+    *USART_CR1 |= (1u << USART_CR1_RXNEIE_BIT);
+#endif
+    
+    return 0;
+}
+
+#ifdef TRACE_ENABLE
+/*!
+ * @brief Bytes (and SLIP frames) dropped so far, for the handler trace.
+ */
+static inline uint32_t uart_rx_dropped_total(void)
+{
+#if (UART_FRAMING == UART_FRAMING_SLIP)
+    return g_rx_ring_dropped + g_rx_frames_dropped;
+#else
+    return g_rx_ring_dropped;
+#endif
+}
+#endif
+
+/*!
+ * @brief USART2 interrupt service routine.
+ *
+ * Handles both TX and RX interrupts with error detection.
+ * TX: Sends next byte or disables interrupt when complete.
+ * RX: Receives bytes until newline or error, with overflow protection.
+ *
+ * @note In UART_TX_MODE_DMA the TX path is owned by DMA1 channel 1 and
+ *       this handler only services RX. In UART_RX_MODE_DMA it runs once
+ *       per frame (idle line or character match), not once per byte.
+ *       With TRACE_ENABLE it traces each entry and any error or drop.
+ */
+void
+USART2_IRQHandler (void)
+{
+    bool_t b_has_error = FALSE;  /* Changed to bool_t for Keil */
+#ifdef TRACE_ENABLE
+    uart_error_t const error_in = g_error;
+    uint32_t const dropped_in = uart_rx_dropped_total();
+#endif
+    PROFILE_START(isr_start);
+
+    TRACE(TRACE_EV_USART2_IRQ, *USART_ISR);
+
+#if (UART_TX_MODE == UART_TX_MODE_IRQ)
+    /* Handle transmit interrupt - TXE flag set */
+    if (((*USART_ISR & (1u << USART_ISR_TXE_BIT)) != 0u) && 
+        (UART_STATE_TX_BUSY == g_tx_state))
+    {
+        uart_process_tx();
+    }
+#endif
+
+#if (UART_RX_MODE == UART_RX_MODE_DMA)
+    /* Handle frame and error events - DMA has stored the bytes */
+    if (UART_STATE_RX_BUSY == g_rx_state)
+    {
+        uart_process_rx_dma();
+    }
+#else
+    /* Handle receive interrupt - RXNE flag set (and not held) */
+    if (((*USART_ISR & (1u << USART_ISR_RXNE_BIT)) != 0u) && 
+        ((*USART_CR1 & (1u << USART_CR1_RXNEIE_BIT)) != 0u) &&
+        (UART_STATE_RX_BUSY == g_rx_state))
+    {
+        if (g_b_rx_ring_active)
+        {
+#if (UART_FRAMING == UART_FRAMING_SLIP)
+            uart_process_rx_frame();
+#else
+            uart_process_rx_ring();
+#endif
+        }
+        else
+        {
+            g_error = uart_process_rx();
+
+            if (UART_ERROR_NONE != g_error)
+            {
+                g_stat_errors[g_error]++;
+            }
+        }
+    }
+#endif
+
+#ifdef TRACE_ENABLE
+    if (g_error != error_in)
+    {
+        TRACE(TRACE_EV_UART_ERROR, g_error);
+    }
+
+    if (uart_rx_dropped_total() != dropped_in)
+    {
+        TRACE(TRACE_EV_RX_DROP, uart_rx_dropped_total() - dropped_in);
+    }
+#endif
+
+    PROFILE_STOP(PROFILE_USART2_IRQ, isr_start);
+}
+
+/*!
+ * @brief DMA1 channel 1 interrupt service routine (USART2 TX).
+ *
+ * Fires once per buffer on transfer complete (or transfer error). Starts
+ * the next queued segment if there is one, otherwise returns the TX state
+ * machine to IDLE.
+ */
+void
+DMA1_Channel1_IRQHandler (void)
+{
+#if (UART_TX_MODE == UART_TX_MODE_DMA)
+    uint32_t flags = *DMA1_ISR;
+
+    if ((flags & ((1u << DMA_ISR_TCIF1_BIT) | (1u << DMA_ISR_TEIF1_BIT))) != 0u)
+    {
+        *DMA1_IFCR = (1u << DMA_IFCR_CGIF1_BIT);
+        *DMA1_CCR1 &= ~(1u << DMA_CCR_EN_BIT);
+
+        g_tx_index = g_tx_length;
+        uart_tx_load_next();
+
+        if (NULL != g_p_tx_buffer)
+        {
+            /* Chain the next queued segment without going idle */
+            uart_dma_start_tx();
+        }
+        else
+        {
+            g_tx_state = UART_STATE_IDLE;
+            sched_signal(SCHED_TASK_TX);
+        }
+    }
+#endif
+}
+
+/*!
+ * @brief DMA1 channel 2/3 interrupt service routine (USART2 RX).
+ *
+ * In UART_RX_MODE_DMA: the ring publishes new bytes at half and full
+ * transfer, so a burst longer than the ring is never missed; in line
+ * mode transfer complete means the buffer is full. A transfer error
+ * disables the channel and leaves the receiver in UART_STATE_ERROR.
+ */
+void
+DMA1_Channel2_3_IRQHandler (void)
+{
+#if (UART_RX_MODE == UART_RX_MODE_DMA)
+    uint32_t flags = *DMA1_ISR;
+
+    if ((flags & ((1u << DMA_ISR_TCIF2_BIT) | (1u << DMA_ISR_HTIF2_BIT) |
+                  (1u << DMA_ISR_TEIF2_BIT))) != 0u)
+    {
+        *DMA1_IFCR = (1u << DMA_IFCR_CGIF2_BIT);
+
+        if (UART_STATE_RX_BUSY != g_rx_state)
+        {
+            return;
+        }
+
+        if ((flags & (1u << DMA_ISR_TEIF2_BIT)) != 0u)
+        {
+            uart_rx_dma_stop();
+            g_rx_state = UART_STATE_ERROR;
+        }
+        else if (g_b_rx_ring_active)
+        {
+            uart_rx_dma_sync();
+        }
+        else if ((flags & (1u << DMA_ISR_TCIF2_BIT)) != 0u)
+        {
+            uart_rx_dma_line_check(TRUE);
+        }
+        else
+        {
+            /* Half transfer is only enabled for the ring */
+        }
+    }
+#endif
 }
 
 /*!
@@ -406,8 +2084,303 @@ uart_error_reset (void)
         g_rx_state = UART_STATE_RX_BUSY;
         g_error = UART_ERROR_NONE;
         g_rx_index = 0u;
+#if (UART_RX_MODE == UART_RX_MODE_DMA)
+        uart_rx_dma_start(g_p_rx_buffer, RX_BUFFER_SIZE_BYTES - 1u, FALSE);
+#else
         *USART_CR1 |= (1u << USART_CR1_RXNEIE_BIT);
+#endif
+    }
+}
+
+/*!
+ * @brief Start continuous reception into the RX ring buffer.
+ *
+ * Unlike uart_receive_buffer(), reception stays armed across line endings
+ * and errors; received bytes are drained with uart_rx_read(), or whole
+ * frames with uart_rx_read_frame() in UART_FRAMING_SLIP.
+ *
+ * @return 0 on success, -1 if receiver already busy.
+ */
+int32_t
+uart_rx_start (void)
+{
+    /* Critical section: check and update RX state atomically */
+    __disable_irq();
+
+    if (UART_STATE_IDLE != g_rx_state)
+    {
+        __enable_irq();
+        return -1;
+    }
+
+    g_rx_state = UART_STATE_RX_BUSY;
+    g_rx_ring_head = 0u;
+    g_rx_ring_tail = 0u;
+#if (UART_FRAMING == UART_FRAMING_SLIP)
+    slip_rx_reset(&g_rx_slip);
+    g_rx_frame_pos = 0u;
+    g_rx_frame_head = 0u;
+    g_rx_frame_tail = 0u;
+#endif
+    g_b_rx_ring_active = TRUE;
+    g_b_rx_hold_ring = FALSE;
+    __enable_irq();
+
+#if (UART_RX_MODE == UART_RX_MODE_DMA)
+    /* DMA fills the ring round and round; frame events publish it */
+    uart_rx_dma_start(g_rx_ring_storage, UART_RX_RING_SIZE_BYTES, TRUE);
+#else
+    /* Enable RXNE interrupt to start reception */
+    *USART_CR1 |= (1u << USART_CR1_RXNEIE_BIT);
+#endif
+
+#if (UART_FLOW_CONTROL == UART_FLOW_RTS_CTS)
+    /* An application hold outlasts a restart */
+    __disable_irq();
+    uart_rx_flow_apply();
+    __enable_irq();
+#endif
+
+    return 0;
+}
+
+/*!
+ * @brief Stop continuous reception.
+ *
+ * Bytes already in the ring remain readable with uart_rx_read().
+ */
+void
+uart_rx_stop (void)
+{
+    if (g_b_rx_ring_active)
+    {
+#if (UART_RX_MODE == UART_RX_MODE_DMA)
+        /* Publish what DMA stored so far, then stop it */
+        __disable_irq();
+        uart_rx_dma_sync();
+        __enable_irq();
+        uart_rx_dma_stop();
+#else
+        *USART_CR1 &= ~(1u << USART_CR1_RXNEIE_BIT);
+#endif
+        g_b_rx_ring_active = FALSE;
+        g_b_rx_hold_ring = FALSE;
+        g_rx_state = UART_STATE_IDLE;
+    }
+}
+
+
+/*!
+ * @brief Hold or release the sender (UART_FLOW_RTS_CTS only).
+ *
+ * While held, continuous reception stops reading RDR. The byte left
+ * there keeps RTS deasserted, so the peer pauses after its current byte
+ * and nothing is lost. Bytes already in the ring stay readable. A full
+ * ring holds the sender by itself as well; this adds a hold for the
+ * application's own reasons, e.g. output falling behind.
+ *
+ * @param[in] b_hold TRUE to hold, FALSE to release.
+ *
+ * @note Without UART_FLOW_RTS_CTS the sender cannot be told to wait, so
+ *       this does nothing.
+ */
+void
+uart_rx_hold (bool_t const b_hold)
+{
+#if (UART_FLOW_CONTROL == UART_FLOW_RTS_CTS)
+    if (b_hold != g_b_rx_hold_app)
+    {
+        TRACE(TRACE_EV_RX_HOLD, b_hold);
+    }
+
+    __disable_irq();
+    g_b_rx_hold_app = b_hold;
+    uart_rx_flow_apply();
+    __enable_irq();
+#else
+    (void)b_hold;
+#endif
+}
+
+/*!
+ * @brief Get the number of received bytes waiting in the RX ring.
+ *
+ * @return Bytes available to uart_rx_read().
+ */
+uint32_t
+uart_rx_available (void)
+{
+    return (g_rx_ring_head - g_rx_ring_tail);
+}
+
+/*!
+ * @brief Copy received bytes out of the RX ring (main loop only).
+ *
+ * @param[out] p_dst Destination buffer.
+ * @param[in] max_len Maximum number of bytes to copy.
+ *
+ * @return Number of bytes copied (0 if ring empty or p_dst is NULL).
+ */
+uint32_t
+uart_rx_read (char * const p_dst, uint32_t const max_len)
+{
+    uint32_t tail = g_rx_ring_tail;
+    uint32_t count = g_rx_ring_head - tail;
+    uint32_t i;
+
+    if (NULL == p_dst)
+    {
+        return 0u;
+    }
+
+#if (UART_RX_MODE == UART_RX_MODE_DMA)
+    if (count > UART_RX_RING_SIZE_BYTES)
+    {
+        /* DMA lapped the reader: the oldest bytes are gone, skip them */
+        tail += count - UART_RX_RING_SIZE_BYTES;
+        count = UART_RX_RING_SIZE_BYTES;
+    }
+#endif
+
+    if (count > g_stat_rx_peak)
+    {
+        g_stat_rx_peak = count;
+    }
+
+    if (count > max_len)
+    {
+        count = max_len;
+    }
+
+    for (i = 0u; i < count; i++)
+    {
+        p_dst[i] = g_rx_ring_storage[(tail + i) & UART_RX_RING_MASK];
+    }
+
+    g_stat_rx_bytes += count;
+
+    /* Finish reading the slots before handing them back to the ISR */
+    __asm volatile ("" : : : "memory");
+    g_rx_ring_tail = tail + count;
+
+#if (UART_FLOW_CONTROL == UART_FLOW_RTS_CTS)
+    uart_rx_flow_release();
+#endif
+
+    return count;
+}
+
+/*!
+ * @brief Copy the oldest received SLIP frame out of the RX ring.
+ *
+ * Only frames that passed the CRC check are ever returned, payload only.
+ * In UART_FRAMING_SLIP use this instead of uart_rx_read(), which would
+ * split frames. Without UART_FRAMING_SLIP no frames are ever received.
+ *
+ * @param[out] p_dst Destination buffer.
+ * @param[in] max_len Size of the destination buffer.
+ *
+ * @return Payload length, 0 if no frame is waiting, -1 if p_dst is NULL
+ *         or the frame is longer than max_len (the frame is dropped).
+ */
+int32_t
+uart_rx_read_frame (char * const p_dst, uint32_t const max_len)
+{
+#if (UART_FRAMING == UART_FRAMING_SLIP)
+    uint32_t tail = g_rx_ring_tail;
+    uint32_t const queued = g_rx_frame_tail;
+    uint32_t end;
+    uint32_t len;
+    uint32_t i;
+    int32_t result;
+
+    if (queued == g_rx_frame_head)
+    {
+        return 0;
+    }
+
+    end = g_rx_frame_end[queued & UART_RX_FRAME_MASK];
+    len = end - tail;
+
+    if ((g_rx_frame_pos - tail) > g_stat_rx_peak)
+    {
+        g_stat_rx_peak = g_rx_frame_pos - tail;
+    }
+
+    if ((NULL == p_dst) || (len > max_len))
+    {
+        result = -1;
+    }
+    else
+    {
+        for (i = 0u; i < len; i++)
+        {
+            p_dst[i] = g_rx_ring_storage[(tail + i) & UART_RX_RING_MASK];
+        }
+        result = (int32_t)len;
+        g_stat_rx_bytes += len;
+        g_stat_rx_frames++;
+    }
+
+    /* Finish reading the slots before handing them back to the ISR */
+    __asm volatile ("" : : : "memory");
+    g_rx_ring_tail = end;
+    g_rx_frame_tail = queued + 1u;
+
+#if (UART_FLOW_CONTROL == UART_FLOW_RTS_CTS)
+    uart_rx_flow_release();
+#endif
+
+    return result;
+#else
+    (void)p_dst;
+    (void)max_len;
+
+    return 0;
+#endif
+}
+
+/*!
+ * @brief Take a copy of the USART2 counters.
+ *
+ * Each counter is read once, unlocked: one that an interrupt updates
+ * while the copy is taken is only a count behind, never torn.
+ *
+ * @param[out] p_stats Filled with the counters since start-up.
+ */
+void
+uart_get_stats (uart_stats_t * const p_stats)
+{
+    uint32_t i;
+
+    if (NULL == p_stats)
+    {
+        return;
+    }
+
+    p_stats->tx_bytes = g_stat_tx_bytes;
+    p_stats->rx_bytes = g_stat_rx_bytes;
+    p_stats->rx_frames = g_stat_rx_frames;
+    p_stats->rx_dropped = g_rx_ring_dropped;
+#if (UART_FRAMING == UART_FRAMING_SLIP)
+    p_stats->rx_frames_dropped = g_rx_frames_dropped;
+#else
+    p_stats->rx_frames_dropped = 0u;
+#endif
+
+    for (i = 0u; i < UART_ERROR_COUNT; i++)
+    {
+        p_stats->errors[i] = g_stat_errors[i];
     }
+
+    p_stats->rx_peak = g_stat_rx_peak;
+    p_stats->tx_peak = g_stat_tx_peak;
+    p_stats->tx_desc_peak = g_stat_tx_desc_peak;
+#ifdef PROFILE_ENABLE
+    p_stats->isr_max_cycles = profile_max(PROFILE_USART2_IRQ);
+#else
+    p_stats->isr_max_cycles = 0u;
+#endif
 }
 
 #ifdef __cplusplus
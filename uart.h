@@ -15,6 +15,36 @@
 /* Buffer size for UART reception */
 #define RX_BUFFER_SIZE_BYTES   100u
 
+/* Continuous RX ring buffer size (must be a power of two) */
+#define UART_RX_RING_SIZE_BYTES  256u
+
+#if ((UART_RX_RING_SIZE_BYTES & (UART_RX_RING_SIZE_BYTES - 1u)) != 0u)
+#error "UART_RX_RING_SIZE_BYTES must be a power of two"
+#endif
+
+/* TX queue (byte FIFO) size (must be a power of two) */
+#define UART_TX_FIFO_SIZE_BYTES  512u
+
+#if ((UART_TX_FIFO_SIZE_BYTES & (UART_TX_FIFO_SIZE_BYTES - 1u)) != 0u)
+#error "UART_TX_FIFO_SIZE_BYTES must be a power of two"
+#endif
+
+/* TX descriptor ring size (slices queued at once, must be a power of two) */
+#define UART_TX_DESC_COUNT       32u
+
+#if ((UART_TX_DESC_COUNT & (UART_TX_DESC_COUNT - 1u)) != 0u)
+#error "UART_TX_DESC_COUNT must be a power of two"
+#endif
+
+/* Line rate set by uart_init() (override with -DUART_BAUD_RATE=...);
+ * uart_set_baud() changes it at run time */
+#ifndef UART_BAUD_RATE
+#define UART_BAUD_RATE         9600u
+#endif
+
+/* Largest divisor rounding error accepted for a baud rate, in percent */
+#define UART_BAUD_TOLERANCE_PCT  2u
+
 /* UART configuration modes */
 #define UART_MODE_NORMAL       0u
 #define UART_MODE_ECHO         1u
@@ -22,6 +52,71 @@
 /* Select active UART mode */
 #define UART_CONFIG            UART_MODE_NORMAL
 
+/* UART transmit engine: per-byte TXE interrupt or one DMA transfer per buffer */
+#define UART_TX_MODE_IRQ       0u
+#define UART_TX_MODE_DMA       1u
+
+/* Select active transmit engine (override with -DUART_TX_MODE=...) */
+#ifndef UART_TX_MODE
+#define UART_TX_MODE           UART_TX_MODE_DMA
+#endif
+
+/* UART receive engine: RXNE interrupt per byte, or DMA into the buffer
+ * with one interrupt per frame (idle line or character match) */
+#define UART_RX_MODE_IRQ       0u
+#define UART_RX_MODE_DMA       1u
+
+/* Select active receive engine (override with -DUART_RX_MODE=...) */
+#ifndef UART_RX_MODE
+#define UART_RX_MODE           UART_RX_MODE_IRQ
+#endif
+
+/* Byte that ends a frame in UART_RX_MODE_DMA (USART character match) */
+#ifndef UART_RX_MATCH_CHAR
+#define UART_RX_MATCH_CHAR     '\n'
+#endif
+
+/* Message framing on the wire: none (JSON structure only) or SLIP frames
+ * with a CRC-16 trailer (see slip.h) */
+#define UART_FRAMING_NONE      0u
+#define UART_FRAMING_SLIP      1u
+
+/* Select framing (override with -DUART_FRAMING=...) */
+#ifndef UART_FRAMING
+#define UART_FRAMING           UART_FRAMING_NONE
+#endif
+
+#if ((UART_FRAMING == UART_FRAMING_SLIP) && (UART_RX_MODE == UART_RX_MODE_DMA))
+#error "UART_FRAMING_SLIP decodes in the RX interrupt: use UART_RX_MODE_IRQ"
+#endif
+
+/* Flow control: none, or hardware RTS (PA1) / CTS (PA0) on AF1. With
+ * RTS/CTS a full RX ring, or uart_rx_hold(), stops reading RDR; the byte
+ * left there keeps RTS deasserted, so the sender pauses instead of
+ * overrunning. CTS makes the transmitter wait for the peer the same way */
+#define UART_FLOW_NONE         0u
+#define UART_FLOW_RTS_CTS      1u
+
+/* Select flow control (override with -DUART_FLOW_CONTROL=...) */
+#ifndef UART_FLOW_CONTROL
+#define UART_FLOW_CONTROL      UART_FLOW_NONE
+#endif
+
+/* Free RX ring bytes needed before a full ring lets the sender go again
+ * (UART_FLOW_RTS_CTS); DMA reception needs half a ring between updates */
+#if (UART_RX_MODE == UART_RX_MODE_DMA)
+#define UART_RX_RESUME_FREE    (UART_RX_RING_SIZE_BYTES / 2u)
+#else
+#define UART_RX_RESUME_FREE    (UART_RX_RING_SIZE_BYTES / 4u)
+#endif
+
+/* Received frames waiting at once in UART_FRAMING_SLIP (power of two) */
+#define UART_RX_FRAME_QUEUE      8u
+
+#if ((UART_RX_FRAME_QUEUE & (UART_RX_FRAME_QUEUE - 1u)) != 0u)
+#error "UART_RX_FRAME_QUEUE must be a power of two"
+#endif
+
 /* UART state machine states */
 typedef enum
 {
@@ -38,14 +133,70 @@ typedef enum
     UART_ERROR_OVERRUN,
     UART_ERROR_FRAMING,
     UART_ERROR_PARITY,
-    UART_ERROR_NOISE
+    UART_ERROR_NOISE,
+    UART_ERROR_COUNT
 } uart_error_t;
 
+/* USART2 counters since start-up (uart_get_stats()), all free-running */
+typedef struct
+{
+    uint32_t tx_bytes;                  /* Sent by the TX engine (after escaping) */
+    uint32_t rx_bytes;                  /* Read by the application (payload) */
+    uint32_t rx_frames;                 /* SLIP frames read */
+    uint32_t rx_dropped;                /* Bytes lost to a full RX ring */
+    uint32_t rx_frames_dropped;         /* Good SLIP frames with no room */
+    uint32_t errors[UART_ERROR_COUNT];  /* Hardware errors, by code */
+    uint32_t rx_peak;                   /* Highest RX ring fill seen by a read */
+    uint32_t tx_peak;                   /* Highest TX FIFO fill */
+    uint32_t tx_desc_peak;              /* Most TX descriptors in use */
+    uint32_t isr_max_cycles;            /* Longest USART2_IRQHandler (PROFILE_ENABLE) */
+} uart_stats_t;
+
+/* One scatter-gather TX slice - refers to caller memory, never copied */
+typedef struct
+{
+    char const * p_data;
+    uint32_t len;
+} uart_slice_t;
+
 /* Public API functions */
 int32_t uart_init(void);
 int32_t uart_transmit_buffer(char const * const p_str);
 int32_t uart_receive_buffer(void);
 void uart_error_reset(void);
+int32_t uart_set_baud(uint32_t const baud);
+uint32_t uart_get_baud(void);
+
+/* Queued transmission API */
+int32_t uart_enqueue(char const * const p_data, uint32_t const len);
+uint32_t uart_tx_free(void);
+
+/* Scatter-gather (zero-copy) transmission API */
+int32_t uart_enqueue_slices(uart_slice_t const * const p_slices,
+                            uint32_t const count);
+uint32_t uart_tx_slots_free(void);
+uint32_t uart_tx_mark(void);
+bool_t uart_tx_done(uint32_t const mark);
+
+/* Batched transmission API */
+int32_t uart_enqueue_copy(uart_slice_t const * const p_slices,
+                          uint32_t const count);
+void uart_tx_batch_begin(void);
+void uart_tx_batch_flush(void);
+
+/* Continuous (ring buffer) reception API */
+int32_t uart_rx_start(void);
+void uart_rx_stop(void);
+uint32_t uart_rx_available(void);
+uint32_t uart_rx_read(char * const p_dst, uint32_t const max_len);
+void uart_rx_hold(bool_t const b_hold);
+
+/* Statistics */
+void uart_get_stats(uart_stats_t * const p_stats);
+
+/* Framed (UART_FRAMING_SLIP) API */
+int32_t uart_frame_end(void);
+int32_t uart_rx_read_frame(char * const p_dst, uint32_t const max_len);
 
 #endif /* UART_H */
 
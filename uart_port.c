@@ -0,0 +1,693 @@
+/** @file uart_port.c
+ *
+ * @brief Handle-based serial port driver implementation (RM0444 USART).
+ *
+ * Every port is one static uart_port_t: a pointer to its register block,
+ * a constant description of its clocks, pins and vector, and two SPSC
+ * rings. The interrupt handler is shared by all ports and only touches
+ * the port it is given, so USART3, USART4 and LPUART1, which share one
+ * vector, are served by calling it for each of them in turn.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include "uart_port.h"
+#include "clock.h"
+#include "sched.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* USART / LPUART register block (same layout for both) */
+typedef struct
+{
+    volatile uint32_t CR1;     /* 0x00 */
+    volatile uint32_t CR2;     /* 0x04 */
+    volatile uint32_t CR3;     /* 0x08 */
+    volatile uint32_t BRR;     /* 0x0C */
+    volatile uint32_t GTPR;    /* 0x10 */
+    volatile uint32_t RTOR;    /* 0x14 */
+    volatile uint32_t RQR;     /* 0x18 */
+    volatile uint32_t ISR;     /* 0x1C */
+    volatile uint32_t ICR;     /* 0x20 */
+    volatile uint32_t RDR;     /* 0x24 */
+    volatile uint32_t TDR;     /* 0x28 */
+    volatile uint32_t PRESC;   /* 0x2C */
+} uart_port_regs_t;
+
+/* GPIO register block (up to AFRH) */
+typedef struct
+{
+    volatile uint32_t MODER;   /* 0x00 */
+    volatile uint32_t OTYPER;  /* 0x04 */
+    volatile uint32_t OSPEEDR; /* 0x08 */
+    volatile uint32_t PUPDR;   /* 0x0C */
+    volatile uint32_t IDR;     /* 0x10 */
+    volatile uint32_t ODR;     /* 0x14 */
+    volatile uint32_t BSRR;    /* 0x18 */
+    volatile uint32_t LCKR;    /* 0x1C */
+    volatile uint32_t AFR[2];  /* 0x20 AFRL, 0x24 AFRH */
+} uart_port_gpio_t;
+
+/* Peripheral base addresses */
+#define USART1_BASE                0x40013800u
+#define USART3_BASE                0x40004800u
+#define USART4_BASE                0x40004C00u
+#define LPUART1_BASE               0x40008000u
+#define GPIOA_BASE                 0x50000000u
+#define GPIOB_BASE                 0x50000400u
+#define GPIOC_BASE                 0x50000800u
+
+/* RCC registers */
+#define RCC_IOPENR                 ((volatile uint32_t *)0x40021034)
+#define RCC_APBENR1                ((volatile uint32_t *)0x4002103C)
+#define RCC_APBENR2                ((volatile uint32_t *)0x40021040)
+
+/* RCC enable bits */
+#define RCC_APBENR2_USART1_BIT     14u
+#define RCC_APBENR1_USART3_BIT     18u
+#define RCC_APBENR1_USART4_BIT     19u
+#define RCC_APBENR1_LPUART1_BIT    20u
+#define RCC_IOPENR_GPIOA_BIT       0u
+#define RCC_IOPENR_GPIOB_BIT       1u
+#define RCC_IOPENR_GPIOC_BIT       2u
+
+/* NVIC */
+#define NVIC_ISER0                 ((volatile uint32_t *)0xE000E100)
+#define USART1_IRQn                27u
+#define USART3_4_LPUART1_IRQn      29u
+
+/* USART bits */
+#define USART_CR1_UE_BIT           0u
+#define USART_CR1_RE_BIT           2u
+#define USART_CR1_TE_BIT           3u
+#define USART_CR1_RXNEIE_BIT       5u
+#define USART_CR1_TXEIE_BIT        7u
+#define USART_ISR_PE_BIT           0u
+#define USART_ISR_FE_BIT           1u
+#define USART_ISR_NF_BIT           2u
+#define USART_ISR_ORE_BIT          3u
+#define USART_ISR_RXNE_BIT         5u
+#define USART_ISR_TXE_BIT          7u
+
+#define UART_PORT_ERROR_FLAGS      ((1u << USART_ISR_PE_BIT) | (1u << USART_ISR_FE_BIT) | \
+                                    (1u << USART_ISR_NF_BIT) | (1u << USART_ISR_ORE_BIT))
+
+/* GPIO configuration */
+#define GPIO_MODER_AF_MODE         0x2u
+#define BITS_PER_PIN               2u
+#define AFR_BITS_PER_PIN           4u
+#define AFR_PINS_PER_REG           8u
+
+/* USART divisor range (16x oversampling) */
+#define UART_PORT_BRR_MIN          16u
+#define UART_PORT_BRR_MAX          0xFFFFu
+
+/* LPUART divisor range: BRR = 256 * fck / baud */
+#define UART_PORT_LPBRR_MIN        0x300u
+#define UART_PORT_LPBRR_MAX        0xFFFFFu
+#define UART_PORT_LPPRESC_COUNT    12u
+
+#define UART_PORT_TX_MASK          (UART_PORT_TX_SIZE_BYTES - 1u)
+#define UART_PORT_RX_MASK          (UART_PORT_RX_SIZE_BYTES - 1u)
+
+/* What differs between the ports: where they are and how they are wired */
+typedef struct
+{
+    uintptr_t regs_base;
+    uintptr_t gpio_base;
+    volatile uint32_t * p_rcc_enr;
+    uint8_t rcc_bit;
+    uint8_t iopen_bit;
+    uint8_t tx_pin;
+    uint8_t rx_pin;
+    uint8_t af;
+    uint8_t irqn;
+    bool_t b_lpuart;
+} uart_port_hw_t;
+
+struct uart_port
+{
+    uart_port_hw_t const * p_hw;
+    volatile uint32_t tx_head;          /* Written by the caller */
+    volatile uint32_t tx_tail;          /* Written by the ISR */
+    volatile uint32_t rx_head;          /* Written by the ISR */
+    volatile uint32_t rx_tail;          /* Written by the caller */
+    volatile uint32_t rx_dropped;       /* Bytes lost to a full RX ring */
+    volatile uart_error_t error;
+    uint32_t baud;                      /* 0 while closed */
+    char tx_storage[UART_PORT_TX_SIZE_BYTES];
+    char rx_storage[UART_PORT_RX_SIZE_BYTES];
+};
+
+static uart_port_hw_t const g_uart_port_hw[UART_PORT_COUNT] =
+{
+    /* USART1: PA9 / PA10 */
+    [UART_PORT_USART1] = {
+        .regs_base = USART1_BASE, .gpio_base = GPIOA_BASE,
+        .p_rcc_enr = RCC_APBENR2, .rcc_bit = RCC_APBENR2_USART1_BIT,
+        .iopen_bit = RCC_IOPENR_GPIOA_BIT, .tx_pin = 9u, .rx_pin = 10u,
+        .af = 1u, .irqn = USART1_IRQn, .b_lpuart = FALSE },
+    /* USART3: PB8 / PB9 */
+    [UART_PORT_USART3] = {
+        .regs_base = USART3_BASE, .gpio_base = GPIOB_BASE,
+        .p_rcc_enr = RCC_APBENR1, .rcc_bit = RCC_APBENR1_USART3_BIT,
+        .iopen_bit = RCC_IOPENR_GPIOB_BIT, .tx_pin = 8u, .rx_pin = 9u,
+        .af = 4u, .irqn = USART3_4_LPUART1_IRQn, .b_lpuart = FALSE },
+    /* USART4: PC10 / PC11 */
+    [UART_PORT_USART4] = {
+        .regs_base = USART4_BASE, .gpio_base = GPIOC_BASE,
+        .p_rcc_enr = RCC_APBENR1, .rcc_bit = RCC_APBENR1_USART4_BIT,
+        .iopen_bit = RCC_IOPENR_GPIOC_BIT, .tx_pin = 10u, .rx_pin = 11u,
+        .af = 1u, .irqn = USART3_4_LPUART1_IRQn, .b_lpuart = FALSE },
+    /* LPUART1: PC1 / PC0 */
+    [UART_PORT_LPUART1] = {
+        .regs_base = LPUART1_BASE, .gpio_base = GPIOC_BASE,
+        .p_rcc_enr = RCC_APBENR1, .rcc_bit = RCC_APBENR1_LPUART1_BIT,
+        .iopen_bit = RCC_IOPENR_GPIOC_BIT, .tx_pin = 1u, .rx_pin = 0u,
+        .af = 1u, .irqn = USART3_4_LPUART1_IRQn, .b_lpuart = TRUE }
+};
+
+static uart_port_t g_uart_port[UART_PORT_COUNT] =
+{
+    [UART_PORT_USART1] = { .p_hw = &g_uart_port_hw[UART_PORT_USART1] },
+    [UART_PORT_USART3] = { .p_hw = &g_uart_port_hw[UART_PORT_USART3] },
+    [UART_PORT_USART4] = { .p_hw = &g_uart_port_hw[UART_PORT_USART4] },
+    [UART_PORT_LPUART1] = { .p_hw = &g_uart_port_hw[UART_PORT_LPUART1] }
+};
+
+/* LPUART_PRESC dividers, by register value */
+static uint16_t const g_uart_port_lppresc[UART_PORT_LPPRESC_COUNT] =
+{
+    1u, 2u, 4u, 6u, 8u, 10u, 12u, 16u, 32u, 64u, 128u, 256u
+};
+
+/* Inline functions for interrupt control */
+static inline void __enable_irq(void) {
+    __asm volatile ("cpsie i" : : : "memory");
+}
+
+static inline void __disable_irq(void) {
+    __asm volatile ("cpsid i" : : : "memory");
+}
+
+/* Inline Function for enabling IRQ */
+static inline void NVIC_EnableIRQ(uint32_t IRQn) {
+    NVIC_ISER0[IRQn >> 5] = (1u << (IRQn & 0x1F));
+}
+
+
+/*!
+ * @brief Register block of a port.
+ */
+static inline uart_port_regs_t *
+uart_port_regs (uart_port_t const * const p_port)
+{
+    return (uart_port_regs_t *)p_port->p_hw->regs_base;
+}
+
+
+/*!
+ * @brief Compute BRR (and LPUART_PRESC) for a baud rate.
+ *
+ * USARTs use 16x oversampling, BRR = fck / baud, and must round to
+ * within UART_BAUD_TOLERANCE_PCT. The LPUART divides by 256 * fck / baud
+ * which is always close enough, but needs the prescaler to keep BRR in
+ * its 20 bits at low rates; the smallest prescaler that fits is used.
+ *
+ * @return 0 on success, -1 if the rate cannot be made from the current
+ *         clock.
+ */
+static int32_t
+uart_port_divisor (uart_port_hw_t const * const p_hw, uint32_t const baud,
+                   uint32_t * const p_brr, uint32_t * const p_presc)
+{
+    uint32_t const pclk = clock_get_hz();
+    uint32_t presc;
+
+    if (0u == baud)
+    {
+        return -1;
+    }
+
+    if (FALSE == p_hw->b_lpuart)
+    {
+        uint32_t const div = (pclk + (baud / 2u)) / baud;
+        uint32_t const actual = (0u != div) ? (pclk / div) : 0u;
+        uint32_t const error = (actual > baud) ? (actual - baud) : (baud - actual);
+
+        if ((div < UART_PORT_BRR_MIN) || (div > UART_PORT_BRR_MAX) ||
+            ((error * 100u) > (baud * UART_BAUD_TOLERANCE_PCT)))
+        {
+            return -1;
+        }
+
+        *p_brr = div;
+        *p_presc = 0u;
+        return 0;
+    }
+
+    for (presc = 0u; presc < UART_PORT_LPPRESC_COUNT; presc++)
+    {
+        uint32_t const fck = pclk / g_uart_port_lppresc[presc];
+        uint32_t const whole = fck / baud;
+        uint32_t rem = fck % baud;
+        uint32_t brr;
+
+        if (whole > (UART_PORT_LPBRR_MAX >> 8))
+        {
+            continue;
+        }
+
+        /* 256 * fck / baud in two 4-bit steps, to stay within 32 bits */
+        brr = whole << 8;
+        brr |= ((rem << 4) / baud) << 4;
+        rem = (rem << 4) % baud;
+        brr += ((rem << 4) + (baud / 2u)) / baud;
+
+        if (brr > UART_PORT_LPBRR_MAX)
+        {
+            continue;
+        }
+
+        if (brr < UART_PORT_LPBRR_MIN)
+        {
+            return -1;
+        }
+
+        *p_brr = brr;
+        *p_presc = presc;
+        return 0;
+    }
+
+    return -1;
+}
+
+
+/*!
+ * @brief Route one pin to its alternate function.
+ */
+static void
+uart_port_pin_af (uart_port_gpio_t * const p_gpio, uint32_t const pin,
+                  uint32_t const af)
+{
+    uint32_t const afr_shift = AFR_BITS_PER_PIN * (pin % AFR_PINS_PER_REG);
+
+    p_gpio->AFR[pin / AFR_PINS_PER_REG] =
+        (p_gpio->AFR[pin / AFR_PINS_PER_REG] & ~(0xFu << afr_shift)) |
+        (af << afr_shift);
+    p_gpio->MODER = (p_gpio->MODER & ~(0x3u << (BITS_PER_PIN * pin))) |
+                    (GPIO_MODER_AF_MODE << (BITS_PER_PIN * pin));
+}
+
+
+/*!
+ * @brief Get the handle of a serial port.
+ *
+ * @return The port, or NULL if id is out of range.
+ */
+uart_port_t *
+uart_port_get (uart_port_id_t const id)
+{
+    if ((uint32_t)id >= (uint32_t)UART_PORT_COUNT)
+    {
+        return NULL;
+    }
+
+    return &g_uart_port[id];
+}
+
+
+/*!
+ * @brief Configure and start a port: clocks, pins, baud rate, 8N1.
+ *
+ * Reception starts at once into the port's RX ring. Opening a port that
+ * is already open re-applies the baud rate; anything still queued in
+ * either ring is discarded. Call again after clock_set_sysclk() to keep
+ * the rate.
+ *
+ * @param[in] p_port Port from uart_port_get().
+ * @param[in] baud   Rate in bit/s.
+ *
+ * @return 0 on success, -1 if p_port is NULL or the rate cannot be made
+ *         from the current clock.
+ */
+int32_t
+uart_port_open (uart_port_t * const p_port, uint32_t const baud)
+{
+    uart_port_hw_t const * p_hw;
+    uart_port_regs_t * p_regs;
+    uint32_t brr = 0u;
+    uint32_t presc = 0u;
+
+    if (NULL == p_port)
+    {
+        return -1;
+    }
+
+    p_hw = p_port->p_hw;
+
+    if (0 != uart_port_divisor(p_hw, baud, &brr, &presc))
+    {
+        return -1;
+    }
+
+    p_regs = uart_port_regs(p_port);
+
+    /* Enable peripheral clocks */
+    *p_hw->p_rcc_enr |= (1u << p_hw->rcc_bit);
+    *RCC_IOPENR |= (1u << p_hw->iopen_bit);
+
+    /* Stop the port (BRR can only be written while it is disabled) */
+    p_regs->CR1 = 0u;
+    p_port->tx_head = 0u;
+    p_port->tx_tail = 0u;
+    p_port->rx_head = 0u;
+    p_port->rx_tail = 0u;
+    p_port->rx_dropped = 0u;
+    p_port->error = UART_ERROR_NONE;
+
+    uart_port_pin_af((uart_port_gpio_t *)p_hw->gpio_base, p_hw->tx_pin, p_hw->af);
+    uart_port_pin_af((uart_port_gpio_t *)p_hw->gpio_base, p_hw->rx_pin, p_hw->af);
+
+    p_regs->PRESC = presc;
+    p_regs->BRR = brr;
+    p_regs->ICR = UART_PORT_ERROR_FLAGS;
+    p_port->baud = baud;
+
+    NVIC_EnableIRQ(p_hw->irqn);
+
+    /* Enable port, transmitter, receiver and the RX interrupt */
+    p_regs->CR1 = (1u << USART_CR1_UE_BIT) |
+                  (1u << USART_CR1_TE_BIT) |
+                  (1u << USART_CR1_RE_BIT) |
+                  (1u << USART_CR1_RXNEIE_BIT);
+
+    return 0;
+}
+
+
+/*!
+ * @brief Stop a port; bytes still queued for TX are discarded.
+ *
+ * Received bytes already in the ring remain readable. The shared vector
+ * stays enabled for the ports that remain open.
+ */
+void
+uart_port_close (uart_port_t * const p_port)
+{
+    if (NULL != p_port)
+    {
+        uart_port_regs(p_port)->CR1 = 0u;
+        p_port->tx_tail = p_port->tx_head;
+        p_port->baud = 0u;
+    }
+}
+
+
+/*!
+ * @brief Get the baud rate of a port.
+ *
+ * @return Rate in bit/s, 0 if p_port is NULL or the port is closed.
+ */
+uint32_t
+uart_port_get_baud (uart_port_t const * const p_port)
+{
+    return (NULL != p_port) ? p_port->baud : 0u;
+}
+
+
+/*!
+ * @brief Queue bytes for transmission (copied into the port's TX ring).
+ *
+ * All or nothing: either every byte is queued or none is.
+ *
+ * @param[in] p_port Open port.
+ * @param[in] p_data Bytes to send.
+ * @param[in] len    Number of bytes.
+ *
+ * @return 0 on success, -1 if an argument is NULL or the port is closed,
+ *         -2 if the TX ring has less than len bytes free.
+ */
+int32_t
+uart_port_write (uart_port_t * const p_port, char const * const p_data,
+                 uint32_t const len)
+{
+    uint32_t head;
+    uint32_t i;
+
+    if ((NULL == p_port) || (NULL == p_data) || (0u == p_port->baud))
+    {
+        return -1;
+    }
+
+    if (len > uart_port_tx_free(p_port))
+    {
+        return -2;
+    }
+
+    head = p_port->tx_head;
+
+    for (i = 0u; i < len; i++)
+    {
+        p_port->tx_storage[(head + i) & UART_PORT_TX_MASK] = p_data[i];
+    }
+
+    /* Store the bytes before publishing the new head */
+    __asm volatile ("" : : : "memory");
+    p_port->tx_head = head + len;
+
+    /* CR1 is also written by the ISR when the ring runs dry */
+    __disable_irq();
+    uart_port_regs(p_port)->CR1 |= (1u << USART_CR1_TXEIE_BIT);
+    __enable_irq();
+
+    return 0;
+}
+
+
+/*!
+ * @brief Get the free space in a port's TX ring.
+ *
+ * @return Bytes uart_port_write() accepts now (0 if p_port is NULL).
+ */
+uint32_t
+uart_port_tx_free (uart_port_t const * const p_port)
+{
+    if (NULL == p_port)
+    {
+        return 0u;
+    }
+
+    return UART_PORT_TX_SIZE_BYTES - (p_port->tx_head - p_port->tx_tail);
+}
+
+
+/*!
+ * @brief Get the number of received bytes waiting in a port's RX ring.
+ *
+ * @return Bytes available to uart_port_read() (0 if p_port is NULL).
+ */
+uint32_t
+uart_port_rx_available (uart_port_t const * const p_port)
+{
+    if (NULL == p_port)
+    {
+        return 0u;
+    }
+
+    return p_port->rx_head - p_port->rx_tail;
+}
+
+
+/*!
+ * @brief Copy received bytes out of a port's RX ring.
+ *
+ * @param[in]  p_port  Port to read.
+ * @param[out] p_dst   Destination buffer.
+ * @param[in]  max_len Maximum number of bytes to copy.
+ *
+ * @return Number of bytes copied (0 if the ring is empty or an argument
+ *         is NULL).
+ */
+uint32_t
+uart_port_read (uart_port_t * const p_port, char * const p_dst,
+                uint32_t const max_len)
+{
+    uint32_t tail;
+    uint32_t count;
+    uint32_t i;
+
+    if ((NULL == p_port) || (NULL == p_dst))
+    {
+        return 0u;
+    }
+
+    tail = p_port->rx_tail;
+    count = p_port->rx_head - tail;
+
+    if (count > max_len)
+    {
+        count = max_len;
+    }
+
+    for (i = 0u; i < count; i++)
+    {
+        p_dst[i] = p_port->rx_storage[(tail + i) & UART_PORT_RX_MASK];
+    }
+
+    /* Finish reading the slots before handing them back to the ISR */
+    __asm volatile ("" : : : "memory");
+    p_port->rx_tail = tail + count;
+
+    return count;
+}
+
+
+/*!
+ * @brief Get the number of bytes lost because the RX ring was full.
+ */
+uint32_t
+uart_port_rx_dropped (uart_port_t const * const p_port)
+{
+    return (NULL != p_port) ? p_port->rx_dropped : 0u;
+}
+
+
+/*!
+ * @brief Get the last hardware error a port saw.
+ *
+ * Reception continues through errors; bytes with framing, parity or
+ * noise errors are discarded.
+ */
+uart_error_t
+uart_port_error (uart_port_t const * const p_port)
+{
+    return (NULL != p_port) ? p_port->error : UART_ERROR_NONE;
+}
+
+
+/*!
+ * @brief Clear the error reported by uart_port_error().
+ */
+void
+uart_port_error_reset (uart_port_t * const p_port)
+{
+    if (NULL != p_port)
+    {
+        p_port->error = UART_ERROR_NONE;
+    }
+}
+
+
+/*!
+ * @brief Service one port's RX and TX events.
+ *
+ * TXE stays set while the transmitter is idle, so a port is only fed
+ * while its TXEIE is enabled - on a shared vector TXE alone does not
+ * mean the interrupt came from this port.
+ *
+ * @note Execution time: ~30-45 cycles per byte.
+ */
+static void
+uart_port_isr (uart_port_t * const p_port)
+{
+    uart_port_regs_t * const p_regs = uart_port_regs(p_port);
+    uint32_t const isr = p_regs->ISR;
+    uint32_t const errors = isr & UART_PORT_ERROR_FLAGS;
+
+    if (0u != errors)
+    {
+        p_regs->ICR = errors;
+        p_port->error = ((errors & (1u << USART_ISR_ORE_BIT)) != 0u) ? UART_ERROR_OVERRUN :
+                        ((errors & (1u << USART_ISR_FE_BIT)) != 0u)  ? UART_ERROR_FRAMING :
+                        ((errors & (1u << USART_ISR_PE_BIT)) != 0u)  ? UART_ERROR_PARITY :
+                                                                       UART_ERROR_NOISE;
+    }
+
+    if ((isr & (1u << USART_ISR_RXNE_BIT)) != 0u)
+    {
+        char const byte = (char)p_regs->RDR;
+        uint32_t const head = p_port->rx_head;
+
+        /* Overrun leaves a valid byte in RDR; the others corrupt it */
+        if ((errors & ~(1u << USART_ISR_ORE_BIT)) != 0u)
+        {
+            /* Drop the corrupted byte */
+        }
+        else if ((head - p_port->rx_tail) >= UART_PORT_RX_SIZE_BYTES)
+        {
+            p_port->rx_dropped++;
+        }
+        else
+        {
+            p_port->rx_storage[head & UART_PORT_RX_MASK] = byte;
+
+            /* Store the byte before publishing the new head */
+            __asm volatile ("" : : : "memory");
+            p_port->rx_head = head + 1u;
+            sched_signal(SCHED_TASK_PORT);
+        }
+    }
+
+    if (((isr & (1u << USART_ISR_TXE_BIT)) != 0u) &&
+        ((p_regs->CR1 & (1u << USART_CR1_TXEIE_BIT)) != 0u))
+    {
+        uint32_t const tail = p_port->tx_tail;
+
+        if (tail != p_port->tx_head)
+        {
+            p_regs->TDR = (uint8_t)p_port->tx_storage[tail & UART_PORT_TX_MASK];
+            p_port->tx_tail = tail + 1u;
+        }
+        else
+        {
+            p_regs->CR1 &= ~(1u << USART_CR1_TXEIE_BIT);
+            sched_signal(SCHED_TASK_PORT);
+        }
+    }
+}
+
+
+/*!
+ * @brief USART1 interrupt service routine.
+ */
+void
+USART1_IRQHandler (void)
+{
+    if (0u != g_uart_port[UART_PORT_USART1].baud)
+    {
+        uart_port_isr(&g_uart_port[UART_PORT_USART1]);
+    }
+}
+
+
+/*!
+ * @brief USART3 / USART4 / LPUART1 shared interrupt service routine.
+ *
+ * Services every open port on the vector; each one only acts on its
+ * own pending flags.
+ */
+void
+USART3_4_LPUART1_IRQHandler (void)
+{
+    uint32_t id;
+
+    for (id = (uint32_t)UART_PORT_USART3; id < (uint32_t)UART_PORT_COUNT; id++)
+    {
+        if (0u != g_uart_port[id].baud)
+        {
+            uart_port_isr(&g_uart_port[id]);
+        }
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/*** end of file ***/
@@ -0,0 +1,83 @@
+/** @file uart_port.h
+ *
+ * @brief Handle-based driver for the additional serial ports.
+ *
+ * USART2 (the bridge port, on the ST-LINK virtual COM port) keeps its
+ * own driver in uart.c. The other instances of the STM32G071 are driven
+ * through handles: each one is a uart_port_t with its register base,
+ * a TX and an RX ring and its own error state, so any number of them
+ * run at once, each at its own baud rate.
+ *
+ *   Port       TX     RX     AF   Vector
+ *   USART1     PA9    PA10   1    USART1 (27)
+ *   USART3     PB8    PB9    4    USART3_4_LPUART1 (29)
+ *   USART4     PC10   PC11   1    USART3_4_LPUART1 (29)
+ *   LPUART1    PC1    PC0    1    USART3_4_LPUART1 (29)
+ *
+ * Both directions are interrupt driven, 8N1. Received bytes and a
+ * drained TX ring signal SCHED_TASK_PORT, so a task installed there
+ * polls the ports when they have work, and traffic on them never wakes
+ * the bridge's RX and TX tasks.
+ *
+ * @par
+ * COPYRIGHT NOTICE: (c) 2025 Your Name. All rights reserved.
+ */
+
+#ifndef UART_PORT_H
+#define UART_PORT_H
+
+#include <stdint.h>
+#include "types.h"
+#include "uart.h"   /* For uart_error_t */
+
+/* Per-port TX ring size (must be a power of two) */
+#define UART_PORT_TX_SIZE_BYTES  256u
+
+#if ((UART_PORT_TX_SIZE_BYTES & (UART_PORT_TX_SIZE_BYTES - 1u)) != 0u)
+#error "UART_PORT_TX_SIZE_BYTES must be a power of two"
+#endif
+
+/* Per-port RX ring size (must be a power of two) */
+#define UART_PORT_RX_SIZE_BYTES  256u
+
+#if ((UART_PORT_RX_SIZE_BYTES & (UART_PORT_RX_SIZE_BYTES - 1u)) != 0u)
+#error "UART_PORT_RX_SIZE_BYTES must be a power of two"
+#endif
+
+/* Serial ports available through handles */
+typedef enum
+{
+    UART_PORT_USART1 = 0,
+    UART_PORT_USART3,
+    UART_PORT_USART4,
+    UART_PORT_LPUART1,
+    UART_PORT_COUNT
+} uart_port_id_t;
+
+/* One serial port (contents private to uart_port.c) */
+typedef struct uart_port uart_port_t;
+
+/* Public API functions */
+uart_port_t * uart_port_get(uart_port_id_t const id);
+int32_t uart_port_open(uart_port_t * const p_port, uint32_t const baud);
+void uart_port_close(uart_port_t * const p_port);
+uint32_t uart_port_get_baud(uart_port_t const * const p_port);
+
+/* Transmission */
+int32_t uart_port_write(uart_port_t * const p_port, char const * const p_data,
+                        uint32_t const len);
+uint32_t uart_port_tx_free(uart_port_t const * const p_port);
+
+/* Reception */
+uint32_t uart_port_rx_available(uart_port_t const * const p_port);
+uint32_t uart_port_read(uart_port_t * const p_port, char * const p_dst,
+                        uint32_t const max_len);
+uint32_t uart_port_rx_dropped(uart_port_t const * const p_port);
+
+/* Errors */
+uart_error_t uart_port_error(uart_port_t const * const p_port);
+void uart_port_error_reset(uart_port_t * const p_port);
+
+#endif /* UART_PORT_H */
+
+/*** end of file ***/
@@ -14,6 +14,8 @@
 #include "uart.h"
 #include "delay.h"
 #include "types.h"
+#include "slip.h"
+#include "uart_port.h"
 
 /* Test result tracking */
 typedef struct {
@@ -30,6 +32,35 @@ extern volatile uart_state_t g_rx_state;
 extern volatile uart_error_t g_error;
 extern char * g_p_rx_buffer;
 extern volatile uint32_t g_rx_index;
+extern volatile uint32_t * USART_CR1;
+extern volatile uint32_t * USART_CR3;
+extern volatile uint32_t * DMA1_CCR1;
+extern volatile uint32_t * DMAMUX_C0CR;
+extern volatile uint32_t * USART_CR2;
+extern volatile uint32_t * DMA1_CCR2;
+extern volatile uint32_t * DMA1_CNDTR2;
+extern volatile uint32_t * DMAMUX_C1CR;
+
+/* USART2 control bits checked by the flow control test */
+#define TEST_CR1_RXNEIE_BIT    5u
+#define TEST_CR3_DMAR_BIT      6u
+#define TEST_CR3_RTSE_BIT      8u
+#define TEST_CR3_CTSE_BIT      9u
+
+/* DMA1 channel 1 / DMAMUX channel 0 fields checked by the DMA TX test */
+#define TEST_DMA_CCR_EN_BIT    0u
+#define TEST_DMA_CCR_TCIE_BIT  1u
+#define TEST_DMAMUX_REQ_MASK   0x7Fu
+#define TEST_DMAMUX_USART2_TX  53u
+
+/* Frame interrupts and DMA1 channel 2 / DMAMUX channel 1 (DMA RX test) */
+#define TEST_CR1_IDLEIE_BIT    4u
+#define TEST_CR1_CMIE_BIT      14u
+#define TEST_CR1_FRAME_IRQS    ((1u << TEST_CR1_IDLEIE_BIT) | (1u << TEST_CR1_CMIE_BIT))
+#define TEST_CR2_ADD_SHIFT     24u
+#define TEST_DMA_CCR_HTIE_BIT  2u
+#define TEST_DMA_CCR_CIRC_BIT  5u
+#define TEST_DMAMUX_USART2_RX  52u
 
 /* Interrupt Enable Number */
 #define USART2_IRQn 28u
@@ -314,6 +345,622 @@ static void test_delay_timing(void)
 }
 
 
+/*!
+ * @brief Test 10: Continuous RX ring start, empty read and stop.
+ */
+static void test_rx_ring_start_stop(void)
+{
+    char dst[8];
+    int32_t first;
+    int32_t second;
+    uint32_t read_len;
+    
+    safe_transmit("\r\n[TEST 10] RX Ring Start/Stop\r\n");
+    
+    first = uart_rx_start();
+    second = uart_rx_start();
+    read_len = uart_rx_read(dst, sizeof(dst));
+    
+    g_test_results.tests_run++;
+    if ((first == 0) && (second == -1) &&
+        (g_rx_state == UART_STATE_RX_BUSY) &&
+        (uart_rx_available() == read_len)) {
+        g_test_results.tests_passed++;
+        safe_transmit("PASS\r\n");
+    } else {
+        g_test_results.tests_failed++;
+        safe_transmit("FAIL: RX ring did not arm correctly\r\n");
+    }
+    
+    /* Clean up */
+    uart_rx_stop();
+}
+
+
+/*!
+ * @brief Test 11: TX queue accepts back-to-back messages and rejects overflow.
+ */
+static void test_tx_queue_enqueue(void)
+{
+    static char const line[] = "QUEUED\r\n";
+    int32_t queued = 0;
+    int32_t null_result;
+    int32_t full_result;
+    uint32_t i;
+    
+    safe_transmit("\r\n[TEST 11] TX Queue Enqueue\r\n");
+    wait_tx_idle();
+    
+    /* Three messages in a row must all be accepted without waiting */
+    for (i = 0u; i < 3u; i++) {
+        queued += uart_enqueue(line, sizeof(line) - 1u);
+    }
+    
+    null_result = uart_enqueue(NULL, 1u);
+    full_result = uart_enqueue(line, UART_TX_FIFO_SIZE_BYTES + 1u);
+    
+    wait_tx_idle();
+    
+    g_test_results.tests_run++;
+    if ((queued == 0) && (null_result == -1) && (full_result == -2) &&
+        (g_tx_state == UART_STATE_IDLE) &&
+        (uart_tx_free() == UART_TX_FIFO_SIZE_BYTES)) {
+        g_test_results.tests_passed++;
+        safe_transmit("PASS\r\n");
+    } else {
+        g_test_results.tests_failed++;
+        safe_transmit("FAIL: TX queue did not drain or reject correctly\r\n");
+    }
+}
+
+
+/*!
+ * @brief Test 12: Slice (zero-copy) TX with completion mark.
+ */
+static void test_tx_slices_zero_copy(void)
+{
+    static char const prefix[] = "SLICE: ";
+    static char const value[] = "1000";
+    static char const eol[] = "\r\n";
+    uart_slice_t slices[3];
+    int32_t queued;
+    int32_t null_result;
+    uint32_t mark;
+    bool_t b_done_early;
+    
+    safe_transmit("\r\n[TEST 12] TX Slices Zero-Copy\r\n");
+    wait_tx_idle();
+    
+    slices[0].p_data = prefix;
+    slices[0].len = sizeof(prefix) - 1u;
+    slices[1].p_data = value;
+    slices[1].len = sizeof(value) - 1u;
+    slices[2].p_data = eol;
+    slices[2].len = sizeof(eol) - 1u;
+    
+    queued = uart_enqueue_slices(slices, 3u);
+    mark = uart_tx_mark();
+    b_done_early = uart_tx_done(mark);
+    null_result = uart_enqueue_slices(NULL, 1u);
+    
+    wait_tx_idle();
+    
+    g_test_results.tests_run++;
+    if ((queued == 0) && (null_result == -1) && (b_done_early == FALSE) &&
+        (uart_tx_done(mark) == TRUE) &&
+        (uart_tx_slots_free() == UART_TX_DESC_COUNT)) {
+        g_test_results.tests_passed++;
+        safe_transmit("PASS\r\n");
+    } else {
+        g_test_results.tests_failed++;
+        safe_transmit("FAIL: Slices not sent or mark not completed\r\n");
+    }
+}
+
+
+/*!
+ * @brief Feed a byte string to a SLIP decoder, returning the last event.
+ */
+static slip_rx_event_t slip_feed(slip_rx_t * const p_rx,
+                                 uint8_t const * const p_bytes,
+                                 uint32_t const len, uint8_t * const p_out)
+{
+    slip_rx_event_t event = SLIP_RX_NONE;
+    uint32_t out_len = 0u;
+    uint32_t i;
+
+    for (i = 0u; i < len; i++) {
+        uint8_t byte = p_bytes[i];
+
+        event = slip_rx_byte(p_rx, &byte);
+        if (SLIP_RX_DATA == event) {
+            p_out[out_len] = byte;
+            out_len++;
+        }
+    }
+
+    return event;
+}
+
+
+/*!
+ * @brief Test 13: SLIP decoder - escapes, CRC check and corrupt frames.
+ */
+static void test_slip_decode(void)
+{
+    /* "{\xC0\xDB}" framed: escaped payload, CRC 0x98BA, END */
+    static uint8_t const frame[] = {
+        0xC0u, 0x7Bu, 0xDBu, 0xDCu, 0xDBu, 0xDDu, 0x7Du,
+        0x98u, 0xBAu, 0xC0u
+    };
+    static uint8_t const check[] = "123456789";
+    uint8_t corrupt[sizeof(frame)];
+    uint8_t out[sizeof(frame)];
+    uint8_t scratch[sizeof(frame)];
+    slip_rx_t rx;
+    slip_rx_event_t good;
+    slip_rx_event_t bad;
+    uint32_t good_len;
+    uint16_t crc = SLIP_CRC_INIT;
+    uint32_t i;
+    
+    safe_transmit("\r\n[TEST 13] SLIP Decode And CRC\r\n");
+    
+    for (i = 0u; i < (sizeof(check) - 1u); i++) {
+        crc = slip_crc_update(crc, check[i]);
+    }
+    
+    slip_rx_reset(&rx);
+    good = slip_feed(&rx, frame, sizeof(frame), out);
+    good_len = rx.frame_len;
+    
+    (void)memcpy(corrupt, frame, sizeof(frame));
+    corrupt[1] ^= 0x01u;
+    bad = slip_feed(&rx, corrupt, sizeof(corrupt), scratch);
+    
+    g_test_results.tests_run++;
+    if ((crc == 0x29B1u) && (good == SLIP_RX_FRAME) && (good_len == 4u) &&
+        (out[0] == 0x7Bu) && (out[1] == 0xC0u) && (out[2] == 0xDBu) &&
+        (bad == SLIP_RX_BAD)) {
+        g_test_results.tests_passed++;
+        safe_transmit("PASS\r\n");
+    } else {
+        g_test_results.tests_failed++;
+        safe_transmit("FAIL: SLIP frame or CRC not decoded as expected\r\n");
+    }
+}
+
+
+/*!
+ * @brief Set the baud rate once the last stop bit has left (bounded).
+ */
+static int32_t set_baud_idle(uint32_t const baud)
+{
+    uint32_t start = delay_get_tick();
+    int32_t result;
+    
+    do {
+        result = uart_set_baud(baud);
+    } while ((result == -2) && !delay_elapsed(start, 100));
+    
+    return result;
+}
+
+
+/*!
+ * @brief Test 14: Baud rate change - range checks, busy reject, OVER8.
+ */
+static void test_baud_rate_change(void)
+{
+    int32_t zero;
+    int32_t too_fast;
+    int32_t busy;
+    int32_t fast;
+    uint32_t fast_baud;
+    int32_t restore;
+    
+    safe_transmit("\r\n[TEST 14] Baud Rate Change\r\n");
+    
+    zero = uart_set_baud(0u);
+    too_fast = uart_set_baud(10000000u);   /* Above PCLK / 8 at any clock */
+    
+    /* Rejected while a transfer is running */
+    uart_transmit_buffer("....\r\n");
+    busy = uart_set_baud(UART_BAUD_RATE);
+    wait_tx_idle();
+    
+    /* 2 Mbaud needs 8x oversampling at 16 MHz; nothing is sent meanwhile */
+    fast = set_baud_idle(2000000u);
+    fast_baud = uart_get_baud();
+    restore = set_baud_idle(UART_BAUD_RATE);
+    
+    g_test_results.tests_run++;
+    if ((zero == -1) && (too_fast == -1) && (busy == -2) && (fast == 0) &&
+        (fast_baud == 2000000u) && (restore == 0) &&
+        (uart_get_baud() == UART_BAUD_RATE)) {
+        g_test_results.tests_passed++;
+        safe_transmit("PASS\r\n");
+    } else {
+        g_test_results.tests_failed++;
+        safe_transmit("FAIL: Baud rate not accepted or rejected as expected\r\n");
+    }
+}
+
+
+/*!
+ * @brief Test 15: Extra ports - handles, open/close, TX ring drains.
+ */
+static void test_uart_port_handles(void)
+{
+    uart_port_t * p_usart1;
+    uart_port_t * p_lpuart1;
+    uart_port_t * p_none;
+    int32_t bad_baud;
+    int32_t lp_slow;
+    int32_t open1;
+    int32_t open_lp;
+    int32_t closed_write;
+    int32_t too_long;
+    int32_t write1;
+    int32_t write_lp;
+    uint32_t start;
+    
+    safe_transmit("\r\n[TEST 15] Extra Port Handles\r\n");
+    
+    p_usart1 = uart_port_get(UART_PORT_USART1);
+    p_lpuart1 = uart_port_get(UART_PORT_LPUART1);
+    p_none = uart_port_get(UART_PORT_COUNT);
+    
+    closed_write = uart_port_write(p_usart1, "x", 1u);
+    bad_baud = uart_port_open(p_usart1, 0u);
+    lp_slow = uart_port_open(p_lpuart1, 1u);   /* Below fck / 4096 / 256 */
+    
+    /* Two ports at different rates; nothing needs to be connected */
+    open1 = uart_port_open(p_usart1, 115200u);
+    open_lp = uart_port_open(p_lpuart1, 9600u);
+    too_long = uart_port_write(p_usart1, "x", UART_PORT_TX_SIZE_BYTES + 1u);
+    write1 = uart_port_write(p_usart1, "port1\r\n", 7u);
+    write_lp = uart_port_write(p_lpuart1, "lp\r\n", 4u);
+    
+    /* 4 bytes at 9600 baud take ~4 ms */
+    start = delay_get_tick();
+    while (((uart_port_tx_free(p_usart1) != UART_PORT_TX_SIZE_BYTES) ||
+            (uart_port_tx_free(p_lpuart1) != UART_PORT_TX_SIZE_BYTES)) &&
+           !delay_elapsed(start, 50)) {
+        /* Non-blocking wait */
+    }
+    
+    g_test_results.tests_run++;
+    if ((p_usart1 != NULL) && (p_lpuart1 != NULL) && (p_none == NULL) &&
+        (closed_write == -1) && (bad_baud == -1) && (lp_slow == -1) &&
+        (open1 == 0) && (open_lp == 0) && (too_long == -2) &&
+        (write1 == 0) && (write_lp == 0) &&
+        (uart_port_get_baud(p_usart1) == 115200u) &&
+        (uart_port_get_baud(p_lpuart1) == 9600u) &&
+        (uart_port_tx_free(p_usart1) == UART_PORT_TX_SIZE_BYTES) &&
+        (uart_port_tx_free(p_lpuart1) == UART_PORT_TX_SIZE_BYTES)) {
+        g_test_results.tests_passed++;
+        safe_transmit("PASS\r\n");
+    } else {
+        g_test_results.tests_failed++;
+        safe_transmit("FAIL: Port open, reject or TX drain incorrect\r\n");
+    }
+    
+    uart_port_close(p_usart1);
+    uart_port_close(p_lpuart1);
+}
+
+
+/*!
+ * @brief Check whether the RX engine is reading RDR (RXNEIE, or DMAR).
+ */
+static bool_t rx_engine_on(void)
+{
+#if (UART_RX_MODE == UART_RX_MODE_DMA)
+    return ((*USART_CR3 & (1u << TEST_CR3_DMAR_BIT)) != 0u) ? TRUE : FALSE;
+#else
+    return ((*USART_CR1 & (1u << TEST_CR1_RXNEIE_BIT)) != 0u) ? TRUE : FALSE;
+#endif
+}
+
+
+/*!
+ * @brief Test 16: Flow control - hold pauses reception, survives restart.
+ */
+static void test_rx_flow_hold(void)
+{
+    bool_t on_start;
+    bool_t on_held;
+    bool_t on_restart;
+    bool_t on_released;
+    bool_t b_rts_cts;
+    bool_t b_pass;
+    
+    safe_transmit("\r\n[TEST 16] RX Flow Control Hold\r\n");
+    
+    (void)uart_rx_start();
+    on_start = rx_engine_on();
+    uart_rx_hold(TRUE);
+    on_held = rx_engine_on();
+    uart_rx_stop();
+    (void)uart_rx_start();
+    on_restart = rx_engine_on();
+    uart_rx_hold(FALSE);
+    on_released = rx_engine_on();
+    uart_rx_stop();
+    
+    b_rts_cts = ((*USART_CR3 & ((1u << TEST_CR3_RTSE_BIT) |
+                                (1u << TEST_CR3_CTSE_BIT))) ==
+                 ((1u << TEST_CR3_RTSE_BIT) | (1u << TEST_CR3_CTSE_BIT))) ? TRUE : FALSE;
+    
+#if (UART_FLOW_CONTROL == UART_FLOW_RTS_CTS)
+    /* Holding stops reading RDR, so the USART deasserts RTS */
+    b_pass = (on_start && !on_held && !on_restart && on_released && b_rts_cts) ?
+             TRUE : FALSE;
+#else
+    /* No way to tell the sender: the hold is ignored */
+    b_pass = (on_start && on_held && on_restart && on_released && !b_rts_cts) ?
+             TRUE : FALSE;
+#endif
+    
+    g_test_results.tests_run++;
+    if (b_pass) {
+        g_test_results.tests_passed++;
+        safe_transmit("PASS\r\n");
+    } else {
+        g_test_results.tests_failed++;
+        safe_transmit("FAIL: RX hold did not match UART_FLOW_CONTROL\r\n");
+    }
+}
+
+
+/*!
+ * @brief Test 17: TX batch - held until flushed, copies share a descriptor.
+ */
+static void test_tx_batch_coalesce(void)
+{
+    static char const line[] = "BATCH: 1\r\n";
+    static char const key[] = "BATCH: ";
+    static char const value[] = "2";
+    static char const eol[] = "\r\n";
+    uart_slice_t slices[3];
+    int32_t queued;
+    int32_t null_result;
+    uart_state_t held_state;
+    uint32_t slots_used;
+    
+    safe_transmit("\r\n[TEST 17] TX Batch Coalescing\r\n");
+    wait_tx_idle();
+    
+    slices[0].p_data = key;
+    slices[0].len = sizeof(key) - 1u;
+    slices[1].p_data = value;
+    slices[1].len = sizeof(value) - 1u;
+    slices[2].p_data = eol;
+    slices[2].len = sizeof(eol) - 1u;
+    
+    uart_tx_batch_begin();
+    queued = uart_enqueue(line, sizeof(line) - 1u);
+    queued += uart_enqueue_copy(slices, 3u);
+    queued += uart_enqueue(line, sizeof(line) - 1u);
+    null_result = uart_enqueue_copy(NULL, 1u);
+    held_state = g_tx_state;
+    slots_used = UART_TX_DESC_COUNT - uart_tx_slots_free();
+    uart_tx_batch_flush();
+    
+    wait_tx_idle();
+    
+    /* One descriptor, or two if the copy wrapped around the FIFO end */
+    g_test_results.tests_run++;
+    if ((queued == 0) && (null_result == -1) &&
+        (held_state == UART_STATE_IDLE) &&
+        (slots_used >= 1u) && (slots_used <= 2u) &&
+        (uart_tx_free() == UART_TX_FIFO_SIZE_BYTES)) {
+        g_test_results.tests_passed++;
+        safe_transmit("PASS\r\n");
+    } else {
+        g_test_results.tests_failed++;
+        safe_transmit("FAIL: Batch not held or copies not coalesced\r\n");
+    }
+}
+
+
+/*!
+ * @brief Test 18: Statistics - sent bytes counted, peaks and errors kept.
+ */
+static void test_uart_stats(void)
+{
+    static char const line[] = "STATS: 1\r\n";
+    uart_stats_t before;
+    uart_stats_t after;
+    int32_t queued;
+    bool_t b_errors_kept = TRUE;
+    uint32_t i;
+    
+    safe_transmit("\r\n[TEST 18] UART Statistics\r\n");
+    wait_tx_idle();
+    
+    uart_get_stats(&before);
+    queued = uart_enqueue(line, sizeof(line) - 1u);
+    wait_tx_idle();
+    uart_get_stats(&after);
+    uart_get_stats(NULL);
+    
+    /* Counters only ever grow */
+    for (i = 0u; i < UART_ERROR_COUNT; i++) {
+        if (after.errors[i] < before.errors[i]) {
+            b_errors_kept = FALSE;
+        }
+    }
+    
+    /* Framed, the line also carries END and CRC bytes */
+    g_test_results.tests_run++;
+    if ((queued == 0) &&
+        ((after.tx_bytes - before.tx_bytes) >= (sizeof(line) - 1u)) &&
+        (after.tx_peak >= (sizeof(line) - 1u)) &&
+        (after.tx_peak <= UART_TX_FIFO_SIZE_BYTES) &&
+        (after.tx_desc_peak >= 1u) &&
+        (after.tx_desc_peak <= UART_TX_DESC_COUNT) &&
+        (after.rx_peak <= UART_RX_RING_SIZE_BYTES) &&
+        (after.errors[UART_ERROR_NONE] == 0u) &&
+        b_errors_kept) {
+        g_test_results.tests_passed++;
+        safe_transmit("PASS\r\n");
+    } else {
+        g_test_results.tests_failed++;
+        safe_transmit("FAIL: Statistics not counted\r\n");
+    }
+}
+
+
+/*!
+ * @brief Test 19: DMA TX - queued slices chain through the TC interrupt.
+ */
+static void test_tx_dma_chain(void)
+{
+    static char const first[] = "DMA: 1\r\n";
+    static char const second[] = "DMA: 2\r\n";
+    static char const third[] = "DMA: 3\r\n";
+    uart_slice_t slice;
+    int32_t queued;
+    uint32_t mark_first;
+    uint32_t mark_last;
+    uint32_t ccr_busy;
+    uart_state_t busy_state;
+    bool_t b_done_early;
+    bool_t b_engine_ok;
+    
+    safe_transmit("\r\n[TEST 19] DMA TX Chaining\r\n");
+    wait_tx_idle();
+    
+    /* Three descriptors: the first starts the engine, the other two are
+     * only reached by chaining from the completion interrupt */
+    slice.p_data = first;
+    slice.len = sizeof(first) - 1u;
+    queued = uart_enqueue_slices(&slice, 1u);
+    mark_first = uart_tx_mark();
+    slice.p_data = second;
+    slice.len = sizeof(second) - 1u;
+    queued += uart_enqueue_slices(&slice, 1u);
+    slice.p_data = third;
+    slice.len = sizeof(third) - 1u;
+    queued += uart_enqueue_slices(&slice, 1u);
+    mark_last = uart_tx_mark();
+    
+    busy_state = g_tx_state;
+    ccr_busy = *DMA1_CCR1;
+    b_done_early = uart_tx_done(mark_last);
+    
+    wait_tx_idle();
+    
+#if (UART_TX_MODE == UART_TX_MODE_DMA)
+    /* Request 53 on DMAMUX channel 0, channel 1 running with TC enabled
+     * while busy and switched off again once the queue is empty */
+    b_engine_ok = (((*DMAMUX_C0CR & TEST_DMAMUX_REQ_MASK) == TEST_DMAMUX_USART2_TX) &&
+                   ((ccr_busy & (1u << TEST_DMA_CCR_EN_BIT)) != 0u) &&
+                   ((ccr_busy & (1u << TEST_DMA_CCR_TCIE_BIT)) != 0u) &&
+                   ((*DMA1_CCR1 & (1u << TEST_DMA_CCR_EN_BIT)) == 0u)) ? TRUE : FALSE;
+#else
+    /* TXE-driven build: the same chaining runs from the USART2 ISR */
+    (void)ccr_busy;
+    b_engine_ok = TRUE;
+#endif
+    
+    g_test_results.tests_run++;
+    if ((queued == 0) && (busy_state == UART_STATE_TX_BUSY) &&
+        (b_done_early == FALSE) && b_engine_ok &&
+        (uart_tx_done(mark_first) == TRUE) &&
+        (uart_tx_done(mark_last) == TRUE) &&
+        (g_tx_state == UART_STATE_IDLE) &&
+        (uart_tx_slots_free() == UART_TX_DESC_COUNT)) {
+        g_test_results.tests_passed++;
+        safe_transmit("PASS\r\n");
+    } else {
+        g_test_results.tests_failed++;
+        safe_transmit("FAIL: DMA TX did not chain or complete\r\n");
+    }
+}
+
+
+/*!
+ * @brief Test 20: DMA RX - ring and line receptions arm channel 2 and the
+ *        frame interrupts instead of RXNE, and stopping disarms them.
+ */
+static void test_rx_dma_arm(void)
+{
+    uint32_t ccr_ring;
+    uint32_t cndtr_ring;
+    uint32_t cr1_ring;
+    uint32_t ccr_line;
+    uint32_t cndtr_line;
+    uint32_t cr1_line;
+    bool_t b_stopped;
+    bool_t b_engine_ok;
+    
+    safe_transmit("\r\n[TEST 20] DMA RX Frame Events\r\n");
+    
+    (void)uart_rx_start();
+    ccr_ring = *DMA1_CCR2;
+    cndtr_ring = *DMA1_CNDTR2;
+    cr1_ring = *USART_CR1;
+    uart_rx_stop();
+    b_stopped = ((rx_engine_on() == FALSE) &&
+                 ((*USART_CR1 & TEST_CR1_FRAME_IRQS) == 0u) &&
+                 ((*DMA1_CCR2 & (1u << TEST_DMA_CCR_EN_BIT)) == 0u)) ? TRUE : FALSE;
+    
+    g_rx_index = 0u;
+    (void)uart_receive_buffer();
+    ccr_line = *DMA1_CCR2;
+    cndtr_line = *DMA1_CNDTR2;
+    cr1_line = *USART_CR1;
+    
+#if (UART_RX_MODE == UART_RX_MODE_DMA)
+    /* Ring: circular over the whole ring with half/full transfer events.
+     * Line: one transfer sized to the buffer, no wrap. Both end frames on
+     * idle line or ADD = UART_RX_MATCH_CHAR, never on RXNE. The counts
+     * assume a quiet RX line during the test. */
+    b_engine_ok = (((*DMAMUX_C1CR & TEST_DMAMUX_REQ_MASK) == TEST_DMAMUX_USART2_RX) &&
+                   (((*USART_CR2 >> TEST_CR2_ADD_SHIFT) & 0xFFu) ==
+                    (uint32_t)(uint8_t)UART_RX_MATCH_CHAR) &&
+                   ((ccr_ring & (1u << TEST_DMA_CCR_EN_BIT)) != 0u) &&
+                   ((ccr_ring & (1u << TEST_DMA_CCR_CIRC_BIT)) != 0u) &&
+                   ((ccr_ring & (1u << TEST_DMA_CCR_HTIE_BIT)) != 0u) &&
+                   (cndtr_ring == UART_RX_RING_SIZE_BYTES) &&
+                   ((cr1_ring & TEST_CR1_FRAME_IRQS) == TEST_CR1_FRAME_IRQS) &&
+                   ((cr1_ring & (1u << TEST_CR1_RXNEIE_BIT)) == 0u) &&
+                   ((ccr_line & (1u << TEST_DMA_CCR_EN_BIT)) != 0u) &&
+                   ((ccr_line & (1u << TEST_DMA_CCR_CIRC_BIT)) == 0u) &&
+                   (cndtr_line == (RX_BUFFER_SIZE_BYTES - 1u)) &&
+                   ((cr1_line & TEST_CR1_FRAME_IRQS) == TEST_CR1_FRAME_IRQS)) ? TRUE : FALSE;
+    
+    /* Clean up: a line reception has no stop call, disarm it by hand so
+     * a later idle line finds no frame interrupt enabled */
+    *USART_CR1 &= ~TEST_CR1_FRAME_IRQS;
+    *USART_CR3 &= ~(1u << TEST_CR3_DMAR_BIT);
+    *DMA1_CCR2 &= ~(1u << TEST_DMA_CCR_EN_BIT);
+#else
+    /* Per-byte build: RXNE drives both, channel 2 and frame IRQs stay off */
+    (void)cndtr_ring;
+    (void)cndtr_line;
+    b_engine_ok = (((cr1_ring & (1u << TEST_CR1_RXNEIE_BIT)) != 0u) &&
+                   ((cr1_ring & TEST_CR1_FRAME_IRQS) == 0u) &&
+                   ((ccr_ring & (1u << TEST_DMA_CCR_EN_BIT)) == 0u) &&
+                   ((cr1_line & (1u << TEST_CR1_RXNEIE_BIT)) != 0u) &&
+                   ((ccr_line & (1u << TEST_DMA_CCR_EN_BIT)) == 0u)) ? TRUE : FALSE;
+#endif
+    g_rx_state = UART_STATE_IDLE;
+    
+    g_test_results.tests_run++;
+    if (b_stopped && b_engine_ok) {
+        g_test_results.tests_passed++;
+        safe_transmit("PASS\r\n");
+    } else {
+        g_test_results.tests_failed++;
+        safe_transmit("FAIL: RX engine not armed for UART_RX_MODE\r\n");
+    }
+}
+
+
 /*!
  * @brief Print final test summary without sprintf.
  */
@@ -325,15 +972,37 @@ static void print_test_summary(void)
     
     /* Print total tests */
     safe_transmit("Total Tests:  ");
-    if (g_test_results.tests_run == 9) {
-        safe_transmit("9\r\n");
+    if (g_test_results.tests_run == 20) {
+        safe_transmit("20\r\n");
     } else {
         safe_transmit("ERROR\r\n");
     }
     
     /* Print passed tests */
     safe_transmit("Passed:       ");
-    if (g_test_results.tests_passed == 9) {
+    if (g_test_results.tests_passed == 20) {
+        safe_transmit("20\r\n");
+    } else if (g_test_results.tests_passed == 19) {
+        safe_transmit("19\r\n");
+    } else if (g_test_results.tests_passed == 18) {
+        safe_transmit("18\r\n");
+    } else if (g_test_results.tests_passed == 17) {
+        safe_transmit("17\r\n");
+    } else if (g_test_results.tests_passed == 16) {
+        safe_transmit("16\r\n");
+    } else if (g_test_results.tests_passed == 15) {
+        safe_transmit("15\r\n");
+    } else if (g_test_results.tests_passed == 14) {
+        safe_transmit("14\r\n");
+    } else if (g_test_results.tests_passed == 13) {
+        safe_transmit("13\r\n");
+    } else if (g_test_results.tests_passed == 12) {
+        safe_transmit("12\r\n");
+    } else if (g_test_results.tests_passed == 11) {
+        safe_transmit("11\r\n");
+    } else if (g_test_results.tests_passed == 10) {
+        safe_transmit("10\r\n");
+    } else if (g_test_results.tests_passed == 9) {
         safe_transmit("9\r\n");
     } else if (g_test_results.tests_passed == 8) {
         safe_transmit("8\r\n");
@@ -419,6 +1088,39 @@ int32_t main(void)
     test_delay_timing();
     delay_nb(100);
     
+    test_rx_ring_start_stop();
+    delay_nb(100);
+    
+    test_tx_queue_enqueue();
+    delay_nb(100);
+    
+    test_tx_slices_zero_copy();
+    delay_nb(100);
+    
+    test_slip_decode();
+    delay_nb(100);
+    
+    test_baud_rate_change();
+    delay_nb(100);
+    
+    test_uart_port_handles();
+    delay_nb(100);
+    
+    test_rx_flow_hold();
+    delay_nb(100);
+    
+    test_tx_batch_coalesce();
+    delay_nb(100);
+    
+    test_uart_stats();
+    delay_nb(100);
+    
+    test_tx_dma_chain();
+    delay_nb(100);
+    
+    test_rx_dma_arm();
+    delay_nb(100);
+    
     /* Print summary */
     print_test_summary();
     